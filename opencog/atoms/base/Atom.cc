@@ -33,6 +33,7 @@
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/LazyValue.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 
@@ -128,6 +129,10 @@ void Atom::setValue(const Handle& key, const ValuePtr& value)
 		else
 			_values.erase(key);
 	}
+
+	// Let the AtomSpace know, if it is keeping track of changes.
+	if (_atom_space and _atom_space->_track_changes)
+		_atom_space->note_change(this);
 }
 
 ValuePtr Atom::getValue(const Handle& key) const
@@ -160,7 +165,35 @@ ValuePtr Atom::getValue(const Handle& key) const
         auto pr = _values.find(key);
         if (_values.end() != pr) pap = pr->second;
     }
-    return pap;
+    if (nullptr == pap or LAZY_VALUE != pap->get_type()) return pap;
+
+    // The Value is in storage, and has not been fetched yet.
+    // The loader fetches it, and puts it in place of the LazyValue.
+    ValueLoaderPtr ldr(LazyValueCast(pap)->loader());
+    if (nullptr == ldr) return nullptr;
+    return ldr->load_value(get_handle(), key, pap);
+}
+
+bool Atom::swapValue(const Handle& key, const ValuePtr& oldv,
+                     const ValuePtr& newv)
+{
+    const Handle& k((key != truth_key() and *key == *truth_key()) ?
+                    truth_key() : key);
+
+    KVP_UNIQUE_LOCK;
+    auto pr = _values.find(k);
+    if (_values.end() == pr)
+    {
+        if (nullptr != oldv) return false;
+        if (nullptr != newv) _values.emplace(k, newv);
+        return true;
+    }
+    if (pr->second != oldv) return false;
+    if (nullptr != newv)
+        pr->second = newv;
+    else
+        _values.erase(pr);
+    return true;
 }
 
 HandleSet Atom::getKeys() const
@@ -175,10 +208,20 @@ HandleSet Atom::getKeys() const
 
 void Atom::copyValues(const Handle& other)
 {
-    HandleSet okeys(other->getKeys());
-    for (const Handle& k: okeys)
+    // Copy the map entries, and not what getValue() returns, so that
+    // Values that have not been fetched from storage are not fetched
+    // just to be copied. They can only be fetched for the same Atom,
+    // though; for any other Atom, they have to be fetched now.
+    std::vector<std::pair<Handle, ValuePtr>> kvs;
+    {
+        std::shared_lock<std::shared_mutex> lck(other->_mtx);
+        kvs.assign(other->_values.begin(), other->_values.end());
+    }
+    for (auto& pr : kvs)
     {
-        setValue(k, other->getValue(k));
+        if (LAZY_VALUE == pr.second->get_type() and *other != *this)
+            pr.second = other->getValue(pr.first);
+        setValue(pr.first, pr.second);
     }
 }
 
@@ -204,6 +247,7 @@ std::string Atom::valuesToString() const
     for (const Handle& k: getKeys())
     {
         ValuePtr p = getValue(k);
+        if (nullptr == p) continue;
         rv << "(" << k->to_short_string()
            << " . " << p->to_short_string() + ")";
     }
@@ -198,6 +198,7 @@ protected:
     mutable std::atomic_bool _absent;
     mutable std::atomic_bool _marked_for_removal;
     mutable std::atomic_bool _checked;
+    mutable std::atomic_bool _changed;
 
     /// Merkle-tree hash of the atom contents. Generically useful
     /// for indexing and comparison operations.
@@ -229,6 +230,7 @@ protected:
         _absent(false),
         _marked_for_removal(false),
         _checked(false),
+        _changed(false),
         _content_hash(Handle::INVALID_HASH),
         _atom_space(nullptr)
     {}
@@ -392,9 +394,17 @@ public:
 
     /// Associate `value` to `key` for this atom.
     void setValue(const Handle& key, const ValuePtr& value);
-    /// Get value at `key` for this atom.
+    /// Get value at `key` for this atom. Values that have not yet
+    /// been fetched from storage (see LazyValue) are fetched now.
     ValuePtr getValue(const Handle& key) const;
 
+    /// Replace the value at `key` by `newv`, but only if it is still
+    /// `oldv`; either may be null. Return true if it was replaced.
+    /// This is not a change to the Atom: it is for use by storage
+    /// backends, when bringing values into RAM and evicting them.
+    bool swapValue(const Handle& key, const ValuePtr& oldv,
+                   const ValuePtr& newv);
+
     /// Get the set of all keys in use for this Atom.
     HandleSet getKeys() const;
 
@@ -0,0 +1,103 @@
+/*
+ * opencog/atoms/base/LazyValue.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LAZY_VALUE_H
+#define _OPENCOG_LAZY_VALUE_H
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+#include <opencog/atoms/atom_types/atom_types.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Interface for fetching Values on demand. Implemented by storage
+ * backends that place LazyValues on Atoms.
+ */
+class ValueLoader
+{
+public:
+	virtual ~ValueLoader() {}
+
+	/// Fetch the Value at `key` on the Atom `h`, install it on the
+	/// Atom, in place of `lazy`, and return it. Return nullptr if
+	/// there is no such Value.
+	virtual ValuePtr load_value(const Handle& h, const Handle& key,
+	                            const ValuePtr& lazy) = 0;
+};
+
+typedef std::shared_ptr<ValueLoader> ValueLoaderPtr;
+typedef std::weak_ptr<ValueLoader> ValueLoaderWPtr;
+
+/**
+ * A LazyValue stands in for a Value that is known to exist in storage,
+ * but has not been fetched yet. It is never handed out: `getValue()`
+ * replaces it by the real Value, fetched with the ValueLoader, the
+ * first time it is asked for. The keys of an Atom are thus all known,
+ * while the (possibly large) Values are brought into RAM only when
+ * needed.
+ *
+ * A LazyValue does not know the Atom or the key it sits at, and so a
+ * single LazyValue can be shared by all of the Atoms loaded from the
+ * same storage. If the loader no longer exists (because the storage
+ * was deleted), then the Value cannot be fetched, and reads as null.
+ */
+class LazyValue
+	: public Value
+{
+protected:
+	ValueLoaderWPtr _loader;
+
+public:
+	LazyValue(const ValueLoaderPtr& ldr)
+		: Value(LAZY_VALUE), _loader(ldr) {}
+
+	virtual ~LazyValue() {}
+
+	/// The loader that can fetch the Value that this stands in for,
+	/// or nullptr, if it is gone.
+	ValueLoaderPtr loader(void) const { return _loader.lock(); }
+
+	/** Returns a string representation of the value.  */
+	virtual std::string to_string(const std::string& indent) const
+		{ return indent + "(LazyValue)"; }
+
+	/** Returns true if the two values are equal, else false.  */
+	virtual bool operator==(const Value& other) const
+		{ return this == &other; }
+};
+
+typedef std::shared_ptr<const LazyValue> LazyValuePtr;
+static inline LazyValuePtr LazyValueCast(const ValuePtr& a)
+	{ return std::dynamic_pointer_cast<const LazyValue>(a); }
+
+#define createLazyValue std::make_shared<LazyValue>
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_LAZY_VALUE_H
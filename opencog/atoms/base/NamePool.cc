@@ -0,0 +1,192 @@
+/*
+ * opencog/atoms/base/NamePool.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+
+#include "NamePool.h"
+
+using namespace opencog;
+
+// The pool is split into shards, each with its own lock, so that
+// threads creating Nodes do not all contend for one lock.
+#define NUM_SHARDS 64
+
+namespace {
+
+struct EntryHash
+{
+	size_t operator()(const NameEntry* e) const { return e->hash; }
+};
+
+struct EntryEqual
+{
+	bool operator()(const NameEntry* a, const NameEntry* b) const
+		{ return a->hash == b->hash and a->str == b->str; }
+};
+
+struct Shard
+{
+	std::mutex mtx;
+	std::unordered_set<const NameEntry*, EntryHash, EntryEqual> names;
+};
+
+} // anonymous namespace
+
+// Never freed: Nodes held in static objects may outlive the pool,
+// and may also be created before it, during static initialization.
+static Shard* shards(void)
+{
+	static Shard* _shards = new Shard[NUM_SHARDS];
+	return _shards;
+}
+
+static std::atomic<bool> _enabled(false);
+
+void NamePool::enable(bool on)
+{
+	_enabled = on;
+}
+
+bool NamePool::enabled(void)
+{
+	return _enabled;
+}
+
+size_t NamePool::size(void)
+{
+	size_t cnt = 0;
+	Shard* sh = shards();
+	for (size_t i = 0; i < NUM_SHARDS; i++)
+	{
+		std::lock_guard<std::mutex> lck(sh[i].mtx);
+		cnt += sh[i].names.size();
+	}
+	return cnt;
+}
+
+// ==============================================================
+
+NodeName::NodeName(std::string s) :
+	_hash(std::hash<std::string>()(s) & ~POOLED)
+{
+	if (not _enabled)
+	{
+		new (&_str) std::string(std::move(s));
+		return;
+	}
+
+	Shard& sh = shards()[_hash % NUM_SHARDS];
+
+	// A temporary entry, used only as a lookup key.
+	NameEntry key(std::move(s), _hash);
+
+	std::lock_guard<std::mutex> lck(sh.mtx);
+	auto it = sh.names.find(&key);
+	if (sh.names.end() != it)
+	{
+		_e = *it;
+		_e->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+	else
+	{
+		_e = new NameEntry(std::string(key.str), _hash);
+		sh.names.insert(_e);
+	}
+	_hash |= POOLED;
+}
+
+NodeName::NodeName(const NodeName& other) :
+	_hash(other._hash)
+{
+	if (pooled())
+	{
+		_e = other._e;
+		_e->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+	else
+		new (&_str) std::string(other._str);
+}
+
+// A moved-from name is left holding the empty string.
+static const size_t empty_hash = std::hash<std::string>()(std::string());
+
+NodeName::NodeName(NodeName&& other) noexcept :
+	_hash(other._hash)
+{
+	if (pooled())
+	{
+		_e = other._e;
+		new (&other._str) std::string();
+	}
+	else
+		new (&_str) std::string(std::move(other._str));
+	other._hash = empty_hash & ~POOLED;
+}
+
+NodeName::~NodeName()
+{
+	if (pooled()) release();
+	else _str.~basic_string();
+}
+
+NodeName& NodeName::operator=(const NodeName& other)
+{
+	if (this == &other) return *this;
+	NodeName tmp(other);
+	return *this = std::move(tmp);
+}
+
+NodeName& NodeName::operator=(NodeName&& other) noexcept
+{
+	if (this == &other) return *this;
+	this->~NodeName();
+	new (this) NodeName(std::move(other));
+	return *this;
+}
+
+// Drop the reference to the pool entry. Called only if there is one.
+void NodeName::release(void)
+{
+	// Fast path: if there are other references, just drop ours.
+	// This must not take the count to zero, because a concurrent
+	// lookup could find the entry in the pool, and revive it.
+	size_t cnt = _e->refs.load(std::memory_order_relaxed);
+	while (1 < cnt)
+	{
+		if (_e->refs.compare_exchange_weak(cnt, cnt-1,
+		                                   std::memory_order_acq_rel))
+			return;
+	}
+
+	// Slow path: this might be the last reference. Lookups increment
+	// the count under the shard lock, so holding the lock here makes
+	// the final decrement and the removal atomic.
+	Shard& sh = shards()[_e->hash % NUM_SHARDS];
+	std::lock_guard<std::mutex> lck(sh.mtx);
+	if (1 == _e->refs.fetch_sub(1, std::memory_order_acq_rel))
+	{
+		sh.names.erase(_e);
+		delete _e;
+	}
+}
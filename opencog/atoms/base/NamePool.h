@@ -0,0 +1,119 @@
+/*
+ * opencog/atoms/base/NamePool.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NAME_POOL_H
+#define _OPENCOG_NAME_POOL_H
+
+#include <atomic>
+#include <string>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// A shared, immutable name, in the pool. Use NodeName, not this.
+struct NameEntry
+{
+	mutable std::atomic<size_t> refs;
+	const size_t hash;
+	const std::string str;
+
+	NameEntry(std::string&& s, size_t h) :
+		refs(1), hash(h), str(std::move(s)) {}
+};
+
+/**
+ * The name of a Node. This is an immutable string, together with its
+ * hash, computed once, when the name is created.
+ *
+ * If the NamePool is enabled, then names are interned: all Nodes with
+ * the same name share the same string, no matter what their type is,
+ * or which AtomSpace they are in. This saves a lot of RAM for datasets
+ * that have many Nodes with the same name, such as the many kinds of
+ * word-Nodes used in language learning. It also makes comparing names
+ * cheap: two interned names are equal exactly when they are the same
+ * entry. If the pool is not enabled, the string is held directly,
+ * with no pool entry, and no reference count.
+ *
+ * Either the entry or the string is held, never both; the low bit of
+ * the hash says which. It is not part of the hash.
+ */
+class NodeName
+{
+	union
+	{
+		const NameEntry* _e;
+		std::string _str;
+	};
+	size_t _hash;
+
+	static constexpr size_t POOLED = 1;
+	bool pooled(void) const { return _hash & POOLED; }
+	void release(void);
+
+public:
+	NodeName(std::string);
+	NodeName(const char* s) : NodeName(std::string(s)) {}
+	NodeName(const NodeName&);
+	NodeName(NodeName&&) noexcept;
+	NodeName& operator=(const NodeName&);
+	NodeName& operator=(NodeName&&) noexcept;
+	~NodeName();
+
+	const std::string& str(void) const { return pooled() ? _e->str : _str; }
+	size_t hash(void) const { return _hash & ~POOLED; }
+	const char* c_str(void) const { return str().c_str(); }
+
+	bool operator==(const NodeName& other) const
+	{
+		if ((_hash ^ other._hash) & ~POOLED) return false;
+		if (pooled() and other.pooled()) return _e == other._e;
+		return str() == other.str();
+	}
+	bool operator!=(const NodeName& other) const
+	{
+		return not operator==(other);
+	}
+};
+
+/**
+ * The global pool of interned Node names. It is disabled by default;
+ * enable it before creating Nodes, so that the names get shared.
+ * Disabling it later does not un-share the names already pooled;
+ * it only stops new names from being pooled.
+ */
+class NamePool
+{
+public:
+	static void enable(bool);
+	static bool enabled(void);
+
+	/// The number of distinct names currently in the pool.
+	static size_t size(void);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_NAME_POOL_H
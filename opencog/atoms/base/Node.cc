@@ -45,31 +45,32 @@ void Node::init()
 /// any trailing newlines.
 std::string Node::to_short_string(const std::string& indent) const
 {
-    size_t len = _name.length();
+    const std::string& name(_name.str());
+    size_t len = name.length();
     std::string answer;
     answer.reserve(2*len);
     answer = indent + '(' + nameserver().getTypeName(_type) + " \"";
     for (unsigned int i=0; i < len; i++)
     {
-        if ('"' == _name[i] or '\\' == _name[i])
+        if ('"' == name[i] or '\\' == name[i])
         {
             answer += '\\';
-            answer += _name[i];
+            answer += name[i];
         }
-        else if ((unsigned char) _name[i] < 0x20)
+        else if ((unsigned char) name[i] < 0x20)
         {
             // Characters that control printing.
-            if ('\a' == _name[i]) answer += "\a";
-            else if ('\b' == _name[i]) answer += "\\b";
-            else if ('\t' == _name[i]) answer += "\\t";
-            else if ('\n' == _name[i]) answer += "\\n";
-            else if ('\v' == _name[i]) answer += "\\v";
-            else if ('\f' == _name[i]) answer += "\\f";
-            else if ('\r' == _name[i]) answer += "\\r";
-            else answer += _name[i];
+            if ('\a' == name[i]) answer += "\a";
+            else if ('\b' == name[i]) answer += "\\b";
+            else if ('\t' == name[i]) answer += "\\t";
+            else if ('\n' == name[i]) answer += "\\n";
+            else if ('\v' == name[i]) answer += "\\v";
+            else if ('\f' == name[i]) answer += "\\f";
+            else if ('\r' == name[i]) answer += "\\r";
+            else answer += name[i];
         }
         else
-            answer += _name[i];
+            answer += name[i];
     }
     answer += '\"';
 
@@ -91,7 +92,7 @@ std::string Node::to_string_esc() const
     std::stringstream ss;
 
     ss << "(" << nameserver().getTypeName(_type) << " "
-       << std::quoted(_name) << ")";
+       << std::quoted(_name.str()) << ")";
 
     return ss.str();
 }
@@ -110,7 +111,10 @@ bool Node::operator==(const Atom& other) const
     if (get_hash() != other.get_hash()) return false;
 
     if (get_type() != other.get_type()) return false;
-    return get_name() == other.get_name();
+
+    // Same type means the other is a Node, too. Interned names
+    // compare without looking at the string.
+    return _name == static_cast<const Node&>(other)._name;
 }
 
 bool Node::operator<(const Atom& other) const
@@ -132,7 +136,8 @@ bool Node::operator<(const Atom& other) const
 
 ContentHash Node::compute_hash() const
 {
-	ContentHash hsh = std::hash<std::string>()(get_name());
+	// The hash of the name was computed when the name was created.
+	ContentHash hsh = _name.hash();
 
 	// 1<<43 - 369 is a prime number.
 	hsh += (hsh<<5) + ((1ULL<<43)-369) * get_type();
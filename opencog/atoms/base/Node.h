@@ -28,6 +28,7 @@
 
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atoms/base/ClassServer.h>
+#include <opencog/atoms/base/NamePool.h>
 
 namespace opencog
 {
@@ -43,7 +44,7 @@ class Node : public Atom
 {
 protected:
     // properties
-    std::string _name;
+    NodeName _name;
     void init();
 
     virtual ContentHash compute_hash() const;
@@ -73,7 +74,7 @@ public:
      *
      * @return The name of the node.
      */
-    virtual const std::string& get_name() const { return _name; }
+    virtual const std::string& get_name() const { return _name.str(); }
 
     virtual size_t size() const { return 1; }
 
@@ -47,7 +47,7 @@ public:
 	TypeNode(Type t, const std::string&& s)
 		// Convert to number and back to string to avoid miscompares.
 		: Node(t, std::move(s)),
-		  _kind(nameserver().getType(_name))
+		  _kind(nameserver().getType(_name.str()))
 	{
 		// Perform strict checking only for TypeNode.  The
 		// DefinedTypeNode, which inherits from this class,
@@ -62,7 +62,7 @@ public:
 	TypeNode(const std::string&& s)
 		// Convert to number and back to string to avoid miscompares.
 		: Node(TYPE_NODE, std::move(s)),
-		  _kind(nameserver().getType(_name))
+		  _kind(nameserver().getType(_name.str()))
 	{
 		if (NOTYPE == _kind)
 			throw InvalidParamException(TRACE_INFO,
@@ -79,6 +79,7 @@ ValuePtr DualLink::execute(AtomSpace* as, bool silent)
 	if (nullptr == as) as = _atom_space;
 	Recognizer reco(as);
 	reco.satisfy(PatternLinkCast(get_handle()));
+	set_profile(reco.get_profile_ptr());
 
 	// If there is an anchor, then attach results to the anchor.
 	// Otherwise, create a SetLink and return that.
@@ -55,6 +55,7 @@ QueueValuePtr MeetLink::do_execute(AtomSpace* as, bool silent)
 	{
 		SatisfyingSet sater(as);
 		sater.satisfy(PatternLinkCast(get_handle()));
+		set_profile(sater.get_profile_ptr());
 		return sater.get_result_queue();
 	}
 	catch(const StandardException& ex)
@@ -30,6 +30,19 @@
 using namespace opencog;
 
 /* ======================================================== */
+/**
+ * Return true if the cached expansion was made with the definitions
+ * that are in force now. DefineLinks cannot be changed, only deleted
+ * and made again, so comparing the definitions is enough.
+ */
+bool PatternLink::jit_is_current(void) const
+{
+	for (const HandlePair& pr : _jit_defns)
+		if (DefineLink::get_definition(pr.first) != pr.second)
+			return false;
+	return true;
+}
+
 /**
  * Just-In-Time analysis of patterns. Patterns we could not unpack
  * earlier, because the definitions for them might not have been
@@ -42,6 +55,14 @@ PatternLinkPtr PatternLink::jit_analyze(void)
 	// If there are no definitions, there is nothing to do.
 	if (0 == _pat.defined_terms.size()) return jit;
 
+	// Rule engines run the same patterns over and over; don't redo
+	// the analysis, unless some definition has changed.
+	{
+		std::lock_guard<std::mutex> lck(_jit_mtx);
+		if (_jit_cache and jit_is_current()) return _jit_cache;
+	}
+	HandlePairSeq used;
+
 	// Now is the time to look up the definitions!
 	// We loop here, so that all recursive definitions are expanded
 	// as well.  XXX Except that this is wrong, if any of the
@@ -58,6 +79,7 @@ PatternLinkPtr PatternLink::jit_analyze(void)
 		for (const Handle& name : jit->_pat.defined_terms)
 		{
 			Handle defn = DefineLink::get_definition(name);
+			used.push_back({name, defn});
 			if (not defn) continue;
 
 			// Extract the variables in the definition.
@@ -97,6 +119,9 @@ PatternLinkPtr PatternLink::jit_analyze(void)
 	jit->debug_log("JIT expanded!");
 #endif
 
+	std::lock_guard<std::mutex> lck(_jit_mtx);
+	_jit_cache = jit;
+	_jit_defns = std::move(used);
 	return jit;
 }
 
@@ -23,6 +23,8 @@
 #ifndef _OPENCOG_PATTERN_LINK_H
 #define _OPENCOG_PATTERN_LINK_H
 
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include <opencog/atoms/core/Quotation.h>
@@ -70,6 +72,9 @@ namespace opencog
 /// components; the components themselves are connected only by
 /// virtual links.
 ///
+class QueryProfile;
+typedef std::shared_ptr<QueryProfile> QueryProfilePtr;
+
 class PatternLink;
 LINK_PTR_DECL(PatternLink)
 class PatternLink : public PrenexLink
@@ -110,6 +115,19 @@ protected:
 	HandleSetSeq _component_vars;
 	HandleSeq _component_patterns;
 
+	/// The most recent JIT expansion of the defined terms, and the
+	/// definitions that went into it. The expansion is re-used for
+	/// as long as all of those definitions stay the same.
+	std::mutex _jit_mtx;
+	PatternLinkPtr _jit_cache;
+	HandlePairSeq _jit_defns;
+	bool jit_is_current(void) const;
+
+	/// The work done by the most recent run of this query. It is kept
+	/// here, and not as a Value, as it changes on every run; see
+	/// `cog-query-profile`.
+	QueryProfilePtr _profile;
+
 	PatternTermPtr make_term_tree(const Handle&);
 	void make_term_tree_recursive(const PatternTermPtr&,
 	                              PatternTermPtr&);
@@ -179,13 +197,20 @@ public:
 	PatternLink(const HandleSet&,
 	            const HandleSeq&);
 
-	// Runtime just-in-time analysis
+	// Runtime just-in-time analysis. Cached; cheap, if none of the
+	// definitions that the pattern uses have changed since last time.
 	PatternLinkPtr jit_analyze(void);
 
 	// Return the list of variables we are holding.
 	const Variables& get_variables(void) const { return _variables; }
 	const Pattern& get_pattern(void) const { return _pat; }
 
+	// The profile of the most recent run, or null, if never run.
+	void set_profile(const QueryProfilePtr& prof)
+		{ std::atomic_store(&_profile, prof); }
+	QueryProfilePtr get_profile(void) const
+		{ return std::atomic_load(&_profile); }
+
 	const HandleSeqSeq& get_components(void) const { return _components; }
 	const HandleSeq& get_component_patterns(void) const
 		{ return _component_patterns; }
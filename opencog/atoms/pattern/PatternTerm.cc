@@ -9,6 +9,7 @@
  */
 
 #include <opencog/util/oc_assert.h>
+#include <opencog/atoms/atom_types/NameServer.h>
 #include "PatternTerm.h"
 
 namespace opencog {
@@ -323,6 +324,68 @@ void PatternTerm::markAlways()
 
 // ==============================================================
 
+/// Return true if this term can be matched by comparing it, atom by
+/// atom, to the grounding, with nothing more than a type check on the
+/// variables. Anything needing permutations, globs, evaluation,
+/// quotation or alpha-conversion is left to the general matcher.
+bool PatternTerm::isFlattenable() const
+{
+	if (isQuoted() or nullptr != _quote) return false;
+	if (_is_choice or _has_choice or _is_present or _is_absent or _is_always)
+		return false;
+	if (_has_any_evaluatable or _has_any_globby_var or _has_any_unordered_link)
+		return false;
+
+	if (_is_bound_var) return _handle->is_node();
+
+	Type t = _handle->get_type();
+	if (VARIABLE_NODE == t or GLOB_NODE == t or DEFINED_SCHEMA_NODE == t)
+		return false;
+	if (_handle->is_node()) return true;
+
+	if (STATE_LINK == t or CHOICE_LINK == t or
+	    Quotation::is_quotation_type(t) or
+	    nameserver().isA(t, SCOPE_LINK))
+		return false;
+
+	// Constants may have been dropped from the term; see
+	// PatternLink::make_term_tree_recursive().
+	if (getArity() != _handle->get_arity()) return false;
+
+	for (const PatternTermPtr& ptm : getOutgoingSet())
+		if (not ptm->isFlattenable()) return false;
+
+	return true;
+}
+
+/// Append the pre-order instructions for this term to `prog`.
+void PatternTerm::flatten(FlatTerm& prog) const
+{
+	size_t here = prog.size();
+	prog.push_back({FlatTermOp::LINK, _handle->get_type(),
+	                getArity(), 0, _handle});
+
+	if (_is_bound_var)
+		prog[here].kind = FlatTermOp::VAR;
+	else if (_handle->is_node())
+		prog[here].kind = FlatTermOp::NODE;
+	else
+		for (const PatternTermPtr& ptm : getOutgoingSet())
+			ptm->flatten(prog);
+
+	prog[here].end = prog.size();
+}
+
+const FlatTerm& PatternTerm::getFlat() const
+{
+	std::call_once(_flat_once, [this]() {
+		if (isFlattenable()) flatten(_flat);
+	});
+	return _flat;
+}
+
+// ==============================================================
+
 std::string PatternTerm::to_short_string() const { return to_string(": "); }
 
 std::string PatternTerm::to_short_string(const std::string& sep) const
@@ -11,6 +11,7 @@
 #ifndef _OPENCOG_PATTERN_TERM_H
 #define _OPENCOG_PATTERN_TERM_H
 
+#include <mutex>
 #include <vector>
 
 #include <opencog/util/Logger.h>
@@ -70,6 +71,24 @@ typedef std::vector<PatternTermPtr> PatternTermSeq;
 typedef std::vector<PatternTermWPtr> PatternTermWSeq;
 typedef std::set<PatternTermPtr> PatternTermSet;
 
+/**
+ * One instruction of a flattened term; see PatternTerm::getFlat().
+ * The instructions are laid out in pre-order, so that the subterms
+ * of a link follow it directly, and `end` is the index just past the
+ * last instruction of the subtree. Thus, a subtree can be skipped
+ * over by jumping to `end`.
+ */
+struct FlatTermOp
+{
+	enum Kind : uint8_t { VAR, NODE, LINK };
+	Kind kind;
+	Type type;
+	Arity arity;
+	size_t end;
+	Handle handle;
+};
+typedef std::vector<FlatTermOp> FlatTerm;
+
 class PatternTerm
 	: public std::enable_shared_from_this<PatternTerm>
 {
@@ -167,6 +186,12 @@ protected:
 	void addAnyGlobbyVar();
 	void addAnyEvaluatable();
 
+	// The flattened form of this term, built on first use.
+	mutable std::once_flag _flat_once;
+	mutable FlatTerm _flat;
+	bool isFlattenable() const;
+	void flatten(FlatTerm&) const;
+
 public:
 	static const PatternTermPtr UNDEFINED;
 
@@ -236,6 +261,12 @@ public:
 	bool isUnorderedLink() const noexcept { return _handle->is_unordered_link(); }
 	bool isLink() const noexcept { return _handle->is_link(); }
 
+	/// The term, as a flat array of instructions, if it is simple
+	/// enough to be matched without any of the callbacks: that is,
+	/// if it holds only ordered links, constant nodes and bound
+	/// variables. Otherwise, the array is empty.
+	const FlatTerm& getFlat() const;
+
 	bool contained_in(const std::vector<PatternTermPtr>& vect) {
 		for (const PatternTermPtr& itm : vect)
 			if (itm->_handle == _handle) return true; // XXX maybe quote?
@@ -175,6 +175,7 @@ QueueValuePtr QueryLink::do_execute(AtomSpace* as, bool silent)
 	try
 	{
 		impl.satisfy(PatternLinkCast(get_handle()));
+		set_profile(impl.get_profile_ptr());
 	}
 	catch(const StandardException& ex)
 	{
@@ -51,6 +51,7 @@ TruthValuePtr SatisfactionLink::evaluate(AtomSpace* as, bool silent)
 	if (nullptr == as) as = _atom_space;
 	Satisfier sater(as);
 	sater.satisfy(PatternLinkCast(get_handle()));
+	set_profile(sater.get_profile_ptr());
 
 	// If there is an anchor, then attach results to the anchor.
 	if (_variables._anchor and as)
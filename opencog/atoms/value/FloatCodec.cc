@@ -0,0 +1,278 @@
+/*
+ * opencog/atoms/value/FloatCodec.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <charconv>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/value/FloatCodec.h>
+
+using namespace opencog;
+
+// Bump this if the format ever changes.
+#define FLOAT_CODEC_VERSION 1
+
+// ==============================================================
+
+static inline uint64_t to_bits(double d)
+{
+	uint64_t u;
+	memcpy(&u, &d, sizeof(u));
+	return u;
+}
+
+static inline double from_bits(uint64_t u)
+{
+	double d;
+	memcpy(&d, &u, sizeof(d));
+	return d;
+}
+
+/// Append the packed form of the vector to the buffer.
+///
+/// The header byte of each entry holds the number of trailing zero
+/// bytes of the XOR in the high nibble, and the number of bytes that
+/// follow in the low nibble. A header of zero means "same as before".
+void opencog::pack_floats(std::string& out, const std::vector<double>& fv)
+{
+	out += (char) FLOAT_CODEC_VERSION;
+
+	size_t n = fv.size();
+	do
+	{
+		unsigned char c = n & 0x7f;
+		n >>= 7;
+		if (n) c |= 0x80;
+		out += (char) c;
+	}
+	while (n);
+
+	uint64_t prev = 0;
+	for (double d : fv)
+	{
+		uint64_t bits = to_bits(d);
+		uint64_t x = bits ^ prev;
+		prev = bits;
+
+		if (0 == x) { out += '\0'; continue; }
+
+		int tz = __builtin_ctzll(x) / 8;
+		int lz = __builtin_clzll(x) / 8;
+		int nb = 8 - tz - lz;
+		out += (char) ((tz << 4) | nb);
+
+		x >>= 8 * tz;
+		for (int i = 0; i < nb; i++)
+		{
+			out += (char) (x & 0xff);
+			x >>= 8;
+		}
+	}
+}
+
+std::string opencog::pack_floats(const std::vector<double>& fv)
+{
+	std::string out;
+	out.reserve(2 + 3 * fv.size());
+	pack_floats(out, fv);
+	return out;
+}
+
+std::vector<double> opencog::unpack_floats(const char* buf, size_t len)
+{
+	const unsigned char* p = (const unsigned char*) buf;
+	const unsigned char* end = p + len;
+
+	if (p == end or FLOAT_CODEC_VERSION != *p)
+		throw RuntimeException(TRACE_INFO,
+			"Unknown packed float format");
+	p++;
+
+	size_t n = 0;
+	int shift = 0;
+	while (true)
+	{
+		if (p == end or 63 < shift)
+			throw RuntimeException(TRACE_INFO, "Truncated packed floats");
+		n |= ((size_t) (*p & 0x7f)) << shift;
+		shift += 7;
+		if (0 == (*p++ & 0x80)) break;
+	}
+
+	// Each entry takes at least one byte.
+	if ((size_t) (end - p) < n)
+		throw RuntimeException(TRACE_INFO, "Truncated packed floats");
+
+	std::vector<double> fv;
+	fv.reserve(n);
+	uint64_t prev = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		if (p == end)
+			throw RuntimeException(TRACE_INFO, "Truncated packed floats");
+
+		int tz = *p >> 4;
+		int nb = *p & 0x0f;
+		p++;
+		if (8 < tz + nb or end - p < nb)
+			throw RuntimeException(TRACE_INFO, "Malformed packed floats");
+
+		uint64_t x = 0;
+		for (int j = 0; j < nb; j++)
+			x |= ((uint64_t) p[j]) << (8 * j);
+		p += nb;
+
+		prev ^= x << (8 * tz);
+		fv.push_back(from_bits(prev));
+	}
+
+	if (p != end)
+		throw RuntimeException(TRACE_INFO, "Malformed packed floats");
+	return fv;
+}
+
+// ==============================================================
+
+static const char b64chars[] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void opencog::base64_encode(std::string& out, const std::string& in)
+{
+	const unsigned char* p = (const unsigned char*) in.data();
+	size_t len = in.size();
+	out.reserve(out.size() + 4 * ((len + 2) / 3));
+
+	size_t i = 0;
+	for (; i + 2 < len; i += 3)
+	{
+		uint32_t w = (p[i] << 16) | (p[i+1] << 8) | p[i+2];
+		out += b64chars[(w >> 18) & 0x3f];
+		out += b64chars[(w >> 12) & 0x3f];
+		out += b64chars[(w >> 6) & 0x3f];
+		out += b64chars[w & 0x3f];
+	}
+
+	if (i + 1 == len)
+	{
+		uint32_t w = p[i] << 16;
+		out += b64chars[(w >> 18) & 0x3f];
+		out += b64chars[(w >> 12) & 0x3f];
+		out += "==";
+	}
+	else if (i + 2 == len)
+	{
+		uint32_t w = (p[i] << 16) | (p[i+1] << 8);
+		out += b64chars[(w >> 18) & 0x3f];
+		out += b64chars[(w >> 12) & 0x3f];
+		out += b64chars[(w >> 6) & 0x3f];
+		out += '=';
+	}
+}
+
+static inline int b64value(char c)
+{
+	if ('A' <= c and c <= 'Z') return c - 'A';
+	if ('a' <= c and c <= 'z') return c - 'a' + 26;
+	if ('0' <= c and c <= '9') return c - '0' + 52;
+	if ('+' == c) return 62;
+	if ('/' == c) return 63;
+	return -1;
+}
+
+std::string opencog::base64_decode(const char* in, size_t len)
+{
+	std::string out;
+	out.reserve(3 * len / 4);
+
+	uint32_t w = 0;
+	int nbits = 0;
+	size_t i = 0;
+	for (; i < len; i++)
+	{
+		char c = in[i];
+		if (' ' == c or '\n' == c or '\t' == c or '\r' == c) continue;
+		if ('=' == c) break;
+
+		int v = b64value(c);
+		if (v < 0)
+			throw RuntimeException(TRACE_INFO,
+				"Invalid base-64 character '%c'", c);
+
+		w = (w << 6) | v;
+		nbits += 6;
+		if (8 <= nbits)
+		{
+			nbits -= 8;
+			out += (char) ((w >> nbits) & 0xff);
+		}
+	}
+
+	// Only padding and whitespace may follow.
+	for (; i < len; i++)
+	{
+		char c = in[i];
+		if ('=' != c and ' ' != c and '\n' != c and '\t' != c and '\r' != c)
+			throw RuntimeException(TRACE_INFO,
+				"Invalid base-64 character '%c'", c);
+	}
+	return out;
+}
+
+// ==============================================================
+// Text forms.
+
+void opencog::print_double(std::string& out, double d)
+{
+	char buf[32];
+#if defined(__cpp_lib_to_chars)
+	// With no format and no precision, this is the shortest form
+	// that round-trips.
+	auto res = std::to_chars(buf, buf + sizeof(buf), d);
+	out.append(buf, res.ptr - buf);
+#else
+	int n = snprintf(buf, sizeof(buf), "%.15g", d);
+	if (strtod(buf, nullptr) != d)
+		n = snprintf(buf, sizeof(buf), "%.17g", d);
+	out.append(buf, n);
+#endif
+}
+
+void opencog::print_quoted(std::string& out, const std::string& s)
+{
+	out += '"';
+	size_t start = 0;
+	size_t pos = s.find_first_of("\"\\");
+	while (std::string::npos != pos)
+	{
+		out.append(s, start, pos - start);
+		out += '\\';
+		out += s[pos];
+		start = pos + 1;
+		pos = s.find_first_of("\"\\", start);
+	}
+	out.append(s, start, std::string::npos);
+	out += '"';
+}
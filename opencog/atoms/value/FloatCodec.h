@@ -0,0 +1,77 @@
+/*
+ * opencog/atoms/value/FloatCodec.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_FLOAT_CODEC_H
+#define _OPENCOG_FLOAT_CODEC_H
+
+#include <string>
+#include <vector>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Compact, exact binary encoding for vectors of doubles, as found in
+ * FloatValues and TruthValues. Intended for use by storage backends,
+ * in place of printing each number as decimal text.
+ *
+ * Each number is XOR'ed with the one before it (the first with zero),
+ * and only the bytes between the leading and trailing zero bytes of
+ * the result are kept, after a one-byte header giving their position.
+ * Repeated numbers take one byte; small integers, and numbers close
+ * to the one before, take two to four. Decoding gives back exactly
+ * the same bits, including those of NaN's, infinities and minus zero.
+ *
+ * The packed form starts with a format byte, followed by the number
+ * of entries, as a base-128 varint.
+ */
+void pack_floats(std::string&, const std::vector<double>&);
+std::string pack_floats(const std::vector<double>&);
+
+/// Decode the packed form. Throws a RuntimeException if malformed.
+std::vector<double> unpack_floats(const char*, size_t);
+inline std::vector<double> unpack_floats(const std::string& s)
+	{ return unpack_floats(s.data(), s.size()); }
+
+/// Base-64 (RFC 4648, with padding), for placing the packed form into
+/// text formats. Decoding skips whitespace, and throws a
+/// RuntimeException on anything else that is not base-64.
+void base64_encode(std::string&, const std::string&);
+std::string base64_decode(const char*, size_t);
+
+/// Append `d` as decimal text, with the fewest digits that read back
+/// as exactly the same double. Used by the s-expression and JSON
+/// printers.
+void print_double(std::string&, double);
+
+/// Append the string in double-quotes, with a backslash before each
+/// quote and backslash in it. Same output as `std::quoted()`.
+void print_quoted(std::string&, const std::string&);
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FLOAT_CODEC_H
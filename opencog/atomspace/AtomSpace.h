@@ -25,6 +25,9 @@
 #ifndef _OPENCOG_ATOMSPACE_H
 #define _OPENCOG_ATOMSPACE_H
 
+#include <atomic>
+#include <mutex>
+
 #include <opencog/util/async_method_caller.h>
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_omp.h>
@@ -51,6 +54,7 @@ typedef SigSlot<const Handle&,
 
 class AtomSpace;
 typedef std::shared_ptr<AtomSpace> AtomSpacePtr;
+class RuleIndex;
 
 /**
  * This class provides mechanisms to store atoms and keep indices for
@@ -61,6 +65,8 @@ typedef std::shared_ptr<AtomSpace> AtomSpacePtr;
 class AtomSpace : public Atom
 {
     friend class StorageNode;     // Needs to call add() directly.
+    friend class Atom;            // Needs to call note_change()
+    friend class RuleIndex;       // Kept in _rule_index.
 
     // Debug tools
     static const bool EMIT_DIAGNOSTICS = true;
@@ -107,6 +113,22 @@ class AtomSpace : public Atom
     /** Signal emitted when the TV changes. */
     TVCHSigl _TVChangedSignal;
 
+    /// Change tracking, for incremental saves. When enabled, every
+    /// Atom that is added, or has a Value changed, is recorded here,
+    /// once, until the next call to `take_changes()`. The per-atom
+    /// `_changed` flag keeps this list free of duplicates, so that
+    /// the lock is taken only on the first change to an Atom.
+    std::atomic<bool> _track_changes;
+    std::mutex _change_mtx;
+    HandleSeq _changes;
+    void note_change(Atom*);
+
+    /// The index of the rules in this AtomSpace, for the Recognizer.
+    /// Built on first use, by `RuleIndex::of()`, and destroyed along
+    /// with the AtomSpace.
+    std::mutex _rule_mtx;
+    std::shared_ptr<RuleIndex> _rule_index;
+
     void init();
     void clear_all_atoms();
 
@@ -185,6 +207,19 @@ public:
     void clear_copy_on_write(void) { _copy_on_write = false; }
     bool get_copy_on_write(void) const { return _copy_on_write; }
 
+    /// Keep track of the Atoms that were added, or had Values changed.
+    /// This allows incremental saves to storage, where only the Atoms
+    /// that changed since the last save are written. The changes are
+    /// recorded only for the Atoms in this AtomSpace, and not for those
+    /// in any base AtomSpaces. Tracking is off by default.
+    void track_changes(bool);
+    bool tracking_changes(void) const { return _track_changes; }
+
+    /// Return the Atoms that changed since the last call, and start
+    /// recording afresh. Atoms that have since been extracted are not
+    /// returned.
+    HandleSeq take_changes(void);
+
     // -------------------------------------------------------
 
     /**
@@ -498,6 +533,15 @@ public:
                         bool parent=true,
                         const AtomSpace* = nullptr) const;
 
+    /**
+     * Append up to `n` Atoms of exactly the given type to `hseq`, for
+     * use as a statistical sample. Only the Atoms that are taken are
+     * copied, so this is cheap, no matter how many Atoms there are.
+     * The Atoms in this AtomSpace are taken first, and then those in
+     * the ones below it. Shadowed Atoms are not removed.
+     */
+    void sample_by_type(HandleSeq& hseq, Type type, size_t n) const;
+
     /**
      * Gets a set of handles that matches with the given type,
      * but ONLY if they have an empty incoming set! 
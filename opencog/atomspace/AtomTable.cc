@@ -73,6 +73,7 @@ void AtomSpace::init(void)
     _uuid = _id_pool.fetch_add(1, std::memory_order_relaxed);
 
     _name = "(uuid . " + std::to_string(_uuid) + ")";
+    _track_changes = false;
 
     // Connect signal to find out about type additions
     addedTypeConnection =
@@ -182,6 +183,9 @@ void AtomSpace::clear_all_atoms()
 void AtomSpace::clear()
 {
     clear_all_atoms();
+
+    // Everything is gone; there is nothing left to save.
+    if (_track_changes) take_changes();
 }
 
 /// Find an equivalent atom that is exactly the same as the arg. If
@@ -363,6 +367,8 @@ Handle AtomSpace::add(const Handle& orig, bool force)
     const Handle& oldh(typeIndex.insertAtom(atom));
     if (oldh) return oldh;
 
+    if (_track_changes) note_change(atom.get());
+
     // Now that we are completely done, emit the added signal.
     // Don't emit signal until after the indexes are updated!
     _addAtomSignal.emit(atom);
@@ -521,6 +527,48 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
     return true;
 }
 
+// ====================================================================
+// Change tracking.
+
+void AtomSpace::track_changes(bool on)
+{
+    if (on == _track_changes.exchange(on)) return;
+
+    // Whatever was recorded before is meaningless now.
+    if (not on) take_changes();
+}
+
+void AtomSpace::note_change(Atom* atom)
+{
+    // Record each Atom only once.
+    if (atom->_changed.exchange(true)) return;
+
+    std::lock_guard<std::mutex> lck(_change_mtx);
+    _changes.emplace_back(atom->get_handle());
+}
+
+HandleSeq AtomSpace::take_changes(void)
+{
+    HandleSeq chg;
+    {
+        std::lock_guard<std::mutex> lck(_change_mtx);
+        chg.swap(_changes);
+    }
+
+    // Clear the flags, so that further changes get recorded again.
+    // A change that races with this is not lost: either it gets
+    // recorded anew, or it is already visible to the caller, who
+    // is about to look at the current Values.
+    HandleSeq rv;
+    rv.reserve(chg.size());
+    for (const Handle& h : chg)
+    {
+        h->_changed = false;
+        if (this == h->getAtomSpace()) rv.emplace_back(h);
+    }
+    return rv;
+}
+
 /// This is the resize callback, when a new type is dynamically added.
 void AtomSpace::typeAdded(Type t)
 {
@@ -603,6 +651,19 @@ void AtomSpace::get_handles_by_type(HandleSeq& hseq,
     }
 }
 
+void AtomSpace::sample_by_type(HandleSeq& hseq, Type type, size_t n) const
+{
+    size_t had = hseq.size();
+    typeIndex.sample_by_type(hseq, type, n);
+
+    for (const AtomSpacePtr& base : _environ)
+    {
+        size_t got = hseq.size() - had;
+        if (n <= got) return;
+        base->sample_by_type(hseq, type, n - got);
+    }
+}
+
 // Same as above, but works with an unordered set, instead of a vector.
 // By working with a set instead of a sequence, there will not be any
 // duplicate atoms due to shadowing of child spaces by parent spaces.
@@ -72,6 +72,19 @@ void TypeIndex::get_handles_by_type(HandleSeq& hseq,
 	}
 }
 
+// The atoms are taken in the order of the hash table, which is the
+// order of their hashes, and thus as good as random.
+void TypeIndex::sample_by_type(HandleSeq& hseq, Type type, size_t n) const
+{
+	TYPE_INDEX_SHARED_LOCK;
+	const AtomSet& s(_idx.at(type));
+	for (const Handle& h : s)
+	{
+		if (0 == n--) return;
+		hseq.push_back(h);
+	}
+}
+
 // Same as above, except using an unordered set.
 void TypeIndex::get_handles_by_type(HandleSet& hset,
                                     Type type,
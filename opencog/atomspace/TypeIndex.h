@@ -165,6 +165,9 @@ class TypeIndex
 
 		void get_handles_by_type(HandleSeq&, Type, bool subclass) const;
 		void get_handles_by_type(HandleSet&, Type, bool subclass) const;
+
+		// Append up to `n` atoms of type t, without copying the rest.
+		void sample_by_type(HandleSeq&, Type, size_t n) const;
 		void get_rootset_by_type(HandleSeq&, Type, bool subclass,
 		                         const AtomSpace*) const;
 };
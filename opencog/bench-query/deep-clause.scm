@@ -0,0 +1,55 @@
+;
+; deep-clause.scm
+;
+; A quick-n-dirty tool to measure how the pattern matcher performs on
+; patterns with many clauses. The patterns are paths, of varying
+; length, through a random graph. Each step of the path is one clause,
+; and so the engine has to push and pop its state once per clause, for
+; every partial path that it explores.
+;
+; Usage:
+;    guile -l deep-clause.scm
+;
+; Prints the path length (number of clauses), the number of paths
+; found, and the time taken, in seconds.
+
+(use-modules (opencog) (opencog exec))
+
+(define edge (Predicate "edge"))
+
+; Create NEDGES random edges between NVERTS vertices.
+(define (make-graph NEDGES NVERTS)
+	(define (vert) (Concept (format #f "vertex ~D" (random NVERTS))))
+	(define (mkedges N)
+		(when (< 0 N)
+			(Evaluation edge (List (vert) (vert)))
+			(mkedges (- N 1))))
+	(mkedges NEDGES))
+
+; A Get that finds paths of length LEN, starting at vertex zero.
+(define (make-path-query LEN)
+	(define vars
+		(map (lambda (i) (Variable (format #f "$v~D" i))) (iota LEN 1)))
+	(define (step from to) (Evaluation edge (List from to)))
+	(define (steps from rest)
+		(if (null? rest) '()
+			(cons (step from (car rest)) (steps (car rest) (cdr rest)))))
+	(Get
+		(VariableList (map (lambda (v) (TypedVariable v (Type 'Concept))) vars))
+		(And (steps (Concept "vertex 0") vars))))
+
+; Run the query for path length LEN, and report the time it took.
+(define (time-query LEN)
+	(define qry (make-path-query LEN))
+	(define start (get-internal-real-time))
+	(define result (cog-execute! qry))
+	(define elapsed (exact->inexact
+		(/ (- (get-internal-real-time) start) internal-time-units-per-second)))
+	(format #t "clauses=~D paths=~D time=~6,3F secs\n"
+		LEN (cog-arity result) elapsed)
+	(cog-extract-recursive! result))
+
+(set! *random-state* (seed->random-state 42))
+(make-graph 6000 1000)
+
+(for-each time-query (iota 9 2))
@@ -0,0 +1,60 @@
+;
+; unordered.scm
+;
+; A quick-n-dirty tool to measure how the pattern matcher performs on
+; unordered links. The patterns are SetLinks of 5 to 10 members, most
+; of them constants, the rest variables. A naive search tries all N!
+; permutations of the pattern against each candidate SetLink; this
+; shows how many are actually tried.
+;
+; Usage:
+;    guile -l unordered.scm
+;
+; Prints the size of the SetLink, the number of groundings found,
+; the number of permutations tried, and the time taken, in seconds.
+
+(use-modules (opencog) (opencog exec))
+
+(define group (Concept "group"))
+(define (elt I) (Concept (format #f "elt ~D" I)))
+
+; Create NSETS SetLinks of N members each, drawn from a pool of NPOOL
+; elements. Set K holds elements K through K+N-1, so that every element
+; is in N different sets.
+(define (make-sets N NSETS NPOOL)
+	(for-each
+		(lambda (k)
+			(Member
+				(Set (map (lambda (i) (elt (modulo (+ k i) NPOOL))) (iota N)))
+				group))
+		(iota NSETS)))
+
+; A Get for SetLinks holding elements 0 through NCONST-1, together
+; with N-NCONST other elements, bound to variables.
+(define (make-set-query N NCONST)
+	(define vars
+		(map (lambda (i) (Variable (format #f "$v~D" i)))
+			(iota (- N NCONST))))
+	(Get
+		(VariableList (map (lambda (v) (TypedVariable v (Type 'Concept))) vars))
+		(Member (Set (append (map elt (iota NCONST)) vars)) group)))
+
+; Run the query, and report the time it took.
+(define (time-query N NCONST)
+	(define qry (make-set-query N NCONST))
+	(define start (get-internal-real-time))
+	(define result (cog-execute! qry))
+	(define elapsed (exact->inexact
+		(/ (- (get-internal-real-time) start) internal-time-units-per-second)))
+	(format #t "members=~D constants=~D found=~D perms=~D time=~6,3F secs\n"
+		N NCONST (cog-arity result)
+		(inexact->exact (cdr (assq 'permutations (cog-query-profile qry))))
+		elapsed)
+	(cog-extract-recursive! result))
+
+(for-each
+	(lambda (n)
+		(make-sets n 2000 2000)
+		(time-query n (- n 2))
+		(time-query n (- n 3)))
+	(iota 6 5))
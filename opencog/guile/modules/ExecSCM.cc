@@ -31,7 +31,13 @@ void opencog_exec_init(void);
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/execution/EvaluationLink.h>
 #include <opencog/atoms/execution/Instantiator.h>
+#include <opencog/atoms/pattern/PatternLink.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
 #include <opencog/guile/SchemeModule.h>
+#include <opencog/query/QueryPlanner.h>
+#include <opencog/query/QueryProfile.h>
+#include <opencog/query/StandingQuery.h>
 
 // ========================================================
 
@@ -65,6 +71,87 @@ static TruthValuePtr ss_evaluate(AtomSpace* atomspace, const Handle& h)
 	return EvaluationLink::do_evaluate(atomspace, h);
 }
 
+/**
+ * cog-explain describes the cost-based plan for a query: where it
+ * would start, the order in which the clauses would be grounded,
+ * and the estimated cost of each step. This is the plan that the
+ * engine follows. Nothing is grounded.
+ */
+static ValuePtr ss_explain(AtomSpace* atomspace, const Handle& h)
+{
+	PatternLinkPtr plp(PatternLinkCast(h));
+	if (nullptr == plp)
+		throw SyntaxException(TRACE_INFO,
+			"Expecting a query (GetLink, QueryLink, etc.), got %s",
+			h->to_short_string().c_str());
+
+	PatternLinkPtr jit(plp->jit_analyze());
+	const HandleSeq& comps = jit->get_component_patterns();
+	if (comps.size() < 2)
+	{
+		QueryPlanner plan(atomspace, jit->get_variables(),
+		                  jit->get_pattern());
+		return createStringValue(plan.explain());
+	}
+
+	// Each component is searched on its own; the results are then
+	// joined by Cartesian product.
+	std::string rs = "Cartesian product of "
+		+ std::to_string(comps.size()) + " components\n";
+	for (size_t i = 0; i < comps.size(); i++)
+	{
+		PatternLinkPtr clp(PatternLinkCast(comps[i]));
+		QueryPlanner plan(atomspace, clp->get_variables(),
+		                  clp->get_pattern());
+		rs += "Component " + std::to_string(i+1) + ":\n";
+		rs += plan.explain("   ");
+	}
+	return createStringValue(rs);
+}
+
+/**
+ * cog-attach-query-profile attaches the profile of the most recent
+ * run of the query to it, and returns it; or #f, if it was never run.
+ */
+static ValuePtr ss_attach_query_profile(AtomSpace* atomspace,
+                                        const Handle& h)
+{
+	PatternLinkPtr plp(PatternLinkCast(h));
+	if (nullptr == plp)
+		throw SyntaxException(TRACE_INFO,
+			"Expecting a query (GetLink, QueryLink, etc.), got %s",
+			h->to_short_string().c_str());
+
+	QueryProfilePtr prof(plp->get_profile());
+	if (nullptr == prof) return nullptr;
+
+	ValuePtr pv(prof->get_value());
+	AtomSpace* as = h->getAtomSpace();
+	if (nullptr == as) as = atomspace;
+	as->set_value(h, QueryProfile::key(), pv);
+	return pv;
+}
+
+/**
+ * cog-standing-query starts keeping the results of a query current.
+ * Returns the queues of the results and of the retracted results.
+ */
+static ValuePtr ss_standing_query(AtomSpace* atomspace, const Handle& h)
+{
+	StandingQueryPtr sq(StandingQuery::start(h));
+	return createLinkValue(ValueSeq({sq->get_results(),
+	                                 sq->get_retracted()}));
+}
+
+/**
+ * cog-cancel-standing-query stops keeping the results current.
+ */
+static Handle ss_cancel_standing_query(AtomSpace* atomspace, const Handle& h)
+{
+	StandingQuery::cancel(h);
+	return h;
+}
+
 // ========================================================
 
 // XXX HACK ALERT This needs to be static, in order for python to
@@ -89,6 +176,18 @@ void ExecSCM::init(void)
 
 	_binders->push_back(new FunctionWrap(ss_evaluate,
 	                   "cog-evaluate!", "exec"));
+
+	_binders->push_back(new FunctionWrap(ss_explain,
+	                   "cog-explain", "exec"));
+
+	_binders->push_back(new FunctionWrap(ss_attach_query_profile,
+	                   "cog-attach-query-profile", "exec"));
+
+	_binders->push_back(new FunctionWrap(ss_standing_query,
+	                   "cog-standing-query", "exec"));
+
+	_binders->push_back(new FunctionWrap(ss_cancel_standing_query,
+	                   "cog-cancel-standing-query", "exec"));
 }
 
 ExecSCM::~ExecSCM()
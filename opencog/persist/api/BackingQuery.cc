@@ -30,6 +30,9 @@
 
 #include <opencog/atoms/join/JoinLink.h>
 #include <opencog/atoms/pattern/QueryLink.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+#include <opencog/query/DeltaSearch.h>
 #include <opencog/query/Implicator.h>
 #include <opencog/query/Satisfier.h>
 
@@ -259,4 +262,91 @@ void BackingStore::runQuery(const Handle& query, const Handle& key,
 	storeValue(query, meta);
 }
 
+// ==========================================================
+
+/// updateQuery -- extend the results of an earlier runQuery() with
+/// the groundings that involve the indicated Atoms, which were added
+/// to the AtomSpace after the query was last run. This is only valid
+/// for queries whose results can only grow as Atoms are added: see
+/// the QueryCache for which ones those are.
+///
+/// Returns false if the earlier results are not in a form that can
+/// be extended; the query must then be re-run.
+bool BackingStore::updateQuery(const Handle& query, const Handle& key,
+                               const Handle& meta, const HandleSeq& added)
+{
+	ValuePtr old = query->getValue(key);
+	if (nullptr == old or not old->is_type(LINK_VALUE)) return false;
+
+	Type qt = query->get_type();
+	AtomSpace* as = query->getAtomSpace();
+	AtomSpace* tas = grab_transient_atomspace(as);
+
+	// The results are those found in storage, so start from what
+	// storage holds: the added Atoms that it does not know about
+	// cannot ground anything there.
+	HandleSeq fetched;
+	for (const Handle& h : added)
+	{
+		if (not h->is_link()) { fetched.push_back(h); continue; }
+		Handle fh = getLink(h->get_type(), h->getOutgoingSet());
+		if (fh) fetched.emplace_back(tas->add_atom(fh));
+	}
+
+	if (0 == fetched.size())
+	{
+		release_transient_atomspace(tas);
+		return true;
+	}
+
+	ValuePtr qv;
+	if (nameserver().isA(qt, QUERY_LINK))
+	{
+		QueryLinkPtr qlp(QueryLinkCast(query));
+		DeltaSearch<BackingImplicator> impl(fetched, this, tas);
+		impl.implicand = qlp->get_implicand();
+		impl.satisfy(qlp);
+		qv = impl.get_result_queue();
+	}
+	else if (nameserver().isA(qt, MEET_LINK))
+	{
+		DeltaSearch<BackingSatisfyingSet> sater(fetched, this, tas);
+		sater.satisfy(PatternLinkCast(query));
+		qv = sater.get_result_queue();
+	}
+	if (qv) qv = as->add_atoms(qv);
+	release_transient_atomspace(tas);
+
+	if (nullptr == qv) return false;
+
+	// Append the new results, skipping those we already have.
+	const ValueSeq& ovs(LinkValueCast(old)->value());
+	const ValueSeq& nvs(LinkValueCast(qv)->value());
+	if (0 == nvs.size()) return true;
+
+	HandleSet have;
+	for (const ValuePtr& v : ovs)
+		if (v->is_atom()) have.insert(HandleCast(v));
+
+	ValueSeq vs(ovs);
+	for (const ValuePtr& v : nvs)
+	{
+		if (v->is_atom() and not have.insert(HandleCast(v)).second)
+			continue;
+		vs.push_back(v);
+	}
+	if (vs.size() == ovs.size()) return true;
+
+	query->setValue(key, valueserver().create(old->get_type(), vs));
+	storeValue(query, key);
+
+	if (nullptr == meta) return true;
+
+	time_t now = time(0);
+	double dnow = now;
+	query->setValue(meta, createFloatValue(dnow));
+	storeValue(query, meta);
+	return true;
+}
+
 // ====================== END OF FILE =======================
@@ -32,7 +32,9 @@ using namespace opencog;
 // instead. The reason for this is that they need to insert
 // keys and values into AtomSpaces, and that is problematic
 // with the old API. The below mostly patches this up...
-void BackingStore::getAtom(const Handle& h)
+//
+// Returns false if storage does not have the Atom.
+bool BackingStore::getAtomCompat(const Handle& h)
 {
 	Handle hv;
 	if (h->is_node())
@@ -41,20 +43,55 @@ void BackingStore::getAtom(const Handle& h)
 		hv = getLink(h->get_type(), h->getOutgoingSet());
 
 	barrier();
-	if (hv)
-	{
-		AtomSpace *as = h->getAtomSpace();
-		if (nullptr != as)
-			for (const Handle& k: hv->getKeys())
-			{
-				Handle ak = as->add_atom(k);
-				// Read-only AtomSpaces won't allow insertion.
-				if (nullptr == ak) continue;
-				as->set_value(h, ak, hv->getValue(k));
-			}
-		else
-			h->copyValues(hv);
-	}
+	if (nullptr == hv) return false;
+
+	AtomSpace *as = h->getAtomSpace();
+	if (nullptr != as)
+		for (const Handle& k: hv->getKeys())
+		{
+			Handle ak = as->add_atom(k);
+			// Read-only AtomSpaces won't allow insertion.
+			if (nullptr == ak) continue;
+			as->set_value(h, ak, hv->getValue(k));
+		}
+	else
+		h->copyValues(hv);
+	return true;
+}
+
+void BackingStore::getAtom(const Handle& h)
+{
+	getAtomCompat(h);
+}
+
+// Storage that overrides getAtom() cannot say if the Atom is missing,
+// unless it overrides this too.
+bool BackingStore::loadAtom(const Handle& h)
+{
+	getAtom(h);
+	return true;
+}
+
+// ==========================================================
+// Default implementations of the batched fetches. These just
+// loop; backends that can do better should override these.
+
+void BackingStore::getAtoms(const HandleSeq& hs)
+{
+	for (const Handle& h : hs)
+		getAtom(h);
+}
+
+void BackingStore::loadValues(const HandleSeq& hs, const Handle& key)
+{
+	for (const Handle& h : hs)
+		loadValue(h, key);
+}
+
+void BackingStore::fetchIncomingSets(AtomSpace* as, const HandleSeq& hs)
+{
+	for (const Handle& h : hs)
+		fetchIncomingSet(as, h);
 }
 
 // ====================== END OF FILE =======================
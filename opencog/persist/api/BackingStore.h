@@ -56,6 +56,7 @@ class BackingStore
 	friend class BackingImplicator;
 	friend class BackingSatisfyingSet;
 	friend class BackingJoinCallback;
+	friend class RouterStorageNode;
 	public:
 		virtual ~BackingStore() {}
 
@@ -75,6 +76,15 @@ class BackingStore
 		 */
 		virtual void getAtom(const Handle&);
 
+		/**
+		 * Same as `getAtom()`, but return false if storage reported
+		 * that it does not hold the Atom. Storage that cannot tell
+		 * always returns true. Used for negative caching of fetches.
+		 * Storage that implements `getNode()` and `getLink()` can
+		 * implement this with `getAtomCompat()`.
+		 */
+		virtual bool loadAtom(const Handle&);
+
 		/**
 		 * Fetch the entire incoming set of the indicated Atom,
 		 * and put them into the AtomSpace. All of the values attached
@@ -99,6 +109,29 @@ class BackingStore
 		 */
 		virtual void fetchIncomingByType(AtomSpace*, const Handle&, Type) = 0;
 
+		// ------------------------------------------------------------
+		// Batched variants of the above. Backends that can fetch many
+		// Atoms in one round-trip should override these. The default
+		// implementations just loop over the single-atom versions.
+
+		/**
+		 * Fetch all of the Values on all of the indicated Atoms.
+		 * Same as calling `getAtom()` on each of them.
+		 */
+		virtual void getAtoms(const HandleSeq&);
+
+		/**
+		 * Fetch the Value located at `key` on each of the Atoms.
+		 * Same as calling `loadValue()` on each of them.
+		 */
+		virtual void loadValues(const HandleSeq&, const Handle& key);
+
+		/**
+		 * Fetch the incoming sets of all of the indicated Atoms.
+		 * Same as calling `fetchIncomingSet()` on each of them.
+		 */
+		virtual void fetchIncomingSets(AtomSpace*, const HandleSeq&);
+
 		/**
 		 * Recursively store the Atom and anything in it's outgoing set.
 		 * If the Atom is already in storage, this will store or update
@@ -202,6 +235,19 @@ class BackingStore
 		                      const Handle& metadata_key = Handle::UNDEFINED,
 		                      bool fresh=false);
 
+		/**
+		 * Extend the results of an earlier `runQuery()` with the
+		 * groundings that involve the indicated Atoms, which were added
+		 * to the AtomSpace after the query was run. This is used to keep
+		 * the cached results current, without re-running the query; it
+		 * is valid only for queries whose results can only grow as Atoms
+		 * are added. Returns false if the results could not be extended;
+		 * the query must then be re-run.
+		 */
+		virtual bool updateQuery(const Handle& query, const Handle& key,
+		                         const Handle& metadata_key,
+		                         const HandleSeq& added);
+
 		/**
 		 * Fetch *all* Atoms of the given type, and place them into the
 		 * AtomSpace. All of the associated Values are also be fetched,
@@ -262,6 +308,12 @@ class BackingStore
 		virtual void barrier(AtomSpace* = nullptr) = 0;
 
 	protected:
+		/**
+		 * The backwards-compat `getAtom()`, built on `getNode()` and
+		 * `getLink()`. Returns false if storage does not have the Atom.
+		 */
+		bool getAtomCompat(const Handle&);
+
 		/**
 		 * Return a Link with the indicated type and outset,
 		 * if it exists; else return nullptr. The returned atom
@@ -0,0 +1,261 @@
+/*
+ * opencog/persist/api/FetchCache.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/atoms/base/Atom.h>
+#include "FetchCache.h"
+
+using namespace opencog;
+
+// The most entries kept in each map. For the Values, this is the
+// number of Atoms, each with up to this many keys.
+#define MAX_STAMPS 100000
+
+// ====================================================================
+
+FetchCache::FetchCache(void) :
+	_ttl(0), _neg_ttl(0), _enabled(false),
+	_hits(0), _neg_hits(0), _misses(0), _invalidates(0)
+{
+}
+
+void FetchCache::set_timeouts(double ttl, double neg_ttl)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_ttl = std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>(ttl));
+	_neg_ttl = std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>(neg_ttl));
+	_enabled = (0.0 < ttl);
+
+	_atoms.clear();
+	_insets.clear();
+	_values.clear();
+}
+
+void FetchCache::clear(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_atoms.clear();
+	_insets.clear();
+	_values.clear();
+}
+
+// ====================================================================
+
+/// Return true if the map holds a fresh-enough stamp for the Atom.
+/// Must be called with the lock held.
+bool FetchCache::check(const StampMap& map, const Handle& h,
+                       const AtomSpace* as)
+{
+	auto it = map.find(h);
+	if (map.end() == it or it->second.as != as)
+	{
+		_misses++;
+		return false;
+	}
+
+	const Stamp& st = it->second;
+	Clock::duration ttl = st.found ? _ttl : _neg_ttl;
+	if (Clock::now() - st.when > ttl)
+	{
+		_misses++;
+		return false;
+	}
+
+	if (st.found) _hits++;
+	else _neg_hits++;
+	return true;
+}
+
+/// Drop the stamps that have timed out. Must be called with the
+/// lock held.
+void FetchCache::expire(StampMap& map, Clock::time_point now)
+{
+	Clock::duration ttl = std::max(_ttl, _neg_ttl);
+	for (auto it = map.begin(); it != map.end(); )
+	{
+		if (now - it->second.when > ttl) it = map.erase(it);
+		else it++;
+	}
+}
+
+/// Must be called with the lock held. If the map is full, the stale
+/// entries are dropped; if that does not free up at least half of it,
+/// everything is dropped, so that this is not done on every call.
+void FetchCache::stamp(StampMap& map, const Handle& h,
+                       const AtomSpace* as, bool found)
+{
+	Clock::time_point now = Clock::now();
+	if (MAX_STAMPS <= map.size() and map.end() == map.find(h))
+	{
+		expire(map, now);
+		if (MAX_STAMPS / 2 < map.size()) map.clear();
+	}
+	map[h] = {now, as, found};
+}
+
+// ====================================================================
+
+bool FetchCache::have_atom(const Handle& h, const AtomSpace* as)
+{
+	if (not _enabled) return false;
+	std::lock_guard<std::mutex> lck(_mtx);
+	return check(_atoms, h, as);
+}
+
+bool FetchCache::have_incoming(const Handle& h, const AtomSpace* as)
+{
+	if (not _enabled) return false;
+	std::lock_guard<std::mutex> lck(_mtx);
+	return check(_insets, h, as);
+}
+
+bool FetchCache::have_value(const Handle& h, const Handle& key,
+                            const AtomSpace* as)
+{
+	if (not _enabled) return false;
+	std::lock_guard<std::mutex> lck(_mtx);
+
+	// A fresh fetch of the whole atom includes all of its values.
+	auto at = _atoms.find(h);
+	if (_atoms.end() != at and at->second.as == as and
+	    Clock::now() - at->second.when <= _ttl and at->second.found)
+	{
+		_hits++;
+		return true;
+	}
+
+	auto it = _values.find(h);
+	if (_values.end() == it)
+	{
+		_misses++;
+		return false;
+	}
+	return check(it->second, key, as);
+}
+
+void FetchCache::got_atom(const Handle& h, const AtomSpace* as, bool found)
+{
+	if (not _enabled) return;
+	std::lock_guard<std::mutex> lck(_mtx);
+	stamp(_atoms, h, as, found);
+}
+
+void FetchCache::got_incoming(const Handle& h, const AtomSpace* as,
+                              bool found)
+{
+	if (not _enabled) return;
+	std::lock_guard<std::mutex> lck(_mtx);
+	stamp(_insets, h, as, found);
+}
+
+void FetchCache::got_value(const Handle& h, const Handle& key,
+                           const AtomSpace* as, bool found)
+{
+	if (not _enabled) return;
+	std::lock_guard<std::mutex> lck(_mtx);
+
+	// Same as stamp(), but for the map of maps.
+	if (MAX_STAMPS <= _values.size() and _values.end() == _values.find(h))
+	{
+		Clock::time_point now = Clock::now();
+		for (auto it = _values.begin(); it != _values.end(); )
+		{
+			expire(it->second, now);
+			if (it->second.empty()) it = _values.erase(it);
+			else it++;
+		}
+		if (MAX_STAMPS / 2 < _values.size()) _values.clear();
+	}
+	stamp(_values[h], key, as, found);
+}
+
+// ====================================================================
+
+void FetchCache::invalidate(const Handle& h)
+{
+	if (not _enabled) return;
+	std::lock_guard<std::mutex> lck(_mtx);
+	_invalidates++;
+	_atoms.erase(h);
+	_insets.erase(h);
+	_values.erase(h);
+
+	// Storing or removing a Link changes the incoming sets of
+	// everything that it points at.
+	if (not h->is_link()) return;
+	for (const Handle& ho : h->getOutgoingSet())
+		_insets.erase(ho);
+}
+
+void FetchCache::invalidate(const Handle& h, const Handle& key)
+{
+	if (not _enabled) return;
+	std::lock_guard<std::mutex> lck(_mtx);
+	_invalidates++;
+	_atoms.erase(h);
+	auto it = _values.find(h);
+	if (_values.end() != it) it->second.erase(key);
+}
+
+// ====================================================================
+
+std::string FetchCache::stats(void) const
+{
+	if (not _enabled) return "";
+
+	size_t nvals = 0;
+	size_t natoms, ninsets;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		natoms = _atoms.size();
+		ninsets = _insets.size();
+		for (const auto& pr : _values) nvals += pr.second.size();
+	}
+
+	double ttl = std::chrono::duration<double>(_ttl).count();
+	double neg_ttl = std::chrono::duration<double>(_neg_ttl).count();
+
+	size_t hits = _hits;
+	size_t neg_hits = _neg_hits;
+	size_t misses = _misses;
+	size_t invalidates = _invalidates;
+	size_t total = hits + neg_hits + misses;
+	double rate = (0 < total) ? ((double) (hits + neg_hits)) / total : 0.0;
+
+	std::string rs = "Fetch cache: timeout=";
+	rs += std::to_string(ttl) + " secs negative timeout=";
+	rs += std::to_string(neg_ttl) + " secs\n";
+	rs += "Fetch cache entries: atoms=" + std::to_string(natoms);
+	rs += " incoming sets=" + std::to_string(ninsets);
+	rs += " values=" + std::to_string(nvals) + "\n";
+	rs += "Fetch cache hits=" + std::to_string(hits);
+	rs += " negative hits=" + std::to_string(neg_hits);
+	rs += " misses=" + std::to_string(misses);
+	rs += " hit rate=" + std::to_string(rate) + "\n";
+	rs += "Fetch cache invalidations=" + std::to_string(invalidates) + "\n";
+	return rs;
+}
+
+// ====================== END OF FILE =======================
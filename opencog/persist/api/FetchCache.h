@@ -0,0 +1,124 @@
+/*
+ * opencog/persist/api/FetchCache.h
+ *
+ * Read-through cache of recent fetches from a StorageNode.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_FETCH_CACHE_H
+#define _OPENCOG_FETCH_CACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_persist
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * Remember when an Atom, an incoming set or a single Value was last
+ * fetched from storage, so that repeated fetches of the same data,
+ * made in quick succession, can be answered from the AtomSpace,
+ * without another round-trip to the storage server.
+ *
+ * Two time-outs are maintained: one for fetches that found something,
+ * and one (usually shorter) for fetches that found nothing. The latter
+ * provides negative caching: if storage reported that it does not have
+ * some Atom, then asking for it again, right away, is pointless.
+ *
+ * Entries are invalidated whenever the corresponding Atom or Value is
+ * stored or removed through the same StorageNode. Changes made to the
+ * storage by other clients are not seen until the time-out expires;
+ * this is the price of caching. The cache is disabled by default.
+ *
+ * The number of entries is bounded. When full, the expired entries are
+ * dropped; if most of the entries are still fresh, all are dropped.
+ */
+class FetchCache
+{
+	typedef std::chrono::steady_clock Clock;
+	struct Stamp
+	{
+		Clock::time_point when;
+		const AtomSpace* as;
+		bool found;
+	};
+	typedef std::unordered_map<Handle, Stamp> StampMap;
+
+	mutable std::mutex _mtx;
+	Clock::duration _ttl;
+	Clock::duration _neg_ttl;
+	std::atomic<bool> _enabled;
+
+	StampMap _atoms;
+	StampMap _insets;
+	std::unordered_map<Handle, StampMap> _values;
+
+	std::atomic<size_t> _hits;
+	std::atomic<size_t> _neg_hits;
+	std::atomic<size_t> _misses;
+	std::atomic<size_t> _invalidates;
+
+	bool check(const StampMap&, const Handle&, const AtomSpace*);
+	void stamp(StampMap&, const Handle&, const AtomSpace*, bool);
+	void expire(StampMap&, Clock::time_point);
+
+public:
+	FetchCache(void);
+
+	/// Set the time-outs, in seconds. A positive time-out of zero
+	/// disables the cache.
+	void set_timeouts(double ttl, double neg_ttl);
+	bool enabled(void) const { return _enabled; }
+
+	/// Return true if the indicated fetch was performed recently
+	/// enough that it does not need to be done again.
+	bool have_atom(const Handle&, const AtomSpace*);
+	bool have_incoming(const Handle&, const AtomSpace*);
+	bool have_value(const Handle&, const Handle&, const AtomSpace*);
+
+	/// Record that the indicated fetch was just performed. The flag
+	/// indicates whether anything was found.
+	void got_atom(const Handle&, const AtomSpace*, bool);
+	void got_incoming(const Handle&, const AtomSpace*, bool);
+	void got_value(const Handle&, const Handle&, const AtomSpace*, bool);
+
+	/// Forget everything known about the Atom, including the
+	/// incoming sets of the Atoms in its outgoing set.
+	void invalidate(const Handle&);
+	void invalidate(const Handle&, const Handle&);
+	void clear(void);
+
+	std::string stats(void) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FETCH_CACHE_H
@@ -59,6 +59,12 @@ void PersistSCM::init(void)
 	             &PersistSCM::sn_fetch_incoming_set, "persist", false);
 	define_scheme_primitive("sn-fetch-incoming-by-type",
 	             &PersistSCM::sn_fetch_incoming_by_type, "persist", false);
+	define_scheme_primitive("sn-fetch-atoms",
+	             &PersistSCM::sn_fetch_atoms, "persist", false);
+	define_scheme_primitive("sn-fetch-values",
+	             &PersistSCM::sn_fetch_values, "persist", false);
+	define_scheme_primitive("sn-fetch-incoming-sets",
+	             &PersistSCM::sn_fetch_incoming_sets, "persist", false);
 	define_scheme_primitive("sn-fetch-query-2args",
 	             &PersistSCM::sn_fetch_query2, "persist", false);
 	define_scheme_primitive("sn-fetch-query-4args",
@@ -73,6 +79,8 @@ void PersistSCM::init(void)
 	             &PersistSCM::sn_load_atomspace, "persist", false);
 	define_scheme_primitive("sn-store-atomspace",
 	             &PersistSCM::sn_store_atomspace, "persist", false);
+	define_scheme_primitive("sn-store-changes",
+	             &PersistSCM::sn_store_changes, "persist", false);
 	define_scheme_primitive("sn-load-frames",
 	             &PersistSCM::sn_load_frames, "persist", false);
 	define_scheme_primitive("sn-store-frames",
@@ -85,6 +93,10 @@ void PersistSCM::init(void)
 	             &PersistSCM::sn_barrier, "persist", false);
 	define_scheme_primitive("sn-monitor",
 	             &PersistSCM::sn_monitor, "persist", false);
+	define_scheme_primitive("sn-set-fetch-cache",
+	             &PersistSCM::sn_set_fetch_cache, "persist", false);
+	define_scheme_primitive("sn-set-lazy-values",
+	             &PersistSCM::sn_set_lazy_values, "persist", false);
 
 	define_scheme_primitive("dflt-fetch-atom",
 	             &PersistSCM::dflt_fetch_atom, this, "persist", false);
@@ -94,6 +106,12 @@ void PersistSCM::init(void)
 	             &PersistSCM::dflt_fetch_incoming_set, this, "persist", false);
 	define_scheme_primitive("dflt-fetch-incoming-by-type",
 	             &PersistSCM::dflt_fetch_incoming_by_type, this, "persist", false);
+	define_scheme_primitive("dflt-fetch-atoms",
+	             &PersistSCM::dflt_fetch_atoms, this, "persist", false);
+	define_scheme_primitive("dflt-fetch-values",
+	             &PersistSCM::dflt_fetch_values, this, "persist", false);
+	define_scheme_primitive("dflt-fetch-incoming-sets",
+	             &PersistSCM::dflt_fetch_incoming_sets, this, "persist", false);
 	define_scheme_primitive("dflt-fetch-query-2args",
 	             &PersistSCM::dflt_fetch_query2, this, "persist", false);
 	define_scheme_primitive("dflt-fetch-query-4args",
@@ -108,6 +126,8 @@ void PersistSCM::init(void)
 	             &PersistSCM::dflt_load_atomspace, this, "persist", false);
 	define_scheme_primitive("dflt-store-atomspace",
 	             &PersistSCM::dflt_store_atomspace, this, "persist", false);
+	define_scheme_primitive("dflt-store-changes",
+	             &PersistSCM::dflt_store_changes, this, "persist", false);
 	define_scheme_primitive("dflt-load-frames",
 	             &PersistSCM::dflt_load_frames, this, "persist", false);
 	define_scheme_primitive("dflt-store-frames",
@@ -120,6 +140,10 @@ void PersistSCM::init(void)
 	             &PersistSCM::dflt_barrier, this, "persist", false);
 	define_scheme_primitive("dflt-monitor",
 	             &PersistSCM::dflt_monitor, this, "persist", false);
+	define_scheme_primitive("dflt-set-fetch-cache",
+	             &PersistSCM::dflt_set_fetch_cache, this, "persist", false);
+	define_scheme_primitive("dflt-set-lazy-values",
+	             &PersistSCM::dflt_set_lazy_values, this, "persist", false);
 }
 
 // =====================================================================
@@ -215,6 +239,27 @@ Handle PersistSCM::sn_fetch_incoming_by_type(Handle h, Type t, Handle hsn)
 	return stnp->fetch_incoming_by_type(h, t, as);
 }
 
+HandleSeq PersistSCM::sn_fetch_atoms(HandleSeq hs, Handle hsn)
+{
+	GET_STNP;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("fetch-atoms");
+	return stnp->fetch_atoms(hs, as);
+}
+
+HandleSeq PersistSCM::sn_fetch_values(HandleSeq hs, Handle key, Handle hsn)
+{
+	GET_STNP;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("fetch-values");
+	return stnp->fetch_values(hs, key, as);
+}
+
+HandleSeq PersistSCM::sn_fetch_incoming_sets(HandleSeq hs, Handle hsn)
+{
+	GET_STNP;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("fetch-incoming-sets");
+	return stnp->fetch_incoming_sets(hs, as);
+}
+
 Handle PersistSCM::sn_fetch_query2(Handle query, Handle key, Handle hsn)
 {
 	GET_STNP;
@@ -268,6 +313,13 @@ void PersistSCM::sn_store_atomspace(Handle hsn)
 	stnp->store_atomspace(as);
 }
 
+size_t PersistSCM::sn_store_changes(Handle hsn)
+{
+	GET_STNP;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("store-changes");
+	return stnp->store_changes(as);
+}
+
 HandleSeq PersistSCM::sn_load_frames(Handle hsn)
 {
 	GET_STNP;
@@ -304,7 +356,20 @@ void PersistSCM::sn_barrier(Handle hsn)
 std::string PersistSCM::sn_monitor(Handle hsn)
 {
 	GET_STNP;
-	return stnp->monitor();
+	return stnp->monitor() + stnp->monitor_fetch_cache()
+		+ stnp->monitor_lazy_values();
+}
+
+void PersistSCM::sn_set_fetch_cache(double ttl, double neg_ttl, Handle hsn)
+{
+	GET_STNP;
+	stnp->set_fetch_cache(ttl, neg_ttl);
+}
+
+void PersistSCM::sn_set_lazy_values(bool lazy, double budget, Handle hsn)
+{
+	GET_STNP;
+	stnp->set_lazy_values(lazy, (size_t) budget);
 }
 
 // =====================================================================
@@ -342,6 +407,27 @@ Handle PersistSCM::dflt_fetch_incoming_by_type(Handle h, Type t)
 	return _sn->fetch_incoming_by_type(h, t, as);
 }
 
+HandleSeq PersistSCM::dflt_fetch_atoms(HandleSeq hs)
+{
+	CHECK;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("fetch-atoms");
+	return _sn->fetch_atoms(hs, as);
+}
+
+HandleSeq PersistSCM::dflt_fetch_values(HandleSeq hs, Handle key)
+{
+	CHECK;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("fetch-values");
+	return _sn->fetch_values(hs, key, as);
+}
+
+HandleSeq PersistSCM::dflt_fetch_incoming_sets(HandleSeq hs)
+{
+	CHECK;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("fetch-incoming-sets");
+	return _sn->fetch_incoming_sets(hs, as);
+}
+
 Handle PersistSCM::dflt_fetch_query2(Handle query, Handle key)
 {
 	CHECK;
@@ -395,6 +481,13 @@ void PersistSCM::dflt_store_atomspace(void)
 	_sn->store_atomspace(as);
 }
 
+size_t PersistSCM::dflt_store_changes(void)
+{
+	CHECK;
+	AtomSpace* as = SchemeSmob::ss_get_env_as("store-changes");
+	return _sn->store_changes(as);
+}
+
 HandleSeq PersistSCM::dflt_load_frames(void)
 {
 	CHECK;
@@ -432,7 +525,20 @@ std::string PersistSCM::dflt_monitor(void)
 {
 	if (nullptr == _sn)
 		return "No open connection to storage!";
-	return _sn->monitor();
+	return _sn->monitor() + _sn->monitor_fetch_cache()
+		+ _sn->monitor_lazy_values();
+}
+
+void PersistSCM::dflt_set_fetch_cache(double ttl, double neg_ttl)
+{
+	CHECK;
+	_sn->set_fetch_cache(ttl, neg_ttl);
+}
+
+void PersistSCM::dflt_set_lazy_values(bool lazy, double budget)
+{
+	CHECK;
+	_sn->set_lazy_values(lazy, (size_t) budget);
 }
 
 Handle PersistSCM::current_storage(void)
@@ -45,6 +45,9 @@ private:
 	static Handle sn_fetch_value(Handle, Handle, Handle);
 	static Handle sn_fetch_incoming_set(Handle, Handle);
 	static Handle sn_fetch_incoming_by_type(Handle, Type, Handle);
+	static HandleSeq sn_fetch_atoms(HandleSeq, Handle);
+	static HandleSeq sn_fetch_values(HandleSeq, Handle, Handle);
+	static HandleSeq sn_fetch_incoming_sets(HandleSeq, Handle);
 	static Handle sn_fetch_query2(Handle, Handle, Handle);
 	static Handle sn_fetch_query4(Handle, Handle, Handle, bool, Handle);
 	static Handle sn_store_atom(Handle, Handle);
@@ -52,12 +55,15 @@ private:
 	static void sn_load_type(Type, Handle);
 	static void sn_load_atomspace(Handle);
 	static void sn_store_atomspace(Handle);
+	static size_t sn_store_changes(Handle);
 	static HandleSeq sn_load_frames(Handle);
 	static void sn_store_frames(Handle, Handle);
 	static bool sn_delete(Handle, Handle);
 	static bool sn_delete_recursive(Handle, Handle);
 	static void sn_barrier(Handle);
 	static std::string sn_monitor(Handle);
+	static void sn_set_fetch_cache(double, double, Handle);
+	static void sn_set_lazy_values(bool, double, Handle);
 
 	void open(Handle);
 	void close(Handle);
@@ -71,6 +77,9 @@ private:
 	Handle dflt_fetch_value(Handle, Handle);
 	Handle dflt_fetch_incoming_set(Handle);
 	Handle dflt_fetch_incoming_by_type(Handle, Type);
+	HandleSeq dflt_fetch_atoms(HandleSeq);
+	HandleSeq dflt_fetch_values(HandleSeq, Handle);
+	HandleSeq dflt_fetch_incoming_sets(HandleSeq);
 	Handle dflt_fetch_query2(Handle, Handle);
 	Handle dflt_fetch_query4(Handle, Handle, Handle, bool);
 	Handle dflt_store_atom(Handle);
@@ -78,12 +87,15 @@ private:
 	void dflt_load_type(Type);
 	void dflt_load_atomspace(void);
 	void dflt_store_atomspace(void);
+	size_t dflt_store_changes(void);
 	HandleSeq dflt_load_frames(void);
 	void dflt_store_frames(Handle);
 	bool dflt_delete(Handle);
 	bool dflt_delete_recursive(Handle);
 	void dflt_barrier(void);
 	std::string dflt_monitor(void);
+	void dflt_set_fetch_cache(double, double);
+	void dflt_set_lazy_values(bool, double);
 	Handle current_storage(void);
 
 public:
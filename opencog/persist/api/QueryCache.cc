@@ -0,0 +1,305 @@
+/*
+ * opencog/persist/api/QueryCache.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atoms/pattern/PatternLink.h>
+#include <opencog/query/DeltaSearch.h>
+#include "QueryCache.h"
+
+using namespace opencog;
+
+// If more than this many Atoms are added between two fetches, then
+// just re-run the query; searching from each of them is not cheaper.
+#define MAX_ADDED 10000
+
+// ====================================================================
+
+QueryCache::~QueryCache()
+{
+	clear();
+}
+
+void QueryCache::clear(void)
+{
+	std::lock_guard<std::mutex> slck(_sig_mtx);
+	std::map<AtomSpace*, SpacePtr> spaces;
+	{
+		std::unique_lock<std::shared_mutex> lck(_mtx);
+		spaces.swap(_spaces);
+	}
+	for (auto& pr : spaces)
+		disconnect(pr.first, *pr.second);
+}
+
+/// Disconnect from the AtomSpace signals, if the AtomSpace still
+/// exists. The signal handlers take the Space lock, while the signal
+/// holds its own lock; thus, no Space lock may be held here.
+void QueryCache::disconnect(AtomSpace* as, Space& spc)
+{
+	ValuePtr keep(spc.as.lock());
+	if (nullptr == keep) return;
+	as->atomAddedSignal().disconnect(spc.add_sig);
+	as->atomRemovedSignal().disconnect(spc.rem_sig);
+}
+
+QueryCache::SpacePtr QueryCache::find(AtomSpace* as)
+{
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	auto it = _spaces.find(as);
+	if (_spaces.end() == it) return nullptr;
+	return it->second;
+}
+
+// ====================================================================
+// The watch index. The Space lock must be held for all of these.
+
+void QueryCache::Space::index(Watch& w)
+{
+	if (w.stale) return;
+	if (not w.incremental)
+	{
+		any.insert(&w);
+		return;
+	}
+	for (Type t : w.types)
+		by_type[t].insert(&w);
+}
+
+void QueryCache::Space::unindex(Watch& w)
+{
+	if (not w.incremental)
+	{
+		any.erase(&w);
+		return;
+	}
+	for (Type t : w.types)
+	{
+		auto it = by_type.find(t);
+		if (by_type.end() == it) continue;
+		it->second.erase(&w);
+		if (it->second.empty()) by_type.erase(it);
+	}
+}
+
+/// Stale watches are not looked at again, until they are re-watched.
+void QueryCache::Space::make_stale(Watch& w)
+{
+	unindex(w);
+	w.stale = true;
+	w.added.clear();
+}
+
+void QueryCache::Space::erase(std::map<QueryKey, Watch>::iterator it)
+{
+	unindex(it->second);
+	for (const Handle& h : {it->first.first, it->first.second})
+	{
+		auto pit = pinned.find(h);
+		if (0 == --pit->second) pinned.erase(pit);
+	}
+	watches.erase(it);
+}
+
+// ====================================================================
+
+/// Decide whether the results of the query can be maintained by
+/// searching from the added Atoms only, and, if so, which Atom types
+/// can ground a clause.
+void QueryCache::analyze(const Handle& query, Watch& w)
+{
+	w.incremental = delta_searchable(PatternLinkCast(query), w.types);
+}
+
+void QueryCache::watch(const Handle& query, const Handle& key)
+{
+	AtomSpace* as = query->getAtomSpace();
+	if (nullptr == as) return;
+
+	// AtomSpaces that are not held by a shared pointer can go away
+	// without notice; those cannot be watched safely.
+	std::weak_ptr<Value> was(as->weak_from_this());
+	if (was.expired()) return;
+
+	Watch w;
+	analyze(query, w);
+	w.stale = false;
+
+	SpacePtr spc;
+	{
+		std::lock_guard<std::mutex> slck(_sig_mtx);
+		spc = find(as);
+
+		// A new AtomSpace might have been allocated at the same
+		// address as an old one.
+		if (spc and spc->as.expired())
+		{
+			std::unique_lock<std::shared_mutex> lck(_mtx);
+			_spaces.erase(as);
+			spc = nullptr;
+		}
+
+		if (nullptr == spc)
+		{
+			// The handlers hold the Space, so that an add does not
+			// need to look it up, and so that it stays valid until
+			// they are disconnected.
+			spc = std::make_shared<Space>();
+			spc->as = was;
+			spc->add_sig = as->atomAddedSignal().connect(
+				[this, spc](const Handle& h) { added(*spc, h); });
+			spc->rem_sig = as->atomRemovedSignal().connect(
+				[this, spc](const Handle& h) { removed(*spc, h); });
+
+			std::unique_lock<std::shared_mutex> lck(_mtx);
+			_spaces.emplace(as, spc);
+		}
+	}
+
+	std::lock_guard<std::mutex> lck(spc->mtx);
+	auto it = spc->watches.find({query, key});
+	if (spc->watches.end() != it)
+		spc->unindex(it->second);
+	else
+	{
+		it = spc->watches.emplace(QueryKey(query, key), Watch()).first;
+		spc->pinned[query]++;
+		spc->pinned[key]++;
+	}
+	it->second = std::move(w);
+	spc->index(it->second);
+}
+
+void QueryCache::unwatch(const Handle& query, const Handle& key)
+{
+	SpacePtr spc(find(query->getAtomSpace()));
+	if (nullptr == spc) return;
+
+	std::lock_guard<std::mutex> lck(spc->mtx);
+	auto it = spc->watches.find({query, key});
+	if (spc->watches.end() != it) spc->erase(it);
+}
+
+QueryCache::State QueryCache::take(const Handle& query, const Handle& key,
+                                   HandleSeq& added)
+{
+	SpacePtr spc(find(query->getAtomSpace()));
+	if (nullptr == spc) return UNWATCHED;
+
+	std::lock_guard<std::mutex> lck(spc->mtx);
+	auto wit = spc->watches.find({query, key});
+	if (spc->watches.end() == wit) return UNWATCHED;
+
+	// The results were thrown away; they will have to be recomputed.
+	if (nullptr == query->getValue(key))
+	{
+		spc->erase(wit);
+		return UNWATCHED;
+	}
+
+	Watch& w = wit->second;
+	if (w.stale) return STALE;
+
+	added.swap(w.added);
+	w.added.clear();
+	return CURRENT;
+}
+
+// ====================================================================
+
+QueryCache::Inserting::Inserting(QueryCache& qc) : _qc(qc)
+{
+	std::lock_guard<std::mutex> lck(_qc._ins_mtx);
+	_qc._inserting.insert(std::this_thread::get_id());
+	_qc._ninserting++;
+}
+
+QueryCache::Inserting::~Inserting()
+{
+	std::lock_guard<std::mutex> lck(_qc._ins_mtx);
+	_qc._inserting.erase(_qc._inserting.find(std::this_thread::get_id()));
+	_qc._ninserting--;
+}
+
+/// Return true if the current thread is inserting results. This is
+/// checked on every add; the lock is taken only while some thread is
+/// inserting.
+bool QueryCache::inserting(void)
+{
+	if (0 == _ninserting) return false;
+	std::lock_guard<std::mutex> lck(_ins_mtx);
+	return 0 < _inserting.count(std::this_thread::get_id());
+}
+
+// ====================================================================
+// Signal handlers. These are called from within AtomSpace::add() and
+// AtomSpace::extract(); they must not touch the AtomSpace.
+
+void QueryCache::added(Space& spc, const Handle& h)
+{
+	if (inserting()) return;
+
+	std::lock_guard<std::mutex> lck(spc.mtx);
+
+	// Any change at all makes these stale.
+	for (Watch* w : spc.any) w->stale = true;
+	spc.any.clear();
+
+	auto it = spc.by_type.find(h->get_type());
+	if (spc.by_type.end() == it) return;
+
+	std::vector<Watch*> full;
+	for (Watch* w : it->second)
+	{
+		w->added.push_back(h);
+		if (MAX_ADDED < w->added.size()) full.push_back(w);
+	}
+
+	// make_stale() changes the index; do it after the loop.
+	for (Watch* w : full) spc.make_stale(*w);
+}
+
+void QueryCache::removed(Space& spc, const Handle& h)
+{
+	std::lock_guard<std::mutex> lck(spc.mtx);
+
+	for (Watch* w : spc.any) w->stale = true;
+	spc.any.clear();
+
+	auto it = spc.by_type.find(h->get_type());
+	if (spc.by_type.end() != it)
+	{
+		std::vector<Watch*> hit(it->second.begin(), it->second.end());
+		for (Watch* w : hit) spc.make_stale(*w);
+	}
+
+	// Forget the watches on the query or the key that was removed.
+	if (0 == spc.pinned.count(h)) return;
+	for (auto wit = spc.watches.begin(); wit != spc.watches.end(); )
+	{
+		auto next = std::next(wit);
+		if (wit->first.first == h or wit->first.second == h)
+			spc.erase(wit);
+		wit = next;
+	}
+}
+
+// ====================================================================
@@ -0,0 +1,171 @@
+/*
+ * opencog/persist/api/QueryCache.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_QUERY_CACHE_H
+#define _OPENCOG_QUERY_CACHE_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_persist
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * Keep track of AtomSpace changes that affect the cached results of
+ * `fetch_query()`, so that repeated fetches of the same query do not
+ * need to re-run the whole query.
+ *
+ * Once a query has been run, and its results placed on a key, the
+ * query is watched: the AtomSpace add and remove signals are used to
+ * record the Atoms that might change the results. For the simplest,
+ * and most common queries (single-component MeetLinks and QueryLinks,
+ * without evaluatable, absent or choice clauses), the results can only
+ * grow when Atoms are added, and only Atoms having the type of one of
+ * the clauses can add new results. These Atoms are remembered, so
+ * that the next fetch can search for just the new groundings. The
+ * removal of such an Atom, or any change at all, for the other kinds
+ * of queries, marks the cached results as stale; the next fetch then
+ * re-runs the query.
+ *
+ * The signal handlers only record; they never run a search, as that
+ * would add Atoms to the AtomSpace from within the signal. Atoms that
+ * the StorageNode itself copies into the AtomSpace, while bringing the
+ * results up to date, are not recorded: they are results, not changes.
+ *
+ * Each AtomSpace has its own lock, and its watches are indexed by the
+ * clause types, so that an add looks only at the watches that the new
+ * Atom might affect. A watch holds its query and key Atoms; it is
+ * dropped when either of these is removed from the AtomSpace, when
+ * the results are removed from the query, or by `unwatch()`.
+ */
+class QueryCache
+{
+public:
+	enum State
+	{
+		UNWATCHED,  // Not being watched; run the query as usual.
+		CURRENT,    // Up to date, after adding the new groundings.
+		STALE,      // Must be re-run from scratch.
+	};
+
+private:
+	struct Watch
+	{
+		bool incremental;
+		bool stale;
+		TypeSet types;       // Empty means "all types".
+		HandleSeq added;
+	};
+
+	typedef std::pair<Handle, Handle> QueryKey;
+	struct Space
+	{
+		std::weak_ptr<Value> as;
+		int add_sig;
+		int rem_sig;
+
+		// Guards everything below.
+		std::mutex mtx;
+		std::map<QueryKey, Watch> watches;
+
+		// The watches that are not stale, by the types of the Atoms
+		// that can change their results. The non-incremental ones are
+		// changed by any Atom at all.
+		std::unordered_map<Type, std::set<Watch*>> by_type;
+		std::set<Watch*> any;
+
+		// The number of watches holding each query and key Atom.
+		std::unordered_map<Handle, size_t> pinned;
+
+		void index(Watch&);
+		void unindex(Watch&);
+		void make_stale(Watch&);
+		void erase(std::map<QueryKey, Watch>::iterator);
+	};
+	typedef std::shared_ptr<Space> SpacePtr;
+
+	// Only the holder of `_sig_mtx` creates or erases Spaces, and
+	// connects or disconnects signals. `_mtx` guards `_spaces` only.
+	std::mutex _sig_mtx;
+	std::shared_mutex _mtx;
+	std::map<AtomSpace*, SpacePtr> _spaces;
+
+	std::atomic<size_t> _ninserting;
+	std::mutex _ins_mtx;
+	std::multiset<std::thread::id> _inserting;
+
+	SpacePtr find(AtomSpace*);
+	bool inserting(void);
+	void added(Space&, const Handle&);
+	void removed(Space&, const Handle&);
+	static void analyze(const Handle&, Watch&);
+	void disconnect(AtomSpace*, Space&);
+
+public:
+	QueryCache(void) : _ninserting(0) {}
+	~QueryCache();
+
+	/// Start watching the results of `query`, held on `key`. The
+	/// query must be in the AtomSpace. Watching again resets the
+	/// record of changes.
+	void watch(const Handle& query, const Handle& key);
+
+	/// Return the state of the cached results of `query`. If they are
+	/// CURRENT, then `added` is filled with the Atoms that might
+	/// ground additional results; these must be searched for.
+	State take(const Handle& query, const Handle& key, HandleSeq& added);
+
+	/// Stop watching the results of `query`, held on `key`.
+	void unwatch(const Handle& query, const Handle& key);
+
+	/// Stop watching everything.
+	void clear(void);
+
+	/// While one of these exists, the Atoms that the current thread
+	/// adds to the AtomSpace are not recorded.
+	class Inserting
+	{
+		QueryCache& _qc;
+	public:
+		Inserting(QueryCache&);
+		~Inserting();
+	};
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_QUERY_CACHE_H
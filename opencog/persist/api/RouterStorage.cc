@@ -0,0 +1,654 @@
+/*
+ * opencog/persist/api/RouterStorage.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/persist/storage/storage_types.h>
+#include "RouterStorage.h"
+
+using namespace opencog;
+
+// A read is hedged (sent to the next replica) if none of the replicas
+// asked so far has answered after this many times the average latency
+// of the first one ...
+#define HEDGE_FACTOR 3.0
+
+// ... but not sooner than this many seconds.
+#define MIN_HEDGE_SECS 0.002
+
+// Writers block, if this many writes are waiting for a replica.
+#define MAX_QUEUE 10000
+
+// The number of reads that each replica works on at the same time.
+// More than this are queued.
+#define NUM_READERS 4
+
+typedef std::chrono::steady_clock Clock;
+
+// ====================================================================
+// Replicas
+
+RouterStorageNode::Replica::Replica(const Handle& h, BackingStore* bs) :
+	node(h), store(bs),
+	inflight(0), latency(0.0), reads(0), hedges(0), failures(0),
+	busy(false), stop(false)
+{
+	writer = std::thread(&Replica::write_loop, this);
+	for (size_t i = 0; i < NUM_READERS; i++)
+		readers.emplace_back(&Replica::read_loop, this);
+}
+
+/// Perform the queued writes, in order.
+void RouterStorageNode::Replica::write_loop(void)
+{
+	std::unique_lock<std::mutex> lck(mtx);
+	while (true)
+	{
+		cv.wait(lck, [this] { return stop or not todo.empty(); });
+		if (todo.empty()) return;
+
+		std::function<void(void)> job(std::move(todo.front()));
+		todo.pop_front();
+		busy = true;
+		cv.notify_all();
+		lck.unlock();
+
+		std::string err;
+		try { job(); }
+		catch (const std::exception& ex) { err = ex.what(); }
+
+		lck.lock();
+		if (error.empty()) error = err;
+		busy = false;
+		cv.notify_all();
+	}
+}
+
+/// Perform the queued reads. The jobs catch their own exceptions.
+void RouterStorageNode::Replica::read_loop(void)
+{
+	std::unique_lock<std::mutex> lck(mtx);
+	while (true)
+	{
+		rcv.wait(lck, [this] { return stop or not rtodo.empty(); });
+		if (rtodo.empty()) return;
+
+		std::function<void(void)> job(std::move(rtodo.front()));
+		rtodo.pop_front();
+		lck.unlock();
+		job();
+		lck.lock();
+	}
+}
+
+void RouterStorageNode::Replica::post_read(std::function<void(void)> job)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	rtodo.emplace_back(std::move(job));
+	rcv.notify_one();
+}
+
+void RouterStorageNode::Replica::post(std::function<void(void)> job)
+{
+	std::unique_lock<std::mutex> lck(mtx);
+	cv.wait(lck, [this] { return todo.size() < MAX_QUEUE; });
+	todo.emplace_back(std::move(job));
+	cv.notify_all();
+}
+
+/// Wait until all queued writes have been performed.
+void RouterStorageNode::Replica::drain(void)
+{
+	std::unique_lock<std::mutex> lck(mtx);
+	cv.wait(lck, [this] { return todo.empty() and not busy; });
+}
+
+/// The expected time to answer a read, in arbitrary units.
+/// Replicas that have never been used go first.
+double RouterStorageNode::Replica::score(void) const
+{
+	return (inflight + 1) * latency.load();
+}
+
+// ====================================================================
+
+RouterStorageNode::RouterStorageNode(Type t, const std::string& uri) :
+	StorageNode(t, uri), _rotor(0), _background(0)
+{
+}
+
+RouterStorageNode::~RouterStorageNode()
+{
+	shut();
+}
+
+/// Fetch the replicas from the parts list, and open them.
+void RouterStorageNode::open(void)
+{
+	if (0 < _replicas.size())
+		throw IOException(TRACE_INFO,
+			"RouterStorageNode %s is already open!", get_name().c_str());
+
+	Handle key(createNode(PREDICATE_NODE, "*-router-parts-*"));
+	ValuePtr vp(getValue(key));
+	if (nullptr == vp)
+		throw IOException(TRACE_INFO,
+			"RouterStorageNode %s has no parts!", get_name().c_str());
+
+	HandleSeq parts;
+	if (vp->is_type(LINK_VALUE))
+	{
+		for (const ValuePtr& v : LinkValueCast(vp)->value())
+			parts.push_back(HandleCast(v));
+	}
+	else if (vp->is_link())
+		parts = HandleCast(vp)->getOutgoingSet();
+
+	ReplicaSeq reps;
+	for (const Handle& h : parts)
+	{
+		StorageNodePtr snp(StorageNodeCast(h));
+		if (nullptr == snp or snp.get() == this)
+			throw IOException(TRACE_INFO,
+				"RouterStorageNode %s: not a StorageNode: %s",
+				get_name().c_str(),
+				(h ? h->to_short_string().c_str() : "null"));
+
+		if (not snp->connected()) snp->open();
+		reps.emplace_back(new Replica(h, backing_store(snp.get())));
+	}
+	if (0 == reps.size())
+		throw IOException(TRACE_INFO,
+			"RouterStorageNode %s has no parts!", get_name().c_str());
+
+	_replicas.swap(reps);
+}
+
+/// Stop the writers and the background reads.
+void RouterStorageNode::shut(void)
+{
+	wait_background();
+	for (auto& r : _replicas)
+	{
+		{
+			std::lock_guard<std::mutex> lck(r->mtx);
+			r->stop = true;
+		}
+		r->cv.notify_all();
+		r->rcv.notify_all();
+		r->writer.join();
+		for (std::thread& t : r->readers) t.join();
+	}
+	_replicas.clear();
+}
+
+void RouterStorageNode::close(void)
+{
+	if (0 == _replicas.size()) return;
+	barrier();
+
+	HandleSeq parts;
+	for (auto& r : _replicas) parts.push_back(r->node);
+	shut();
+
+	for (const Handle& h : parts)
+		StorageNodeCast(h)->close();
+}
+
+bool RouterStorageNode::connected(void)
+{
+	for (auto& r : _replicas)
+		if (StorageNodeCast(r->node)->connected()) return true;
+	return false;
+}
+
+void RouterStorageNode::create(void)
+{
+	for (auto& r : _replicas)
+	{
+		r->drain();
+		StorageNodeCast(r->node)->create();
+	}
+}
+
+void RouterStorageNode::destroy(void)
+{
+	for (auto& r : _replicas)
+	{
+		r->drain();
+		StorageNodeCast(r->node)->destroy();
+	}
+}
+
+void RouterStorageNode::erase(void)
+{
+	for (auto& r : _replicas)
+	{
+		r->drain();
+		StorageNodeCast(r->node)->erase();
+	}
+}
+
+std::string RouterStorageNode::monitor(void)
+{
+	std::string rs = "Router Storage Node " + get_name() + "\n";
+	for (auto& r : _replicas)
+	{
+		size_t qlen;
+		{
+			std::lock_guard<std::mutex> lck(r->mtx);
+			qlen = r->todo.size();
+		}
+		rs += "  " + r->node->to_short_string() + "\n";
+		rs += "    reads=" + std::to_string(r->reads.load()) +
+			" hedges=" + std::to_string(r->hedges.load()) +
+			" failures=" + std::to_string(r->failures.load()) +
+			" in-flight=" + std::to_string(r->inflight.load()) +
+			" latency=" + std::to_string(1000.0 * r->latency) + " msecs" +
+			" write-queue=" + std::to_string(qlen) + "\n";
+	}
+	return rs;
+}
+
+// ====================================================================
+// Routing
+
+void RouterStorageNode::wait_background(void)
+{
+	std::unique_lock<std::mutex> lck(_bg_mtx);
+	_bg_cv.wait(lck, [this] { return 0 == _background; });
+}
+
+/// A copy of `h` in `as`, without any of the Values on `h`. Copying
+/// the Values is not wanted; it might even fetch them.
+static Handle bare_copy(AtomSpace* as, const Handle& h)
+{
+	if (h->is_node())
+		return as->add_node(h->get_type(), std::string(h->get_name()));
+
+	HandleSeq oset;
+	for (const Handle& ho : h->getOutgoingSet())
+		oset.push_back(bare_copy(as, ho));
+	return as->add_link(h->get_type(), std::move(oset));
+}
+
+/// Perform the read on the replica expected to answer first. If it
+/// is slow, then hedge, by also asking the next one. If it fails,
+/// then try the others. The reads are queued for the reader threads
+/// of each replica, so that the slow ones can be abandoned.
+///
+/// The read fetches into the AtomSpace `as`, if it is given, and
+/// else onto the Atoms `hs` themselves. Abandoned reads must not
+/// touch either of these: they might no longer exist, or might have
+/// newer Values by the time that the read completes. Thus, each read
+/// goes into a scratch AtomSpace, with copies of `hs` in it, and only
+/// the scratch AtomSpace of the winner is copied out.
+///
+/// If `hedge` is false, the replicas are asked one at a time, and only
+/// if the previous one failed. This is for bulk loads, which take far
+/// longer than the latency average, and would otherwise be sent to
+/// every replica.
+void RouterStorageNode::read(AtomSpace* as, const HandleSeq& hs,
+                             const ReadFn& fn, bool hedge)
+{
+	size_t nrep = _replicas.size();
+	if (0 == nrep)
+		throw IOException(TRACE_INFO,
+			"RouterStorageNode %s is not open!", get_name().c_str());
+
+	// Rotate the starting point, so that ties are broken differently
+	// each time, and the load is spread out.
+	// The scores change while sorting, so sort a snapshot of them.
+	size_t rot = _rotor.fetch_add(1, std::memory_order_relaxed);
+	std::vector<std::pair<double, Replica*>> ranked;
+	for (size_t i = 0; i < nrep; i++)
+	{
+		Replica* r = _replicas[(i + rot) % nrep].get();
+		ranked.push_back({r->score(), r});
+	}
+	std::stable_sort(ranked.begin(), ranked.end(),
+		[](const std::pair<double, Replica*>& a,
+		   const std::pair<double, Replica*>& b)
+			{ return a.first < b.first; });
+
+	std::vector<Replica*> order;
+	for (const auto& pr : ranked) order.push_back(pr.second);
+
+	// With just one replica, there is nothing to hedge against.
+	if (1 == nrep)
+	{
+		Replica* r = order[0];
+		r->reads++;
+		Clock::time_point start = Clock::now();
+		fn(r->store, as, hs);
+		double secs = std::chrono::duration<double>(
+			Clock::now() - start).count();
+		double lat = r->latency;
+		r->latency = (0.0 == lat) ? secs : 0.8 * lat + 0.2 * secs;
+		return;
+	}
+
+	// Straight into the AtomSpace; a replica that fails part-way
+	// leaves some Atoms behind, which the next one adds again. Not
+	// counted in the latency, which is meant for the small reads.
+	if (not hedge)
+	{
+		for (size_t i = 0; i < nrep; i++)
+		{
+			Replica* r = order[i];
+			r->reads++;
+			r->inflight++;
+			try { fn(r->store, as, hs); }
+			catch (...)
+			{
+				r->inflight--;
+				r->failures++;
+				if (i + 1 == nrep) throw;
+				continue;
+			}
+			r->inflight--;
+			return;
+		}
+	}
+
+	struct Race
+	{
+		std::mutex mtx;
+		std::condition_variable cv;
+		size_t failed = 0;
+		bool won = false;
+		std::exception_ptr err;
+		AtomSpacePtr scratch;
+		HandleSeq copies;
+	};
+	std::shared_ptr<Race> race(std::make_shared<Race>());
+
+	size_t next = 0;
+	auto launch = [&](void)
+	{
+		Replica* r = order[next++];
+		r->inflight++;
+		r->reads++;
+		{
+			std::lock_guard<std::mutex> lck(_bg_mtx);
+			_background++;
+		}
+
+		AtomSpacePtr scratch(createAtomSpace());
+		HandleSeq copies;
+		for (const Handle& h : hs)
+			copies.push_back(bare_copy(scratch.get(), h));
+
+		r->post_read([this, r, fn, race, scratch, copies](void)
+		{
+			Clock::time_point start = Clock::now();
+			std::exception_ptr ep;
+			try { fn(r->store, scratch.get(), copies); }
+			catch (...) { ep = std::current_exception(); }
+			double secs = std::chrono::duration<double>(
+				Clock::now() - start).count();
+
+			// Running average of the latency. Failures are penalized,
+			// so that failed replicas are tried last, for a while.
+			double lat = r->latency;
+			if (ep) { r->failures++; secs = std::max(4.0 * lat, 0.1); }
+			r->latency = (0.0 == lat) ? secs : 0.8 * lat + 0.2 * secs;
+			r->inflight--;
+
+			{
+				std::lock_guard<std::mutex> lck(race->mtx);
+				if (ep)
+				{
+					race->failed++;
+					if (nullptr == race->err) race->err = ep;
+				}
+				else if (not race->won)
+				{
+					race->won = true;
+					race->scratch = scratch;
+					race->copies = copies;
+				}
+			}
+			race->cv.notify_all();
+
+			std::lock_guard<std::mutex> lck(_bg_mtx);
+			_background--;
+			_bg_cv.notify_all();
+		});
+	};
+
+	launch();
+	double delay = std::max(MIN_HEDGE_SECS, HEDGE_FACTOR * order[0]->latency);
+
+	std::unique_lock<std::mutex> lck(race->mtx);
+	auto settled = [&](void) { return race->won or race->failed == next; };
+	while (not race->won)
+	{
+		// Everything launched so far has failed. Try the next one.
+		if (race->failed == next)
+		{
+			if (next == nrep) std::rethrow_exception(race->err);
+			launch();
+			continue;
+		}
+
+		// Nothing yet. Wait a while, then hedge with the next replica.
+		if (next < nrep)
+		{
+			if (race->cv.wait_for(lck,
+			       std::chrono::duration<double>(delay), settled))
+				continue;
+			order[next]->hedges++;
+			launch();
+			continue;
+		}
+		race->cv.wait(lck, settled);
+	}
+
+	// Copy out the answer of the winner. The losers may still be
+	// running; they have scratch AtomSpaces of their own.
+	AtomSpacePtr scratch(race->scratch);
+	HandleSeq copies(race->copies);
+	lck.unlock();
+
+	if (as)
+	{
+		HandleSeq got;
+		scratch->get_handles_by_type(got, ATOM, true);
+		for (const Handle& h : got)
+			as->add_atom(h);
+		return;
+	}
+	for (size_t i = 0; i < hs.size(); i++)
+		hs[i]->copyValues(copies[i]);
+}
+
+/// Queue the write for each of the replicas.
+void RouterStorageNode::write(const std::function<void(BackingStore*)>& fn)
+{
+	if (0 == _replicas.size())
+		throw IOException(TRACE_INFO,
+			"RouterStorageNode %s is not open!", get_name().c_str());
+
+	for (auto& r : _replicas)
+	{
+		BackingStore* bs = r->store;
+		r->post([fn, bs](void) { fn(bs); });
+	}
+}
+
+// ====================================================================
+// Reads
+
+void RouterStorageNode::getAtom(const Handle& h)
+{
+	read(nullptr, {h}, [](BackingStore* bs, AtomSpace*, const HandleSeq& hs)
+		{ bs->getAtom(hs[0]); });
+}
+
+void RouterStorageNode::fetchIncomingSet(AtomSpace* as, const Handle& h)
+{
+	read(as, {h}, [](BackingStore* bs, AtomSpace* sas, const HandleSeq& hs)
+		{ bs->fetchIncomingSet(sas, hs[0]); });
+}
+
+void RouterStorageNode::fetchIncomingByType(AtomSpace* as,
+                                            const Handle& h, Type t)
+{
+	read(as, {h}, [t](BackingStore* bs, AtomSpace* sas, const HandleSeq& hs)
+		{ bs->fetchIncomingByType(sas, hs[0], t); });
+}
+
+void RouterStorageNode::getAtoms(const HandleSeq& hs)
+{
+	read(nullptr, hs, [](BackingStore* bs, AtomSpace*, const HandleSeq& shs)
+		{ bs->getAtoms(shs); });
+}
+
+void RouterStorageNode::loadValues(const HandleSeq& hs, const Handle& key)
+{
+	read(nullptr, hs, [key](BackingStore* bs, AtomSpace*, const HandleSeq& shs)
+		{ bs->loadValues(shs, key); });
+}
+
+void RouterStorageNode::fetchIncomingSets(AtomSpace* as, const HandleSeq& hs)
+{
+	read(as, hs, [](BackingStore* bs, AtomSpace* sas, const HandleSeq& shs)
+		{ bs->fetchIncomingSets(sas, shs); });
+}
+
+void RouterStorageNode::loadValue(const Handle& h, const Handle& key)
+{
+	read(nullptr, {h}, [key](BackingStore* bs, AtomSpace*, const HandleSeq& hs)
+		{ bs->loadValue(hs[0], key); });
+}
+
+void RouterStorageNode::loadType(AtomSpace* as, Type t)
+{
+	read(as, {}, [t](BackingStore* bs, AtomSpace* sas, const HandleSeq&)
+		{ bs->loadType(sas, t); }, false);
+}
+
+void RouterStorageNode::loadAtomSpace(AtomSpace* as)
+{
+	read(as, {}, [](BackingStore* bs, AtomSpace* sas, const HandleSeq&)
+		{ bs->loadAtomSpace(sas); }, false);
+}
+
+// The loser of a hedged read may also answer; keep the first answer.
+Handle RouterStorageNode::getLink(Type t, const HandleSeq& hs)
+{
+	auto mtx = std::make_shared<std::mutex>();
+	auto res = std::make_shared<Handle>();
+	read(nullptr, {}, [mtx, res, t, hs](BackingStore* bs, AtomSpace*,
+	                                    const HandleSeq&)
+	{
+		Handle h(bs->getLink(t, hs));
+		std::lock_guard<std::mutex> lck(*mtx);
+		if (nullptr == *res) *res = h;
+	});
+	std::lock_guard<std::mutex> lck(*mtx);
+	return *res;
+}
+
+HandleSeq RouterStorageNode::loadFrameDAG(void)
+{
+	auto mtx = std::make_shared<std::mutex>();
+	auto res = std::make_shared<HandleSeq>();
+	auto done = std::make_shared<bool>(false);
+	read(nullptr, {}, [mtx, res, done](BackingStore* bs, AtomSpace*,
+	                                   const HandleSeq&)
+	{
+		HandleSeq hs(bs->loadFrameDAG());
+		std::lock_guard<std::mutex> lck(*mtx);
+		if (*done) return;
+		*res = std::move(hs);
+		*done = true;
+	});
+	std::lock_guard<std::mutex> lck(*mtx);
+	return *res;
+}
+
+// ====================================================================
+// Writes
+
+void RouterStorageNode::storeAtom(const Handle& h, bool synchronous)
+{
+	write([h](BackingStore* bs) { bs->storeAtom(h); });
+	if (synchronous) barrier();
+}
+
+void RouterStorageNode::storeValue(const Handle& h, const Handle& key)
+{
+	write([h, key](BackingStore* bs) { bs->storeValue(h, key); });
+}
+
+// The caller removes the Atom from the AtomSpace right after this;
+// the replicas may need its incoming set, so this is synchronous.
+void RouterStorageNode::removeAtom(AtomSpace* as, const Handle& h,
+                                   bool recursive)
+{
+	write([as, h, recursive](BackingStore* bs)
+		{ bs->removeAtom(as, h, recursive); });
+	for (auto& r : _replicas) r->drain();
+}
+
+// The AtomSpace might be gone by the time a queued write gets to it,
+// so these two are synchronous, too.
+void RouterStorageNode::storeAtomSpace(const AtomSpace* as)
+{
+	write([as](BackingStore* bs) { bs->storeAtomSpace(as); });
+	for (auto& r : _replicas) r->drain();
+}
+
+void RouterStorageNode::storeFrameDAG(AtomSpace* as)
+{
+	write([as](BackingStore* bs) { bs->storeFrameDAG(as); });
+	for (auto& r : _replicas) r->drain();
+}
+
+/// Wait for all queued writes, and all background reads, to complete,
+/// and then report the first write error, if any.
+void RouterStorageNode::barrier(AtomSpace* as)
+{
+	if (nullptr == as) as = getAtomSpace();
+	for (auto& r : _replicas) r->drain();
+	wait_background();
+	for (auto& r : _replicas) r->store->barrier(as);
+
+	std::string err;
+	for (auto& r : _replicas)
+	{
+		std::lock_guard<std::mutex> lck(r->mtx);
+		if (err.empty() and not r->error.empty())
+			err = r->node->to_short_string() + ": " + r->error;
+		r->error.clear();
+	}
+	if (not err.empty())
+		throw IOException(TRACE_INFO,
+			"RouterStorageNode %s write failed: %s",
+			get_name().c_str(), err.c_str());
+}
+
+DEFINE_NODE_FACTORY(RouterStorageNode, ROUTER_STORAGE_NODE)
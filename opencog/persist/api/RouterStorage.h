@@ -0,0 +1,182 @@
+/*
+ * opencog/persist/api/RouterStorage.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ROUTER_STORAGE_H
+#define _OPENCOG_ROUTER_STORAGE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencog/persist/api/StorageNode.h>
+
+namespace opencog
+{
+/** \addtogroup grp_persist
+ *  @{
+ */
+
+/**
+ * A StorageNode that spreads reads over several replicas of the same
+ * data, and sends writes to all of them.
+ *
+ * The replicas are other StorageNodes. They are given as a ListLink
+ * (or a LinkValue) placed on the RouterStorageNode, at the key
+ * `(PredicateNode "*-router-parts-*")`, before it is opened:
+ *
+ *    (cog-set-value! (RouterStorageNode "router://")
+ *        (Predicate "*-router-parts-*")
+ *        (List (PostgresStorageNode "postgres:///a")
+ *              (PostgresStorageNode "postgres:///b")))
+ *
+ * Each read goes to the replica that is expected to answer soonest:
+ * the one with the smallest average latency, scaled by the number of
+ * reads it is currently working on. If that replica has not answered
+ * after several times its average latency, the same read is sent to
+ * the next-best replica (a "hedged" request), and then the next, and
+ * so on; whichever answers first wins. If a replica fails, the read is
+ * retried on the others. Bulk loads (`loadType()`, `loadAtomSpace()`)
+ * are never hedged; they go to one replica at a time.
+ *
+ * When more than one replica is asked, each is read into a scratch
+ * AtomSpace of its own, and only the answer of the winner is copied
+ * into the AtomSpace being read into. The losers continue to run in
+ * the background, on a fixed number of reader threads per replica,
+ * and their answers are thrown away.
+ *
+ * Writes are queued, and sent to all replicas, in order, by one
+ * thread per replica. Thus, a read that follows a write might not
+ * see it; use `barrier()` to wait for all writes to complete. Write
+ * errors are reported by the next `barrier()`. Writes that are handed
+ * an AtomSpace (`storeAtomSpace()`, `storeFrameDAG()`, `removeAtom()`)
+ * return only after all replicas have performed them.
+ */
+class RouterStorageNode : public StorageNode
+{
+	private:
+		struct Replica
+		{
+			Handle node;
+			BackingStore* store;
+
+			// Load-aware selection.
+			std::atomic<size_t> inflight;
+			std::atomic<double> latency;   // Running average, seconds.
+			std::atomic<size_t> reads;
+			std::atomic<size_t> hedges;
+			std::atomic<size_t> failures;
+
+			// Asynchronous writes.
+			std::mutex mtx;
+			std::condition_variable cv;
+			std::deque<std::function<void(void)>> todo;
+			bool busy;
+			bool stop;
+			std::string error;
+			std::thread writer;
+
+			// Reads, on a fixed pool of threads.
+			std::condition_variable rcv;
+			std::deque<std::function<void(void)>> rtodo;
+			std::vector<std::thread> readers;
+
+			Replica(const Handle&, BackingStore*);
+			void write_loop(void);
+			void read_loop(void);
+			void post(std::function<void(void)>);
+			void post_read(std::function<void(void)>);
+			void drain(void);
+			double score(void) const;
+		};
+		typedef std::vector<std::unique_ptr<Replica>> ReplicaSeq;
+
+		ReplicaSeq _replicas;
+		std::atomic<size_t> _rotor;
+
+		// Reads still running in the background.
+		std::mutex _bg_mtx;
+		std::condition_variable _bg_cv;
+		size_t _background;
+		void wait_background(void);
+
+		// A read, into the AtomSpace, of the given Atoms.
+		typedef std::function<void(BackingStore*, AtomSpace*,
+		                           const HandleSeq&)> ReadFn;
+		void read(AtomSpace*, const HandleSeq&, const ReadFn&,
+		          bool hedge = true);
+		void write(const std::function<void(BackingStore*)>&);
+		void shut(void);
+
+	public:
+		RouterStorageNode(Type t, const std::string& uri);
+		virtual ~RouterStorageNode();
+
+		void open(void);
+		void close(void);
+		bool connected(void);
+
+		void create(void);
+		void destroy(void);
+		void erase(void);
+
+		std::string monitor(void);
+
+		// BackingStore interface
+		void getAtom(const Handle&);
+		void fetchIncomingSet(AtomSpace*, const Handle&);
+		void fetchIncomingByType(AtomSpace*, const Handle&, Type);
+		void getAtoms(const HandleSeq&);
+		void loadValues(const HandleSeq&, const Handle&);
+		void fetchIncomingSets(AtomSpace*, const HandleSeq&);
+		void storeAtom(const Handle&, bool synchronous = false);
+		void removeAtom(AtomSpace*, const Handle&, bool recursive);
+		void storeValue(const Handle&, const Handle&);
+		void loadValue(const Handle&, const Handle&);
+		void loadType(AtomSpace*, Type);
+		void loadAtomSpace(AtomSpace*);
+		void storeAtomSpace(const AtomSpace*);
+		HandleSeq loadFrameDAG(void);
+		void storeFrameDAG(AtomSpace*);
+		void barrier(AtomSpace* = nullptr);
+
+	protected:
+		Handle getLink(Type, const HandleSeq&);
+
+	public:
+		static Handle factory(const Handle&);
+};
+
+typedef std::shared_ptr<RouterStorageNode> RouterStorageNodePtr;
+static inline RouterStorageNodePtr RouterStorageNodeCast(const Handle& h)
+	{ return std::dynamic_pointer_cast<RouterStorageNode>(h); }
+
+#define createRouterStorageNode std::make_shared<RouterStorageNode>
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_ROUTER_STORAGE_H
@@ -0,0 +1,448 @@
+/*
+ * opencog/persist/api/ShardStorage.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <opencog/atomspace/Transient.h>
+#include <opencog/atoms/pattern/PatternLink.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/persist/storage/storage_types.h>
+#include "ShardStorage.h"
+
+using namespace opencog;
+
+// ====================================================================
+// Shards
+
+ShardStorageNode::Shard::Shard(void) :
+	stop(false)
+{
+	as = createAtomSpace();
+	worker = std::thread(&Shard::work_loop, this);
+}
+
+ShardStorageNode::Shard::~Shard()
+{
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		stop = true;
+	}
+	cv.notify_all();
+	worker.join();
+}
+
+void ShardStorageNode::Shard::work_loop(void)
+{
+	std::unique_lock<std::mutex> lck(mtx);
+	while (true)
+	{
+		cv.wait(lck, [this] { return stop or not todo.empty(); });
+		if (todo.empty()) return;
+
+		std::function<void(void)> job(std::move(todo.front()));
+		todo.pop_front();
+		lck.unlock();
+		job();
+		lck.lock();
+	}
+}
+
+void ShardStorageNode::Shard::post(std::function<void(void)> job)
+{
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		todo.emplace_back(std::move(job));
+	}
+	cv.notify_one();
+}
+
+// ====================================================================
+
+/// The number of shards is the number at the end of the URL.
+ShardStorageNode::ShardStorageNode(Type t, const std::string& uri) :
+	StorageNode(t, uri), _nshards(0), _connected(false)
+{
+	size_t pos = uri.find("://");
+	if (std::string::npos != pos)
+	{
+		const char* p = uri.c_str() + pos + 3;
+		char* end = nullptr;
+		unsigned long n = strtoul(p, &end, 10);
+		if (end != p) _nshards = n;
+	}
+	if (0 == _nshards)
+		_nshards = std::max(1u, std::thread::hardware_concurrency());
+}
+
+ShardStorageNode::~ShardStorageNode()
+{
+}
+
+void ShardStorageNode::open(void)
+{
+	if (0 == _shards.size())
+		for (size_t i = 0; i < _nshards; i++)
+			_shards.emplace_back(new Shard());
+	_connected = true;
+}
+
+void ShardStorageNode::close(void)
+{
+	_connected = false;
+}
+
+void ShardStorageNode::erase(void)
+{
+	for (auto& s : _shards)
+		s->as->clear();
+}
+
+std::string ShardStorageNode::monitor(void)
+{
+	std::string rs = "Shard Storage Node " + get_name() + "\n";
+	for (size_t i = 0; i < _shards.size(); i++)
+	{
+		const AtomSpacePtr& sas = _shards[i]->as;
+		rs += "  shard " + std::to_string(i) +
+			": nodes=" + std::to_string(sas->get_num_nodes()) +
+			" links=" + std::to_string(sas->get_num_links()) + "\n";
+	}
+	return rs;
+}
+
+// ====================================================================
+
+/// The AtomSpace of the shard owning the Atom.
+AtomSpace* ShardStorageNode::home(const Handle& h)
+{
+	if (0 == _shards.size())
+		throw IOException(TRACE_INFO,
+			"ShardStorageNode %s is not open!", get_name().c_str());
+	return _shards[owner(h)]->as.get();
+}
+
+/// Run `fn(i)` for each shard `i`, in the thread belonging to that
+/// shard, and wait for all of them to finish. The first exception
+/// thrown, if any, is passed on to the caller.
+void ShardStorageNode::scatter(const std::function<void(size_t)>& fn)
+{
+	if (0 == _shards.size())
+		throw IOException(TRACE_INFO,
+			"ShardStorageNode %s is not open!", get_name().c_str());
+
+	std::mutex mtx;
+	std::condition_variable cv;
+	size_t left = _shards.size();
+	std::exception_ptr err;
+
+	for (size_t i = 0; i < _shards.size(); i++)
+	{
+		_shards[i]->post([&, i](void)
+		{
+			std::exception_ptr ep;
+			try { fn(i); }
+			catch (...) { ep = std::current_exception(); }
+
+			std::lock_guard<std::mutex> lck(mtx);
+			if (ep and nullptr == err) err = ep;
+			if (0 == --left) cv.notify_all();
+		});
+	}
+
+	std::unique_lock<std::mutex> lck(mtx);
+	cv.wait(lck, [&] { return 0 == left; });
+	if (err) std::rethrow_exception(err);
+}
+
+/// Return a copy of the Atom, without any Values, anywhere in it.
+static Handle skeleton(const Handle& h)
+{
+	if (h->is_node())
+		return createNode(h->get_type(), std::string(h->get_name()));
+
+	HandleSeq oset;
+	for (const Handle& ho : h->getOutgoingSet())
+		oset.emplace_back(skeleton(ho));
+	return createLink(std::move(oset), h->get_type());
+}
+
+/// Place the Atom, with its Values, in the shard that owns it.
+/// If `deep`, also place each Atom in its outgoing set in the shard
+/// that owns it.
+void ShardStorageNode::store(const Handle& h, bool deep)
+{
+	// Not copyValues(), as that would copy any LazyValues, instead
+	// of the Values they stand for.
+	Handle sh(home(h)->add_atom(skeleton(h)));
+	for (const Handle& key : h->getKeys())
+		sh->setValue(key, h->getValue(key));
+
+	if (not deep or not h->is_link()) return;
+	for (const Handle& ho : h->getOutgoingSet())
+		ensure(ho);
+}
+
+/// Make sure that the Atom, and everything under it, is present in
+/// the shards that own them. Values are not copied.
+void ShardStorageNode::ensure(const Handle& h)
+{
+	home(h)->add_atom(skeleton(h));
+	if (not h->is_link()) return;
+	for (const Handle& ho : h->getOutgoingSet())
+		ensure(ho);
+}
+
+// ====================================================================
+// Writes
+
+void ShardStorageNode::storeAtom(const Handle& h, bool synchronous)
+{
+	store(h, true);
+}
+
+void ShardStorageNode::storeValue(const Handle& h, const Handle& key)
+{
+	ensure(h);
+	home(h)->get_atom(h)->setValue(key, h->getValue(key));
+}
+
+/// The Atom is in every shard holding a Link that contains it. If it
+/// is not to be removed recursively, then it can only be removed if
+/// none of the shards has anything in its incoming set; otherwise, it
+/// would be removed from some shards, and not from others. So check
+/// all of them first, and remove it from all, or none.
+void ShardStorageNode::removeAtom(AtomSpace* as, const Handle& h,
+                                  bool recursive)
+{
+	if (not recursive)
+	{
+		std::atomic<bool> used(false);
+		scatter([&](size_t i)
+		{
+			Handle sh(_shards[i]->as->get_atom(h));
+			if (sh and not sh->isIncomingSetEmpty()) used = true;
+		});
+		if (used) return;
+	}
+
+	scatter([&](size_t i)
+	{
+		const AtomSpacePtr& sas = _shards[i]->as;
+		Handle sh(sas->get_atom(h));
+		if (sh) sas->extract_atom(sh, recursive);
+	});
+}
+
+/// Each shard stores the Atoms that it owns, all at the same time.
+void ShardStorageNode::storeAtomSpace(const AtomSpace* as)
+{
+	HandleSeq all;
+	as->get_handles_by_type(all, ATOM, true);
+
+	std::vector<HandleSeq> parts(_nshards);
+	for (const Handle& h : all)
+		parts[owner(h)].emplace_back(h);
+
+	scatter([&](size_t i)
+	{
+		for (const Handle& h : parts[i])
+			store(h, false);
+	});
+}
+
+// ====================================================================
+// Reads from a single shard
+
+Handle ShardStorageNode::getNode(Type t, const char * name)
+{
+	Handle h(createNode(t, std::string(name)));
+	return home(h)->get_atom(h);
+}
+
+Handle ShardStorageNode::getLink(Type t, const HandleSeq& hs)
+{
+	Handle h(createLink(HandleSeq(hs), t));
+	return home(h)->get_atom(h);
+}
+
+void ShardStorageNode::loadValue(const Handle& h, const Handle& key)
+{
+	Handle sh(home(h)->get_atom(h));
+	if (nullptr == sh) return;
+	ValuePtr vp(sh->getValue(key));
+	if (vp) h->setValue(key, vp);
+}
+
+// ====================================================================
+// Reads from all shards
+
+/// Copy the Atoms of type `t` (and subtypes, if `subclass`) owned by
+/// each shard into the AtomSpace.
+void ShardStorageNode::load_owned(AtomSpace* as, Type t, bool subclass)
+{
+	scatter([&](size_t i)
+	{
+		HandleSeq hs;
+		_shards[i]->as->get_handles_by_type(hs, t, subclass);
+		for (const Handle& h : hs)
+			if (owner(h) == i) as->add_atom(h);
+	});
+}
+
+void ShardStorageNode::loadType(AtomSpace* as, Type t)
+{
+	load_owned(as, t, false);
+}
+
+void ShardStorageNode::loadAtomSpace(AtomSpace* as)
+{
+	load_owned(as, ATOM, true);
+}
+
+/// Each shard looks up the incoming sets of the Atoms, and copies the
+/// Links that it owns into the AtomSpace. Links that are only copies
+/// are skipped; the shard owning them will find them too.
+void ShardStorageNode::fetch_incoming(AtomSpace* as, const HandleSeq& hs,
+                                      Type t, bool by_type)
+{
+	scatter([&](size_t i)
+	{
+		const AtomSpacePtr& sas = _shards[i]->as;
+		for (const Handle& h : hs)
+		{
+			Handle sh(sas->get_atom(h));
+			if (nullptr == sh) continue;
+
+			IncomingSet inc(by_type ?
+				sh->getIncomingSetByType(t) : sh->getIncomingSet());
+			for (const Handle& l : inc)
+				if (owner(l) == i) as->add_atom(l);
+		}
+	});
+}
+
+void ShardStorageNode::fetchIncomingSet(AtomSpace* as, const Handle& h)
+{
+	fetch_incoming(as, HandleSeq({h}), NOTYPE, false);
+}
+
+void ShardStorageNode::fetchIncomingByType(AtomSpace* as,
+                                           const Handle& h, Type t)
+{
+	fetch_incoming(as, HandleSeq({h}), t, true);
+}
+
+void ShardStorageNode::fetchIncomingSets(AtomSpace* as, const HandleSeq& hs)
+{
+	fetch_incoming(as, hs, NOTYPE, false);
+}
+
+// ====================================================================
+// Queries
+
+/// True if the query has just one clause, with nothing evaluatable in
+/// it. Each grounding of such a query is a single Link, which lies
+/// entirely within the shard that owns it.
+static bool single_clause(const Handle& query)
+{
+	Type qt = query->get_type();
+	if (not nameserver().isA(qt, MEET_LINK) and
+	    not nameserver().isA(qt, QUERY_LINK))
+		return false;
+
+	PatternLinkPtr plp(PatternLinkCast(query));
+	if (nullptr == plp) return false;
+
+	const Pattern& pat = plp->get_pattern();
+	if (1 != pat.pmandatory.size()) return false;
+	if (0 < plp->get_virtual().size()) return false;
+	if (pat.have_evaluatables) return false;
+	if (0 < pat.absents.size() or 0 < pat.always.size()) return false;
+	if (0 < pat.defined_terms.size()) return false;
+
+	const PatternTermPtr& cl = pat.pmandatory[0];
+	return cl->isLink() and not cl->isChoice();
+}
+
+/// Single-clause queries are performed in every shard at once, and
+/// the results merged. All others are performed as usual, fetching
+/// what they need from the shards.
+void ShardStorageNode::runQuery(const Handle& query, const Handle& key,
+                                const Handle& meta, bool fresh)
+{
+	if (not single_clause(query))
+	{
+		BackingStore::runQuery(query, key, meta, fresh);
+		return;
+	}
+
+	if (not fresh)
+	{
+		if (nullptr != query->getValue(key)) return;
+		loadValue(query, key);
+		if (meta) loadValue(query, meta);
+		if (nullptr != query->getValue(key)) return;
+	}
+
+	AtomSpace* as = query->getAtomSpace();
+	std::vector<HandleSeq> found(_nshards);
+	scatter([&](size_t i)
+	{
+		AtomSpace* tas = grab_transient_atomspace(_shards[i]->as.get());
+		Handle q(tas->add_atom(skeleton(query)));
+		ValuePtr qv(q->execute(tas));
+		if (qv and qv->is_type(LINK_VALUE))
+		{
+			for (const ValuePtr& v : LinkValueCast(qv)->value())
+			{
+				Handle h(HandleCast(v));
+				if (h) found[i].emplace_back(as->add_atom(h));
+			}
+		}
+		release_transient_atomspace(tas);
+	});
+
+	// The same grounding may be found in several shards.
+	HandleSet seen;
+	HandleSeq merged;
+	for (const HandleSeq& hs : found)
+		for (const Handle& h : hs)
+			if (h and seen.insert(h).second)
+				merged.emplace_back(h);
+
+	query->setValue(key, createLinkValue(merged));
+	storeValue(query, key);
+
+	if (nullptr == meta) return;
+
+	time_t now = time(0);
+	double dnow = now;
+	query->setValue(meta, createFloatValue(dnow));
+	storeValue(query, meta);
+}
+
+DEFINE_NODE_FACTORY(ShardStorageNode, SHARD_STORAGE_NODE)
@@ -0,0 +1,144 @@
+/*
+ * opencog/persist/api/ShardStorage.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SHARD_STORAGE_H
+#define _OPENCOG_SHARD_STORAGE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <opencog/persist/api/StorageNode.h>
+
+namespace opencog
+{
+/** \addtogroup grp_persist
+ *  @{
+ */
+
+/**
+ * A StorageNode that holds its Atoms in RAM, partitioned over several
+ * AtomSpaces ("shards"), each with a thread of its own. The number of
+ * shards is given in the URL: `(ShardStorageNode "shard://8")`; if it
+ * is not given, there is one shard per CPU core.
+ *
+ * Each Atom is owned by exactly one shard, chosen by its content hash;
+ * all of the Values on the Atom are kept there. A Link is also kept in
+ * its own shard, and so its outgoing set is copied into that shard as
+ * well, without any Values. Thus, each shard is a complete AtomSpace,
+ * and the incoming set of an Atom is the union of its incoming sets in
+ * all of the shards.
+ *
+ * Fetches of single Atoms and Values go to the owning shard only. Loads
+ * by type, incoming-set fetches and queries are sent to all shards at
+ * once, and the results are merged. Queries having just one clause are
+ * performed in each shard separately, as each grounding of the clause
+ * lies entirely within one shard. All other queries are performed in
+ * the caller's thread, fetching what they need from the shards.
+ *
+ * The contents are kept until the node itself is deleted; closing and
+ * re-opening does not lose them. All writes are synchronous.
+ */
+class ShardStorageNode : public StorageNode
+{
+	private:
+		struct Shard
+		{
+			AtomSpacePtr as;
+			std::mutex mtx;
+			std::condition_variable cv;
+			std::deque<std::function<void(void)>> todo;
+			bool stop;
+			std::thread worker;
+
+			Shard(void);
+			~Shard();
+			void work_loop(void);
+			void post(std::function<void(void)>);
+		};
+		typedef std::vector<std::unique_ptr<Shard>> ShardSeq;
+
+		ShardSeq _shards;
+		size_t _nshards;
+		bool _connected;
+
+		size_t owner(const Handle& h) const
+			{ return h->get_hash() % _nshards; }
+		AtomSpace* home(const Handle&);
+		void scatter(const std::function<void(size_t)>&);
+
+		void store(const Handle&, bool);
+		void ensure(const Handle&);
+		void load_owned(AtomSpace*, Type, bool);
+		void fetch_incoming(AtomSpace*, const HandleSeq&, Type, bool);
+
+	public:
+		ShardStorageNode(Type t, const std::string& uri);
+		virtual ~ShardStorageNode();
+
+		void open(void);
+		void close(void);
+		bool connected(void) { return _connected; }
+
+		void create(void) {}
+		void destroy(void) { erase(); }
+		void erase(void);
+
+		std::string monitor(void);
+
+		// BackingStore interface
+		bool loadAtom(const Handle& h) { return getAtomCompat(h); }
+		void fetchIncomingSet(AtomSpace*, const Handle&);
+		void fetchIncomingByType(AtomSpace*, const Handle&, Type);
+		void fetchIncomingSets(AtomSpace*, const HandleSeq&);
+		void storeAtom(const Handle&, bool synchronous = false);
+		void removeAtom(AtomSpace*, const Handle&, bool recursive);
+		void storeValue(const Handle&, const Handle&);
+		void loadValue(const Handle&, const Handle&);
+		void runQuery(const Handle&, const Handle&,
+		              const Handle& = Handle::UNDEFINED, bool = false);
+		void loadType(AtomSpace*, Type);
+		void loadAtomSpace(AtomSpace*);
+		void storeAtomSpace(const AtomSpace*);
+		void barrier(AtomSpace* = nullptr) {}
+
+	protected:
+		Handle getNode(Type, const char *);
+		Handle getLink(Type, const HandleSeq&);
+
+	public:
+		static Handle factory(const Handle&);
+};
+
+typedef std::shared_ptr<ShardStorageNode> ShardStorageNodePtr;
+static inline ShardStorageNodePtr ShardStorageNodeCast(const Handle& h)
+	{ return std::dynamic_pointer_cast<ShardStorageNode>(h); }
+
+#define createShardStorageNode std::make_shared<ShardStorageNode>
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_SHARD_STORAGE_H
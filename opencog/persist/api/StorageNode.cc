@@ -32,7 +32,8 @@ using namespace opencog;
 // ====================================================================
 
 StorageNode::StorageNode(Type t, std::string uri) :
-	Node(t, uri)
+	Node(t, uri),
+	_residency(std::make_shared<ValueResidency>(this))
 {
 	if (not nameserver().isA(t, STORAGE_NODE))
 		throw RuntimeException(TRACE_INFO, "Bad inheritance!");
@@ -40,6 +41,8 @@ StorageNode::StorageNode(Type t, std::string uri) :
 
 StorageNode::~StorageNode()
 {
+	// LazyValues can outlive us; stop them from calling back.
+	_residency->detach();
 }
 
 std::string StorageNode::monitor(void)
@@ -47,6 +50,16 @@ std::string StorageNode::monitor(void)
 	return "This StorageNode does not implement a monitor.";
 }
 
+void StorageNode::set_fetch_cache(double ttl, double neg_ttl)
+{
+	_fetch_cache.set_timeouts(ttl, neg_ttl);
+}
+
+void StorageNode::set_lazy_values(bool lazy, size_t budget)
+{
+	_residency->set_lazy(lazy, budget);
+}
+
 // ====================================================================
 
 void StorageNode::barrier(AtomSpace* as)
@@ -60,6 +73,7 @@ void StorageNode::store_atom(const Handle& h)
 	if (_atom_space->get_read_only())
 		throw RuntimeException(TRACE_INFO, "Read-only AtomSpace!");
 
+	_fetch_cache.invalidate(h);
 	storeAtom(h);
 }
 
@@ -68,6 +82,7 @@ void StorageNode::store_value(const Handle& h, const Handle& key)
 	if (_atom_space->get_read_only())
 		throw RuntimeException(TRACE_INFO, "Read-only AtomSpace!");
 
+	_fetch_cache.invalidate(h, key);
 	storeValue(h, key);
 }
 
@@ -99,6 +114,11 @@ bool StorageNode::remove_atom(AtomSpace* as, Handle h, bool recursive)
 	if (not _atom_space->get_read_only())
 		removeAtom(as, h, recursive);
 
+	// Recursive removal also takes out the incoming set; the fetch
+	// cache cannot track all of that, so just forget everything.
+	if (recursive) _fetch_cache.clear();
+	else _fetch_cache.invalidate(h);
+
 	return as->extract_atom(h, recursive);
 }
 
@@ -115,19 +135,106 @@ Handle StorageNode::fetch_atom(const Handle& h, AtomSpace* as)
 	// with your favorite algo.
 	Handle ah = as->add_atom(h);
 	if (nullptr == ah) return ah; // if read-only, then cannot update.
-	getAtom(ah);
+	if (_fetch_cache.have_atom(ah, as)) return ah;
+
+	// An Atom without Values is not a missing Atom; only storage
+	// can say that it does not have it.
+	bool found = loadAtom(ah);
+	_fetch_cache.got_atom(ah, as, found);
 	return ah;
 }
 
 Handle StorageNode::fetch_value(const Handle& h, const Handle& key,
                                 AtomSpace* as)
 {
+	if (nullptr == as) as = getAtomSpace();
 	Handle lkey = as->add_atom(key);
 	Handle lh = as->add_atom(h);
+	if (_fetch_cache.have_value(lh, lkey, as)) return lh;
 	loadValue(lh, lkey);
+	_fetch_cache.got_value(lh, lkey, as, nullptr != lh->getValue(lkey));
 	return lh;
 }
 
+HandleSeq StorageNode::fetch_atoms(const HandleSeq& hs, AtomSpace* as)
+{
+	if (nullptr == as) as = getAtomSpace();
+
+	// Only fetch the ones that are not in the fetch cache.
+	HandleSeq local;
+	HandleSeq todo;
+	local.reserve(hs.size());
+	for (const Handle& h : hs)
+	{
+		Handle ah;
+		if (h) ah = as->add_atom(h);
+		local.push_back(ah);
+		if (nullptr == ah) continue; // if read-only, then cannot update.
+		if (_fetch_cache.have_atom(ah, as)) continue;
+		todo.push_back(ah);
+	}
+	if (0 == todo.size()) return local;
+
+	// The batched fetch does not say which Atoms were missing; all of
+	// them were fetched, though.
+	getAtoms(todo);
+	for (const Handle& ah : todo)
+		_fetch_cache.got_atom(ah, as, true);
+	return local;
+}
+
+HandleSeq StorageNode::fetch_values(const HandleSeq& hs, const Handle& key,
+                                    AtomSpace* as)
+{
+	if (nullptr == as) as = getAtomSpace();
+	Handle lkey = as->add_atom(key);
+
+	HandleSeq local;
+	HandleSeq todo;
+	local.reserve(hs.size());
+	for (const Handle& h : hs)
+	{
+		Handle lh;
+		if (h) lh = as->add_atom(h);
+		local.push_back(lh);
+		if (nullptr == lh) continue;
+		if (_fetch_cache.have_value(lh, lkey, as)) continue;
+		todo.push_back(lh);
+	}
+	if (0 == todo.size()) return local;
+
+	loadValues(todo, lkey);
+	for (const Handle& lh : todo)
+		_fetch_cache.got_value(lh, lkey, as, nullptr != lh->getValue(lkey));
+	return local;
+}
+
+HandleSeq StorageNode::fetch_incoming_sets(const HandleSeq& hs,
+                                           AtomSpace* as)
+{
+	if (nullptr == as) as = getAtomSpace();
+
+	// Much like fetch_incoming_set(), Atoms that are not in the
+	// AtomSpace are skipped, and returned as null handles.
+	HandleSeq local;
+	HandleSeq todo;
+	local.reserve(hs.size());
+	for (const Handle& h : hs)
+	{
+		Handle lh = as->get_atom(h);
+		local.push_back(lh);
+		if (nullptr == lh) continue;
+		if (_fetch_cache.have_incoming(lh, as)) continue;
+		todo.push_back(lh);
+	}
+	if (0 == todo.size()) return local;
+
+	fetchIncomingSets(as, todo);
+	for (const Handle& lh : todo)
+		_fetch_cache.got_incoming(lh, as, not lh->isIncomingSetEmpty());
+	return local;
+}
+
 Handle StorageNode::fetch_incoming_set(const Handle& h, bool recursive,
                                        AtomSpace* as)
 {
@@ -136,7 +243,11 @@ Handle StorageNode::fetch_incoming_set(const Handle& h, bool recursive,
 	if (nullptr == lh) return lh;
 
 	// Get everything from the backing store.
-	fetchIncomingSet(as, lh);
+	if (not _fetch_cache.have_incoming(lh, as))
+	{
+		fetchIncomingSet(as, lh);
+		_fetch_cache.got_incoming(lh, as, not lh->isIncomingSetEmpty());
+	}
 
 	if (not recursive) return lh;
 
@@ -176,7 +287,26 @@ Handle StorageNode::fetch_query(const Handle& query, const Handle& key,
 	Handle lmeta = metadata;
 	if (Handle::UNDEFINED != lmeta) lmeta = as->add_atom(lmeta);
 
+	// If the earlier results are being watched, bring them up to
+	// date, instead of running the whole query again.
+	if (not fresh)
+	{
+		HandleSeq added;
+		QueryCache::State st = _query_cache.take(lq, lkey, added);
+		if (QueryCache::CURRENT == st)
+		{
+			if (0 == added.size()) return lq;
+
+			// The new results are copied into the AtomSpace; these
+			// must not be searched from again, on the next fetch.
+			QueryCache::Inserting ins(_query_cache);
+			if (updateQuery(lq, lkey, lmeta, added)) return lq;
+		}
+		if (QueryCache::UNWATCHED != st) fresh = true;
+	}
+
 	runQuery(lq, lkey, lmeta, fresh);
+	_query_cache.watch(lq, lkey);
 	return lq;
 }
 
@@ -192,9 +322,35 @@ void StorageNode::load_atomspace(AtomSpace* as)
 void StorageNode::store_atomspace(AtomSpace* as)
 {
 	if (nullptr == as) as = getAtomSpace();
+	_fetch_cache.clear();
+
+	// Everything is about to be stored, so forget the older changes.
+	// Do this first, so that changes made during the store are kept.
+	if (as->tracking_changes()) as->take_changes();
 	storeAtomSpace(as);
 }
 
+size_t StorageNode::store_changes(AtomSpace* as)
+{
+	if (nullptr == as) as = getAtomSpace();
+
+	if (not as->tracking_changes())
+	{
+		as->track_changes(true);
+		store_atomspace(as);
+		return as->get_size();
+	}
+
+	HandleSeq chg(as->take_changes());
+	for (const Handle& h : chg)
+	{
+		_fetch_cache.invalidate(h);
+		storeAtom(h);
+	}
+	barrier();
+	return chg.size();
+}
+
 void StorageNode::fetch_all_atoms_of_type(Type t, AtomSpace* as)
 {
 	if (nullptr == as) as = getAtomSpace();
@@ -28,6 +28,9 @@
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/persist/api/BackingStore.h>
+#include <opencog/persist/api/FetchCache.h>
+#include <opencog/persist/api/QueryCache.h>
+#include <opencog/persist/api/ValueResidency.h>
 #include <opencog/persist/storage/storage_types.h>
 
 namespace opencog
@@ -43,6 +46,23 @@ protected:
 	void get_absent_atoms(const AtomSpace* as, HandleSeq& missing) const
 		{ as->get_absent_atoms(missing); }
 
+	// StorageNodes built out of other StorageNodes need to reach the
+	// BackingStore methods of those.
+	static BackingStore* backing_store(StorageNode* snp) { return snp; }
+
+	// Read-through cache of recent fetches. Disabled by default.
+	FetchCache _fetch_cache;
+
+	// Changes affecting the results of earlier fetch_query() calls.
+	QueryCache _query_cache;
+
+	// Values fetched on demand. Disabled by default.
+	ValueResidencyPtr _residency;
+
+	// Backends that support lazy loading place this on each key of
+	// each Atom they load, instead of the Value, if lazy_values().
+	ValuePtr lazy_value(void) const { return _residency->placeholder(); }
+
 public:
 	StorageNode(Type, std::string);
 	virtual ~StorageNode();
@@ -94,6 +114,58 @@ public:
 	 */
 	virtual std::string monitor(void);
 
+	// ----------------------------------------------------------------
+	// Read-through caching of fetches.
+	/**
+	 * Enable caching of the results of `fetch_atom()`, `fetch_value()`
+	 * and `fetch_incoming_set()`. If the same fetch is repeated within
+	 * `ttl` seconds, then it is answered from the AtomSpace, instead
+	 * of going to storage. Fetches that found nothing are remembered
+	 * for `neg_ttl` seconds. Storing or removing an Atom through this
+	 * StorageNode invalidates the cached fetches for that Atom. Changes
+	 * made to storage by other clients are not seen until the time-out
+	 * expires. A `ttl` of zero disables the cache (the default).
+	 */
+	void set_fetch_cache(double ttl, double neg_ttl);
+	void clear_fetch_cache(void) { _fetch_cache.clear(); }
+
+	/**
+	 * Return the hit/miss statistics for the fetch cache, or the empty
+	 * string, if the cache is not enabled.
+	 */
+	std::string monitor_fetch_cache(void) { return _fetch_cache.stats(); }
+
+	// ----------------------------------------------------------------
+	// Lazy loading of Values.
+	/**
+	 * Enable lazy loading of Values. When enabled, loading an Atom
+	 * (with `fetch_atom()`, `load_atomspace()`, and so on) gets only
+	 * the keys of its Values; each Value is fetched the first time
+	 * that `getValue()` is called for it. Explicit fetches of Values,
+	 * with `fetch_value()` and `fetch_values()`, are not lazy.
+	 *
+	 * If `budget` is not zero, then fetched Values are evicted from
+	 * RAM, oldest first, whenever their total size goes over `budget`
+	 * bytes. Evicted Values are fetched again, if needed. Values that
+	 * were changed after being fetched are never evicted.
+	 *
+	 * The StorageNode must be kept open while any of the Atoms it
+	 * loaded still have Values that were not fetched.
+	 *
+	 * Not all backends support this; those that don't, ignore it.
+	 */
+	void set_lazy_values(bool lazy, size_t budget = 0);
+	bool lazy_values(void) const { return _residency->enabled(); }
+
+	/// Evict all fetched Values that have not been changed.
+	void evict_values(void) { _residency->evict_all(); }
+
+	/**
+	 * Return the fetch and eviction statistics for lazy Values, or
+	 * the empty string, if lazy loading is not enabled.
+	 */
+	std::string monitor_lazy_values(void) { return _residency->stats(); }
+
 	// ----------------------------------------------------------------
 	// Operations regarding specific atomspace contents.
 
@@ -134,6 +206,19 @@ public:
 	Handle fetch_value(const Handle& atom, const Handle& key,
 	                   AtomSpace* = nullptr);
 
+	/**
+	 * Batched versions of `fetch_atom()`, `fetch_value()` and
+	 * `fetch_incoming_set()`. These fetch the data for all of the
+	 * Atoms in one go, which, for network and database backends,
+	 * avoids paying one round-trip per Atom. The returned sequence
+	 * holds the AtomSpace versions of the Atoms, in the same order.
+	 * The incoming-set fetch is not recursive.
+	 */
+	HandleSeq fetch_atoms(const HandleSeq&, AtomSpace* = nullptr);
+	HandleSeq fetch_values(const HandleSeq&, const Handle& key,
+	                       AtomSpace* = nullptr);
+	HandleSeq fetch_incoming_sets(const HandleSeq&, AtomSpace* = nullptr);
+
 	/**
 	 * Use the backing store to load all atoms of the given atom type.
 	 */
@@ -149,6 +234,19 @@ public:
 	 */
 	void store_atomspace(AtomSpace* = nullptr);
 
+	/**
+	 * Store only those Atoms that were added, or had Values changed,
+	 * since the last call to this method (or to `store_atomspace`).
+	 * The first call turns on change tracking in the AtomSpace, and
+	 * stores everything, so as to provide a checkpoint to start from.
+	 * Returns the number of Atoms that were stored.
+	 *
+	 * Atoms that were extracted from the AtomSpace are not deleted
+	 * from storage; use `remove_atom()` for that. Atoms and Values
+	 * fetched from storage count as changed, and will be written back.
+	 */
+	size_t store_changes(AtomSpace* = nullptr);
+
 	/**
 	 * Return the DAG of all AtomSpaces in the backing store.
 	 * The AtomSpaces themselves will not be populated; use the
@@ -222,6 +320,13 @@ public:
 	 * Only the Atoms that were the result of the search are returned.
 	 * Any Values hanging off those Atoms are not transferred from the
 	 * remote server to the local AtomSpace.
+	 *
+	 * After a fetch, changes to the AtomSpace that might affect the
+	 * results are tracked. The next fetch of the same query and key
+	 * then either extends the earlier results with just the new
+	 * groundings, or, if that is not possible, re-runs the query.
+	 * Changes made directly to storage, by other clients, are not
+	 * seen; use `fresh` to pick those up.
 	 */
 	Handle fetch_query(const Handle& query, const Handle& key,
 	                   const Handle& metadata_key = Handle::UNDEFINED,
@@ -0,0 +1,190 @@
+/*
+ * opencog/persist/api/ValueResidency.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+
+#include "BackingStore.h"
+#include "ValueResidency.h"
+
+using namespace opencog;
+
+// ====================================================================
+
+ValueResidency::ValueResidency(BackingStore* bs) :
+	_store(bs), _enabled(false), _budget(0), _resident(0),
+	_loads(0), _misses(0), _evictions(0)
+{
+}
+
+/// Rough estimate of the RAM used by a Value, in bytes.
+static size_t footprint(const ValuePtr& v)
+{
+	Type t = v->get_type();
+	size_t per = sizeof(double);
+	if (nameserver().isA(t, STRING_VALUE)) per = 32;
+	else if (nameserver().isA(t, LINK_VALUE)) per = sizeof(ValuePtr);
+	return 64 + per * v->size();
+}
+
+void ValueResidency::attach(BackingStore* bs)
+{
+	std::unique_lock<std::shared_mutex> lck(_store_mtx);
+	_store = bs;
+}
+
+ValuePtr ValueResidency::placeholder(void) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _lazy;
+}
+
+void ValueResidency::set_lazy(bool lazy, size_t budget)
+{
+	std::list<Entry> victims;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_enabled = lazy;
+		_budget = budget;
+
+		// Keep the placeholder, even when disabled, so that the
+		// Values that are still lazy can be fetched.
+		if (nullptr == _lazy)
+			_lazy = createLazyValue(shared_from_this());
+
+		if (0 == _budget)
+		{
+			_fetched.clear();
+			_resident = 0;
+		}
+		while (_budget < _resident and not _fetched.empty())
+		{
+			_resident -= _fetched.front().bytes;
+			victims.splice(victims.end(), _fetched, _fetched.begin());
+		}
+	}
+	evict(victims);
+}
+
+// ====================================================================
+
+/// Put the placeholder back, wherever the fetched Value is still
+/// in place. Must be called without holding the lock, as this takes
+/// the locks on the Atoms.
+void ValueResidency::evict(std::list<Entry>& victims)
+{
+	if (victims.empty()) return;
+	ValuePtr lazy(placeholder());
+	for (const Entry& e : victims)
+	{
+		Handle h(e.atom.lock());
+		ValuePtr v(e.value.lock());
+		if (nullptr == h or nullptr == v) continue;
+		if (h->swapValue(e.key, v, lazy)) _evictions++;
+	}
+}
+
+void ValueResidency::evict_all(void)
+{
+	std::list<Entry> victims;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		victims.swap(_fetched);
+		_resident = 0;
+	}
+	evict(victims);
+}
+
+// ====================================================================
+
+ValuePtr ValueResidency::load_value(const Handle& h, const Handle& key,
+                                    const ValuePtr& lazy)
+{
+	// Fetch onto a bare copy of the Atom, so that the fetch is not
+	// seen as a change to the Atom itself.
+	Handle bare(h->is_node() ?
+		createNode(h->get_type(), std::string(h->get_name())) :
+		createLink(h->getOutgoingSet(), h->get_type()));
+	{
+		// If the storage is gone, leave the LazyValue in place; it
+		// can be fetched after the storage is opened again.
+		std::shared_lock<std::shared_mutex> lck(_store_mtx);
+		if (nullptr == _store) return nullptr;
+		_store->loadValue(bare, key);
+	}
+	ValuePtr v(bare->getValue(key));
+
+	if (nullptr == v) _misses++;
+	else _loads++;
+
+	// Another thread may have fetched it (or set it) already.
+	if (not h->swapValue(key, lazy, v))
+		return h->getValue(key);
+
+	if (nullptr == v) return v;
+
+	std::list<Entry> victims;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (0 == _budget) return v;
+
+		size_t bytes = footprint(v);
+		_fetched.push_back({h, key, v, bytes});
+		_resident += bytes;
+
+		// Never evict the one that was just fetched.
+		while (_budget < _resident and 1 < _fetched.size())
+		{
+			_resident -= _fetched.front().bytes;
+			victims.splice(victims.end(), _fetched, _fetched.begin());
+		}
+	}
+	evict(victims);
+	return v;
+}
+
+// ====================================================================
+
+std::string ValueResidency::stats(void) const
+{
+	if (not _enabled) return "";
+
+	size_t budget, resident, nfetched;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		budget = _budget;
+		resident = _resident;
+		nfetched = _fetched.size();
+	}
+
+	std::string rs = "Lazy values: budget=";
+	rs += (0 < budget) ? std::to_string(budget) + " bytes" : "unlimited";
+	rs += " resident=" + std::to_string(resident) + " bytes in ";
+	rs += std::to_string(nfetched) + " values\n";
+	rs += "Lazy values: fetched=" + std::to_string(_loads);
+	rs += " not found=" + std::to_string(_misses);
+	rs += " evicted=" + std::to_string(_evictions) + "\n";
+	return rs;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,124 @@
+/*
+ * opencog/persist/api/ValueResidency.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_VALUE_RESIDENCY_H
+#define _OPENCOG_VALUE_RESIDENCY_H
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/LazyValue.h>
+
+namespace opencog
+{
+/** \addtogroup grp_persist
+ *  @{
+ */
+
+class BackingStore;
+
+/**
+ * Fetch Values from storage on demand, and keep track of how much RAM
+ * the fetched Values use.
+ *
+ * When enabled, storage backends that support it place a LazyValue on
+ * each key of each Atom that they load, instead of the Value itself.
+ * The first `getValue()` on that key calls back to here, and the Value
+ * is fetched with `BackingStore::loadValue()`.
+ *
+ * If a budget is given, then the fetched Values are remembered, in the
+ * order that they were fetched. When their total size goes over the
+ * budget, the oldest are evicted: they are replaced by the LazyValue
+ * again, so that they will be fetched again if asked for. Values that
+ * were changed after being fetched are never evicted; they belong to
+ * the AtomSpace, and not to the storage. The sizes are estimates.
+ *
+ * The LazyValues may outlive the StorageNode, or be asked for while it
+ * is closed. The StorageNode detaches itself when closed or deleted;
+ * after that, fetches return null, and leave the LazyValue in place.
+ */
+class ValueResidency :
+	public ValueLoader,
+	public std::enable_shared_from_this<ValueResidency>
+{
+	struct Entry
+	{
+		std::weak_ptr<Atom> atom;
+		Handle key;
+		std::weak_ptr<Value> value;
+		size_t bytes;
+	};
+
+	// Held shared for the duration of each fetch, so that detach()
+	// waits for the fetches that are under way.
+	std::shared_mutex _store_mtx;
+	BackingStore* _store;
+
+	mutable std::mutex _mtx;
+	std::atomic<bool> _enabled;
+	size_t _budget;
+	size_t _resident;
+	std::list<Entry> _fetched;
+	ValuePtr _lazy;
+
+	std::atomic<size_t> _loads;
+	std::atomic<size_t> _misses;
+	std::atomic<size_t> _evictions;
+
+	void evict(std::list<Entry>&);
+
+public:
+	ValueResidency(BackingStore*);
+	virtual ~ValueResidency() {}
+
+	/// Enable or disable lazy loading. The budget is in bytes; zero
+	/// means that nothing is ever evicted.
+	void set_lazy(bool, size_t budget);
+	bool enabled(void) const { return _enabled; }
+
+	/// The LazyValue to be placed on Atoms.
+	ValuePtr placeholder(void) const;
+
+	/// Connect to, or disconnect from, the storage that Values are
+	/// fetched from.
+	void attach(BackingStore*);
+	void detach(void) { attach(nullptr); }
+
+	/// Evict all fetched Values that have not been changed.
+	void evict_all(void);
+
+	virtual ValuePtr load_value(const Handle&, const Handle&,
+	                            const ValuePtr&);
+
+	std::string stats(void) const;
+};
+
+typedef std::shared_ptr<ValueResidency> ValueResidencyPtr;
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_VALUE_RESIDENCY_H
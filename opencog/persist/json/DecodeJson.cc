@@ -20,7 +20,10 @@
  * Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
-#include <iomanip>
+#include <ctype.h>
+
+#include <algorithm>
+#include <string_view>
 
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atoms/base/Node.h>
@@ -67,113 +70,272 @@ Type Json::decode_type(const std::string& tna, size_t& pos)
 }
 
 /* ================================================================== */
+// A small, single-pass JSON scanner. It works directly on the input,
+// without creating substrings, except for the final, unescaped Node
+// names. This does NOT use any external JSON decoder libraries because
+// those libs don't really make anything simpler, and also we don't need
+// most of the features that they offer, and also I don't want more
+// dependencies in the AtomSpace.
+//
+// All of the scanning functions return false (or a null Handle) if
+// the input is not what was expected; malformed input is not an
+// exceptional event for a network server.
 
-/// Extracts Node name-string. Given the string `s`, this updates
-/// the `l` and `r` values such that `l` points at the first
-/// non-whitespace character of the name, and `r` points at the last.
-/// The string is considered to start *after* the first quote, and ends
-/// just before the last quote. In this case, escaped quotes \" are
-/// ignored (are considered to be part of the string).
-///
-/// This returns the unescaped node name.
-///
-std::string Json::get_node_name(const std::string& s,
-                                size_t& l, size_t& r)
+namespace {
+
+class JsonScanner
 {
-	// Advance past whitespace.
-	while (l < r and (s[l] == ' ' or s[l] == '\t' or s[l] == '\n')) l++;
-
-	l++;
-	size_t p = l;
-	for (; p < r and (s[p] != '"' or ((0 < p) and (s[p - 1] == '\\'))); p++);
-	r = p;
-
-	// We use std::quoted() to unescape embedded quotes.
-	// Unescaping works ONLY if the leading character is a quote!
-	// So readjust left and right to pick those up.
-	if ('"' == s[l-1]) l--; // grab leading quote, for std::quoted().
-	if ('"' == s[r]) r++;   // step past trailing quote.
-	std::stringstream ss;
-	std::string name;
-	ss << s.substr(l, r-l);
-	ss >> std::quoted(name);
-	return name;
-}
+	std::string_view _s;
+	size_t _p;
 
-/* ================================================================== */
+public:
+	JsonScanner(std::string_view s, size_t p) : _s(s), _p(p) {}
+	size_t pos(void) const { return _p; }
 
-/// Convert an Atomese JSON expression into a C++ Atom.
-/// For example: `{ "type": "Concept", "name": "foo" }`
-/// will return the corresponding atom.
-///
-/// The string to decode is `s`, beginning at location `l` and using `r`
-/// as a hint for the end of the expression.
-///
-/// XXX FIXME. This is a quick hack. It will be confused be embedded
-/// quotes n stuff. This does NOT use any external JSON decoder
-/// libraries because those libs don't really make anything simpler,
-/// and also we don't need most of the features that they offer, and
-/// also I don't want more dependencies in the AtomSpace.
-///
-Handle Json::decode_atom(const std::string& s,
-                         size_t& l, size_t& r)
-{
-	l = s.find("{", l);
-	if (std::string::npos == l) return Handle::UNDEFINED;
+	void skip_ws(void)
+	{
+		while (_p < _s.size() and
+		       (' ' == _s[_p] or '\n' == _s[_p] or
+		        '\t' == _s[_p] or '\r' == _s[_p]))
+			_p++;
+	}
 
-	size_t tpos = s.find("\"type\":", l);
-	if (std::string::npos == tpos) return Handle::UNDEFINED;
-	tpos += 7;  // skip past "type":
+	bool eat(char c)
+	{
+		skip_ws();
+		if (_p < _s.size() and c == _s[_p]) { _p++; return true; }
+		return false;
+	}
 
-	Type t = NOTYPE;
-	try {
-		t = Json::decode_type(s, tpos);
+	/// Scan a string, and return what is between the quotes, still
+	/// escaped. Sets `escaped` if there were any backslashes in it.
+	bool raw_string(std::string_view& sv, bool& escaped)
+	{
+		if (not eat('"')) return false;
+		size_t start = _p;
+		escaped = false;
+		while (_p < _s.size() and '"' != _s[_p])
+		{
+			if ('\\' == _s[_p]) { escaped = true; _p++; }
+			_p++;
+		}
+		if (_s.size() <= _p) return false;
+		sv = _s.substr(start, _p - start);
+		_p++;
+		return true;
 	}
-	catch(...) {
-		return Handle::UNDEFINED;
+
+	bool string(std::string& str)
+	{
+		std::string_view sv;
+		bool escaped;
+		if (not raw_string(sv, escaped)) return false;
+		if (not escaped) { str.assign(sv.data(), sv.size()); return true; }
+		unescape(sv, str);
+		return true;
 	}
 
-	if (nameserver().isA(t, NODE))
+	/// Skip over any kind of value: strings, numbers, objects, arrays.
+	bool skip_value(void)
 	{
-		size_t apos = s.find("\"name\":", l);
-		if (std::string::npos == apos) return Handle::UNDEFINED;
-		apos += 7;  // skip past "name":
+		skip_ws();
+		int depth = 0;
+		while (_p < _s.size())
+		{
+			char c = _s[_p];
+			if ('"' == c)
+			{
+				std::string_view sv;
+				bool escaped;
+				if (not raw_string(sv, escaped)) return false;
+				if (0 == depth) return true;
+				continue;
+			}
 
-		apos = s.find_first_not_of(" \n\t", apos);
-		std::string name = Json::get_node_name(s, apos, r);
+			// The end of a number, or of true, false, null.
+			if (0 == depth and (',' == c or '}' == c or ']' == c))
+				return true;
 
-		r = s.find("}", r); // Move past the closing paren
-		return createNode(t, std::move(name));
+			_p++;
+			if ('{' == c or '[' == c) depth++;
+			else if ('}' == c or ']' == c)
+			{
+				depth--;
+				if (0 == depth) return true;
+			}
+		}
+		return 0 == depth;
 	}
 
-	if (nameserver().isA(t, LINK))
+	static void unescape(std::string_view, std::string&);
+	Handle atom(void);
+};
+
+/// Append the UTF-8 encoding of the code point.
+static void utf8(uint32_t cp, std::string& str)
+{
+	if (cp < 0x80) { str += (char) cp; return; }
+	if (cp < 0x800)
 	{
-		size_t opos = s.find("\"outgoing\":", l);
-		if (std::string::npos == opos) return Handle::UNDEFINED;
-		opos += 11;  // skip past "outgoing":
+		str += (char) (0xc0 | (cp >> 6));
+		str += (char) (0x80 | (cp & 0x3f));
+		return;
+	}
+	if (cp < 0x10000)
+	{
+		str += (char) (0xe0 | (cp >> 12));
+		str += (char) (0x80 | ((cp >> 6) & 0x3f));
+		str += (char) (0x80 | (cp & 0x3f));
+		return;
+	}
+	str += (char) (0xf0 | (cp >> 18));
+	str += (char) (0x80 | ((cp >> 12) & 0x3f));
+	str += (char) (0x80 | ((cp >> 6) & 0x3f));
+	str += (char) (0x80 | (cp & 0x3f));
+}
 
-		l = s.find("{", opos);
-		size_t epos = r;
+/// Undo the JSON backslash escapes. Unknown escapes stand for the
+/// escaped character itself, same as `std::quoted()` does.
+void JsonScanner::unescape(std::string_view sv, std::string& str)
+{
+	str.clear();
+	str.reserve(sv.size());
+	size_t len = sv.size();
+	for (size_t i = 0; i < len; i++)
+	{
+		char c = sv[i];
+		if ('\\' != c or len <= i+1) { str += c; continue; }
 
-		HandleSeq hs;
+		c = sv[++i];
+		switch (c)
+		{
+			case 'n': str += '\n'; break;
+			case 't': str += '\t'; break;
+			case 'r': str += '\r'; break;
+			case 'b': str += '\b'; break;
+			case 'f': str += '\f'; break;
+			case 'u':
+			{
+				uint32_t cp = 0;
+				size_t j = i+1;
+				for (; j < len and j < i+5 and isxdigit(sv[j]); j++)
+					cp = 16*cp + (isdigit(sv[j]) ?
+						sv[j] - '0' : (tolower(sv[j]) - 'a' + 10));
+				if (j != i+5) { str += c; break; }
+				utf8(cp, str);
+				i = j - 1;
+				break;
+			}
+			default: str += c;
+		}
+	}
+}
+
+/// Decode an object of the form `{"type": "Concept", "name": "foo"}`
+/// or `{"type": "List", "outgoing": [ ... ]}`. The keys may appear in
+/// any order; unknown keys are ignored. Upon return, the scanner is
+/// positioned just past the closing brace.
+Handle JsonScanner::atom(void)
+{
+	if (not eat('{')) return Handle::UNDEFINED;
+
+	Type t = NOTYPE;
+	std::string name;
+	bool have_name = false;
+	HandleSeq oset;
+
+	if (eat('}')) return Handle::UNDEFINED;
+	do
+	{
+		std::string_view key;
+		bool escaped;
+		if (not raw_string(key, escaped)) return Handle::UNDEFINED;
+		if (not eat(':')) return Handle::UNDEFINED;
 
-		while (std::string::npos != r)
+		if (0 == key.compare("type"))
 		{
-			Handle ho = Json::decode_atom(s, l, r);
-			if (nullptr == ho) return Handle::UNDEFINED;
-			hs.push_back(ho);
-
-			// Look for the comma
-			l = s.find(",", r);
-			if (std::string::npos == l) break;
-			l ++;
-			r = epos;
+			std::string_view tname;
+			if (not raw_string(tname, escaped)) return Handle::UNDEFINED;
+			t = nameserver().getType(std::string(tname));
+			if (NOTYPE == t) return Handle::UNDEFINED;
 		}
+		else if (0 == key.compare("name"))
+		{
+			if (not string(name)) return Handle::UNDEFINED;
+			have_name = true;
+		}
+		else if (0 == key.compare("outgoing"))
+		{
+			if (not eat('[')) return Handle::UNDEFINED;
+			if (not eat(']'))
+			{
+				do
+				{
+					Handle ho(atom());
+					if (nullptr == ho) return Handle::UNDEFINED;
+					oset.emplace_back(std::move(ho));
+				} while (eat(','));
+				if (not eat(']')) return Handle::UNDEFINED;
+			}
+		}
+		else if (not skip_value()) return Handle::UNDEFINED;
+	} while (eat(','));
 
-		return createLink(std::move(hs), t);
-	}
+	if (not eat('}')) return Handle::UNDEFINED;
+
+	if (have_name and nameserver().isA(t, NODE))
+		return createNode(t, std::move(name));
+
+	if (nameserver().isA(t, LINK))
+		return createLink(std::move(oset), t);
 
 	return Handle::UNDEFINED;
 }
 
+} // anonymous namespace
+
+/* ================================================================== */
+
+/// Extracts Node name-string. Given the string `s`, with `l` pointing
+/// at (or at whitespace before) the opening quote of the name, this
+/// returns the unescaped name, and updates `l` to point at the opening
+/// quote, and `r` to point just past the closing quote. Escaped quotes
+/// \" are considered to be part of the string.
+///
+std::string Json::get_node_name(const std::string& s,
+                                size_t& l, size_t& r)
+{
+	JsonScanner scan(std::string_view(s.data(), std::min(r, s.size())), l);
+	scan.skip_ws();
+	l = scan.pos();
+
+	std::string name;
+	scan.string(name);
+	r = scan.pos();
+	return name;
+}
+
+/* ================================================================== */
+
+/// Convert an Atomese JSON expression into a C++ Atom.
+/// For example: `{ "type": "Concept", "name": "foo" }`
+/// will return the corresponding atom.
+///
+/// The string to decode is `s`, beginning at location `l` and using `r`
+/// as the end of the expression. Upon return, `l` points at the opening
+/// brace and `r` at the closing brace. If the expression is not a valid
+/// Atom, the null Handle is returned.
+///
+Handle Json::decode_atom(const std::string& s,
+                         size_t& l, size_t& r)
+{
+	l = s.find("{", l);
+	if (std::string::npos == l) return Handle::UNDEFINED;
+
+	JsonScanner scan(std::string_view(s.data(), std::min(r, s.size())), l);
+	Handle h(scan.atom());
+	if (h) r = scan.pos() - 1;
+	return h;
+}
+
 /* ============================= END OF FILE ================= */
@@ -23,6 +23,7 @@
 #include <iomanip>
 
 #include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/value/FloatCodec.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
@@ -34,167 +35,219 @@
 using namespace opencog;
 
 /* ================================================================== */
+// The encoders below all append to the end of a caller-supplied
+// buffer, so that big replies are built up in place. The
+// string-returning versions are just wrappers around these.
+//
 // Atom printers that do NOT print associated Values.
+//
+// The indentation is the `indent` string, followed by `extra` blanks;
+// this avoids creating a new indentation string at each level.
 
-static std::string prt_node(const Handle& h, const std::string& indent)
+static void prt_indent(std::string& out, const std::string& indent,
+                       size_t extra)
 {
-	std::stringstream ss;
-	ss << indent << "{\n" << indent << "  \"type\": \""
-		<< nameserver().getTypeName(h->get_type())
-		<< "\",\n" << indent << "  \"name\": ";
-	ss << std::quoted(h->get_name());
-	ss << "\n" << indent << "}";
-
-	return ss.str();
+	out += indent;
+	out.append(extra, ' ');
 }
 
-static std::string prt_atom(const Handle&, const std::string& = "");
+static void prt_atom(std::string&, const Handle&,
+                     const std::string&, size_t);
 
-static std::string prt_link(const Handle& h, const std::string& indent)
+static void prt_node(std::string& out, const Handle& h,
+                     const std::string& indent, size_t extra)
 {
-	std::string idt = indent + "  ";
-	std::string txt = indent + "{\n" + idt + "\"type\": \""
-		+ nameserver().getTypeName(h->get_type()) + "\",\n"
-		+ idt + "\"outgoing\": [\n";
+	prt_indent(out, indent, extra);
+	out += "{\n";
+	prt_indent(out, indent, extra);
+	out += "  \"type\": \"";
+	out += nameserver().getTypeName(h->get_type());
+	out += "\",\n";
+	prt_indent(out, indent, extra);
+	out += "  \"name\": ";
+	print_quoted(out, h->get_name());
+	out += '\n';
+	prt_indent(out, indent, extra);
+	out += '}';
+}
+
+static void prt_link(std::string& out, const Handle& h,
+                     const std::string& indent, size_t extra)
+{
+	prt_indent(out, indent, extra);
+	out += "{\n";
+	prt_indent(out, indent, extra+2);
+	out += "\"type\": \"";
+	out += nameserver().getTypeName(h->get_type());
+	out += "\",\n";
+	prt_indent(out, indent, extra+2);
+	out += "\"outgoing\": [\n";
 
 	bool first = true;
 	for (const Handle& ho : h->getOutgoingSet())
 	{
-		if (not first) { txt += ",\n"; } else { first = false; }
-		txt += prt_atom(ho, idt + "  ");
+		if (not first) { out += ",\n"; } else { first = false; }
+		prt_atom(out, ho, indent, extra+4);
 	}
-	txt += "]}";
-	return txt;
+	out += "]}";
 }
 
-static std::string prt_atom(const Handle& h, const std::string& indent)
+static void prt_atom(std::string& out, const Handle& h,
+                     const std::string& indent, size_t extra)
+{
+	if (h->is_node()) prt_node(out, h, indent, extra);
+	else prt_link(out, h, indent, extra);
+}
+
+/// Append the Atom to the buffer. It does NOT print any of the
+/// associated values; use `dump_atom()` to get those.
+void Json::encode_atom(std::string& out, const Handle& h,
+                       const std::string& indent)
 {
-	if (h->is_node()) return prt_node(h, indent);
-	return prt_link(h, indent);
+	prt_atom(out, h, indent, 0);
 }
 
 /// Convert the Atom into a string. It does NOT print any of the
 /// associated values; use `dump_atom()` to get those.
 std::string Json::encode_atom(const Handle& h, const std::string& indent)
 {
-	return prt_atom(h, indent);
+	std::string out;
+	prt_atom(out, h, indent, 0);
+	return out;
 }
 
-/// Convert value (or Atom) into a string.
-std::string Json::encode_value(const ValuePtr& v, const std::string& indent)
+/// Append the value (or Atom) to the buffer.
+void Json::encode_value(std::string& out, const ValuePtr& v,
+                        const std::string& indent)
 {
 	// Empty values are used to erase keys from atoms.
-	if (nullptr == v) return "false";
+	if (nullptr == v) { out += "false"; return; }
 
-	if (nameserver().isA(v->get_type(), FLOAT_VALUE))
+	Type t = v->get_type();
+	if (nameserver().isA(t, FLOAT_VALUE))
 	{
-		// The FloatValue to_string() method prints out a high-precision
-		// form of the value, as compared to SimpleTruthValue, which
-		// only prints 6 digits and breaks the unit tests.
-		FloatValuePtr fv(FloatValueCast(v));
-		return fv->FloatValue::to_string();
+		// Print the full precision, as compared to SimpleTruthValue,
+		// which only prints 6 digits and breaks the unit tests.
+		out += '(';
+		out += nameserver().getTypeName(t);
+		for (double d : FloatValueCast(v)->value())
+		{
+			out += ' ';
+			print_double(out, d);
+		}
+		out += ')';
+		return;
 	}
 
 	if (not v->is_atom())
-		return v->to_short_string();
-	return prt_atom(HandleCast(v));
+	{
+		out += v->to_short_string();
+		return;
+	}
+	prt_atom(out, HandleCast(v), "", 0);
+}
+
+/// Convert value (or Atom) into a string.
+std::string Json::encode_value(const ValuePtr& v, const std::string& indent)
+{
+	std::string out;
+	encode_value(out, v, indent);
+	return out;
 }
 
 /* ================================================================== */
 
-/// Get all of the values on an Atom and print them as an
-/// association list.
-std::string Json::encode_atom_values(const Handle& h)
+/// Append all of the values on an Atom, as an association list.
+void Json::encode_atom_values(std::string& out, const Handle& h)
 {
-	std::stringstream rv;
-
-	rv << "(alist ";
+	out += "(alist ";
 	for (const Handle& k: h->getKeys())
 	{
-		ValuePtr p = h->getValue(k);
-		rv << "(cons " << prt_atom(k) << encode_value(p) << ")";
+		out += "(cons ";
+		prt_atom(out, k, "", 0);
+		encode_value(out, h->getValue(k));
+		out += ')';
 	}
-	rv << ")";
-	return rv.str();
+	out += ')';
 }
 
-/* ================================================================== */
-// Atom printers that encode ALL associated Values.
-
-static std::string dump_node(const Handle& h)
+/// Get all of the values on an Atom and print them as an
+/// association list.
+std::string Json::encode_atom_values(const Handle& h)
 {
-	std::stringstream ss;
-	ss << "(" << nameserver().getTypeName(h->get_type())
-		<< " " << std::quoted(h->get_name());
-
-	if (h->haveValues())
-		ss << " " << Json::encode_atom_values(h);
-
-	ss << ")";
-
-	return ss.str();
+	std::string out;
+	encode_atom_values(out, h);
+	return out;
 }
 
-static std::string dump_link(const Handle& h)
+/* ================================================================== */
+// Atom printers that encode ALL associated Values.
+
+/// Append the Atom, and all of the values attached to it.
+/// Similar to `encode_atom()`, except that it also prints the values.
+/// Values on going Atoms in a Link are NOT dumped!
+/// This is in order to avoid duplication.
+void Json::dump_atom(std::string& out, const Handle& h)
 {
-	std::string txt = "(" + nameserver().getTypeName(h->get_type()) + " ";
-	for (const Handle& ho : h->getOutgoingSet())
-		txt += prt_atom(ho);
+	out += '(';
+	out += nameserver().getTypeName(h->get_type());
+	out += ' ';
+	if (h->is_node())
+		print_quoted(out, h->get_name());
+	else
+		for (const Handle& ho : h->getOutgoingSet())
+			prt_atom(out, ho, "", 0);
 
 	if (h->haveValues())
 	{
-		txt += " ";
-		txt += Json::encode_atom_values(h);
+		out += ' ';
+		encode_atom_values(out, h);
 	}
 
-	txt += ")";
-	return txt;
+	out += ')';
 }
 
 /// Print the Atom, and all of the values attached to it.
-/// Similar to `encode_atom()`, except that it also prints the values.
-/// Values on going Atoms in a Link are NOT dumped!
-/// This is in order to avoid duplication.
 std::string Json::dump_atom(const Handle& h)
 {
-	if (h->is_node()) return dump_node(h);
-	return dump_link(h);
+	std::string out;
+	dump_atom(out, h);
+	return out;
 }
 
 /* ================================================================== */
 // Atom printers that encode only one associated Value.
 
-static std::string dump_vnode(const Handle& h, const Handle& key)
-{
-	std::stringstream ss;
-	ss << "(" << nameserver().getTypeName(h->get_type())
-		<< " " << std::quoted(h->get_name());
-
-	ValuePtr p = h->getValue(key);
-	if (nullptr != p)
-		ss << " (alist (cons " << prt_atom(key) << Json::encode_value(p) << ")))";
-
-	return ss.str();
-}
-
-static std::string dump_vlink(const Handle& h, const Handle& key)
+/// Append the Atom, and just one of the values attached to it.
+void Json::dump_vatom(std::string& out, const Handle& h, const Handle& key)
 {
-	std::string txt = "(" + nameserver().getTypeName(h->get_type()) + " ";
-	for (const Handle& ho : h->getOutgoingSet())
-		txt += prt_atom(ho);
+	out += '(';
+	out += nameserver().getTypeName(h->get_type());
+	out += ' ';
+	if (h->is_node())
+		print_quoted(out, h->get_name());
+	else
+		for (const Handle& ho : h->getOutgoingSet())
+			prt_atom(out, ho, "", 0);
 
 	ValuePtr p = h->getValue(key);
 	if (nullptr != p)
-		txt += " (alist (cons " + prt_atom(key) + Json::encode_value(p) + ")))";
+	{
+		out += " (alist (cons ";
+		prt_atom(out, key, "", 0);
+		encode_value(out, p);
+		out += "))";
+	}
 
-	return txt;
+	out += ')';
 }
 
 /// Print the Atom, and just one of the values attached to it.
 std::string Json::dump_vatom(const Handle& h, const Handle& key)
 {
-	if (h->is_node()) return dump_vnode(h, key);
-	return dump_vlink(h, key);
+	std::string out;
+	dump_vatom(out, h, key);
+	return out;
 }
 
 /* ============================= END OF FILE ================= */
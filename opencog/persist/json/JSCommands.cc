@@ -22,9 +22,12 @@
 
 #include <time.h>
 
+#include <algorithm>
+#include <exception>
 #include <functional>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Link.h>
@@ -32,6 +35,7 @@
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/query/SearchPool.h>
 
 #include "JSCommands.h"
 #include "Json.h"
@@ -43,12 +47,147 @@ static std::string reterr(const std::string& cmd)
 	return "JSON/JavaScript function not supported: >>" + cmd + "<<\n";
 }
 
+/// Split `cmds` into separate statements. Statements are separated
+/// by semicolons or newlines, as in Javascript. Empty statements and
+/// comments are dropped.
+static std::vector<std::string> split_statements(const std::string& cmds)
+{
+	std::vector<std::string> stmts;
+	size_t len = cmds.size();
+	size_t start = 0;
+	int depth = 0;
+	bool quoted = false;
+	for (size_t p = 0; p <= len; p++)
+	{
+		size_t end = p;
+		if (p < len)
+		{
+			char c = cmds[p];
+			if (quoted)
+			{
+				if ('\\' == c) p++;
+				else if ('"' == c) quoted = false;
+				continue;
+			}
+			if ('"' == c) { quoted = true; continue; }
+			if ('(' == c or '[' == c or '{' == c) { depth++; continue; }
+			if (')' == c or ']' == c or '}' == c) { depth--; continue; }
+
+			// Comments run to the end of the line.
+			if ('/' == c and p+1 < len and '/' == cmds[p+1])
+			{
+				p = cmds.find('\n', p);
+				if (std::string::npos == p) p = len;
+			}
+			else if (0 < depth or (';' != c and '\n' != c))
+				continue;
+		}
+
+		size_t l = cmds.find_first_not_of(" \t\n", start);
+		if (std::string::npos != l and l < end)
+		{
+			size_t r = cmds.find_last_not_of(" \t\n", end-1);
+			stmts.emplace_back(cmds.substr(l, r-l+1));
+		}
+		start = p + 1;
+	}
+	return stmts;
+}
+
+// Batches shorter than this are not worth handing to the thread pool.
+#define MIN_PARALLEL 64
+
+// Each thread taking part gets about this many chunks, so that a
+// thread that finishes early can take over some of the work of a
+// thread that is running slow statements.
+#define CHUNKS_PER_THREAD 4
+
+/// Run the statements, and append the replies to `rv`, as a JSON list.
+/// None of the supported commands alter the AtomSpace, and so, for
+/// large batches, the statements are split into a few contiguous
+/// chunks per thread, and are run concurrently, on the SearchPool
+/// threads. The replies to each chunk are appended to one buffer,
+/// instead of creating one string per reply.
+static void run_batch(AtomSpace* as, const std::vector<std::string>& stmts,
+                      std::string& rv)
+{
+	size_t n = stmts.size();
+	if (n < MIN_PARALLEL)
+	{
+		rv += "[";
+		for (size_t i = 0; i < n; i++)
+		{
+			if (0 < i) rv += ",";
+			JSCommands::interpret(as, stmts[i], rv);
+		}
+		rv += "]\n";
+		return;
+	}
+
+	SearchPool& pool = SearchPool::instance();
+	size_t nparts = std::min(pool.concurrency(), n);
+	size_t nchunks = std::min(CHUNKS_PER_THREAD * nparts, n);
+	size_t chunk = (n + nchunks - 1) / nchunks;
+	nchunks = (n + chunk - 1) / chunk;
+
+	std::vector<std::string> bufs(nchunks);
+	std::vector<std::exception_ptr> errs(nchunks);
+	pool.run(nchunks, nparts, [&](size_t, size_t k) -> bool
+	{
+		try
+		{
+			size_t lo = k * chunk;
+			size_t hi = std::min(lo + chunk, n);
+			for (size_t i = lo; i < hi; i++)
+			{
+				if (0 < i) bufs[k] += ",";
+				JSCommands::interpret(as, stmts[i], bufs[k]);
+			}
+		}
+		catch (...)
+		{
+			errs[k] = std::current_exception();
+		}
+		return false;
+	});
+
+	// Report the first failure, in statement order.
+	for (size_t k = 0; k < nchunks; k++)
+		if (errs[k]) std::rethrow_exception(errs[k]);
+
+	rv += "[";
+	for (const std::string& b : bufs)
+		rv += b;
+	rv += "]\n";
+}
+
+void JSCommands::interpret_batch(AtomSpace* as, const std::string& cmds,
+                                 std::string& rv)
+{
+	run_batch(as, split_statements(cmds), rv);
+}
+
 /// The cogserver provides a network API to send/receive Atoms, encoded
 /// as JSON, over the internet. This is NOT as efficient as the
 /// s-expression API, but is more convenient for web developers.
+///
+/// Several statements, separated by semicolons, are run as a batch,
+/// and the replies are returned as a JSON list.
 //
 std::string JSCommands::interpret_command(AtomSpace* as,
                                           const std::string& cmd)
+{
+	std::string rv;
+	std::vector<std::string> stmts(split_statements(cmd));
+	if (1 < stmts.size())
+		run_batch(as, stmts, rv);
+	else
+		interpret(as, cmd, rv);
+	return rv;
+}
+
+void JSCommands::interpret(AtomSpace* as, const std::string& cmd,
+                           std::string& rv)
 {
 	// Fast dispatch. There should be zero hash collisions
 	// here. If there are, we are in trouble. (Well, if there
@@ -61,18 +200,18 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 	static const size_t gtval = std::hash<std::string>{}("getValues");
 
 	// Ignore comments, blank lines
-	if ('/' == cmd[0]) return "";
-	if ('\n' == cmd[0]) return "";
+	if ('/' == cmd[0]) return;
+	if ('\n' == cmd[0]) return;
 
 	// Find the command and dispatch
 	size_t cpos = cmd.find_first_of(".");
-	if (std::string::npos == cpos) return reterr(cmd);
+	if (std::string::npos == cpos) { rv += reterr(cmd); return; }
 
 	size_t pos = cmd.find_first_not_of(". \n\t", cpos);
-	if (std::string::npos == pos) return reterr(cmd);
+	if (std::string::npos == pos) { rv += reterr(cmd); return; }
 
 	size_t epos = cmd.find_first_of("( \n\t", pos);
-	if (std::string::npos == epos) return reterr(cmd);
+	if (std::string::npos == epos) { rv += reterr(cmd); return; }
 
 	size_t act = std::hash<std::string>{}(cmd.substr(pos, epos-pos));
 
@@ -81,14 +220,15 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 	if (gtatm == act)
 	{
 		pos = cmd.find_first_of("(", epos);
-		if (std::string::npos == pos) return reterr(cmd);
+		if (std::string::npos == pos) { rv += reterr(cmd); return; }
 		pos++;
 		Type t = NOTYPE;
 		try {
 			t = Json::decode_type(cmd, pos);
 		}
 		catch(...) {
-			return "Unknown type: " + cmd.substr(pos);
+			rv += "Unknown type: " + cmd.substr(pos);
+			return;
 		}
 
 		pos = cmd.find_first_not_of(",) \n\t", pos);
@@ -98,17 +238,17 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 				0 == cmd.compare(pos, 5, "false")))
 			get_subtypes = false;
 
-		std::string rv = "[\n";
+		rv += "[\n";
 		HandleSeq hset;
 		as->get_handles_by_type(hset, t, get_subtypes);
 		bool first = true;
 		for (const Handle& h: hset)
 		{
 			if (not first) { rv += ",\n"; } else { first = false; }
-			rv += Json::encode_atom(h, "  ");
+			Json::encode_atom(rv, h, "  ");
 		}
 		rv += "]\n";
-		return rv;
+		return;
 	}
 
 	// -----------------------------------------------
@@ -116,26 +256,31 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 	if (haven == act)
 	{
 		pos = cmd.find_first_of("(", epos);
-		if (std::string::npos == pos) return reterr(cmd);
+		if (std::string::npos == pos) { rv += reterr(cmd); return; }
 		pos++;
 		Type t = NOTYPE;
 		try {
 			t = Json::decode_type(cmd, pos);
 		}
 		catch(...) {
-			return "Unknown type: " + cmd.substr(pos);
+			rv += "Unknown type: " + cmd.substr(pos);
+			return;
 		}
 
 		if (not nameserver().isA(t, NODE))
-			return "Type is not a Node type: " + cmd.substr(epos);
+		{
+			rv += "Type is not a Node type: " + cmd.substr(epos);
+			return;
+		}
 
 		pos = cmd.find_first_not_of(",) \n\t", pos);
 		epos = cmd.size();
 		std::string name = Json::get_node_name(cmd, pos, epos);
 		Handle h = as->get_node(t, std::move(name));
 
-		if (nullptr == h) return "false\n";
-		return "true\n";
+		if (nullptr == h) { rv += "false\n"; return; }
+		rv += "true\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -143,18 +288,22 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 	if (havel == act)
 	{
 		pos = cmd.find_first_of("(", epos);
-		if (std::string::npos == pos) return reterr(cmd);
+		if (std::string::npos == pos) { rv += reterr(cmd); return; }
 		pos++;
 		Type t = NOTYPE;
 		try {
 			t = Json::decode_type(cmd, pos);
 		}
 		catch(...) {
-			return "Unknown type: " + cmd.substr(pos);
+			rv += "Unknown type: " + cmd.substr(pos);
+			return;
 		}
 
 		if (not nameserver().isA(t, LINK))
-			return "Type is not a Link type: " + cmd.substr(epos);
+		{
+			rv += "Type is not a Link type: " + cmd.substr(epos);
+			return;
+		}
 
 		pos = cmd.find_first_not_of(", \n\t", pos);
 		epos = cmd.size();
@@ -166,7 +315,7 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 		while (std::string::npos != r)
 		{
 			Handle ho = Json::decode_atom(cmd, l, r);
-			if (nullptr == ho) return "false\n";
+			if (nullptr == ho) { rv += "false\n"; return; }
 			hs.push_back(ho);
 
 			// Look for the comma
@@ -177,8 +326,9 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 		}
 		Handle h = as->get_link(t, std::move(hs));
 
-		if (nullptr == h) return "false\n";
-		return "true\n";
+		if (nullptr == h) { rv += "false\n"; return; }
+		rv += "true\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -186,17 +336,18 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 	if (havea == act)
 	{
 		pos = cmd.find_first_of("(", epos);
-		if (std::string::npos == pos) return reterr(cmd);
+		if (std::string::npos == pos) { rv += reterr(cmd); return; }
 		pos++;
 		epos = cmd.size();
 
 		Handle h = Json::decode_atom(cmd, pos, epos);
-		if (nullptr == h) return "false\n";
+		if (nullptr == h) { rv += "false\n"; return; }
 
 		h = as->get_atom(h);
 
-		if (nullptr == h) return "false\n";
-		return "true\n";
+		if (nullptr == h) { rv += "false\n"; return; }
+		rv += "true\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -204,16 +355,16 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 	if (gtinc == act)
 	{
 		pos = cmd.find_first_of("(", epos);
-		if (std::string::npos == pos) return reterr(cmd);
+		if (std::string::npos == pos) { rv += reterr(cmd); return; }
 		pos++;
 		epos = cmd.size();
 
 		Handle h = Json::decode_atom(cmd, pos, epos);
-		if (nullptr == h) return "[]\n";
+		if (nullptr == h) { rv += "[]\n"; return; }
 
 		h = as->get_atom(h);
 
-		if (nullptr == h) return "[]\n";
+		if (nullptr == h) { rv += "[]\n"; return; }
 
 		Type t = NOTYPE;
 		pos = cmd.find(",", epos);
@@ -224,7 +375,8 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 				t = Json::decode_type(cmd, pos);
 			}
 			catch(...) {
-				return "Unknown type: " + cmd.substr(pos);
+				rv += "Unknown type: " + cmd.substr(pos);
+				return;
 			}
 		}
 
@@ -235,14 +387,14 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 			is = h->getIncomingSet();
 
 		bool first = true;
-		std::string alist = "[";
+		rv += "[";
 		for (const Handle& hi : is)
 		{
-			if (not first) { alist += ",\n"; } else { first = false; }
-			alist += Json::encode_atom(hi, "");
+			if (not first) { rv += ",\n"; } else { first = false; }
+			Json::encode_atom(rv, hi, "");
 		}
-		alist += "]\n";
-		return alist;
+		rv += "]\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -250,31 +402,33 @@ std::string JSCommands::interpret_command(AtomSpace* as,
 	if (gtval == act)
 	{
 		pos = cmd.find_first_of("(", epos);
-		if (std::string::npos == pos) return reterr(cmd);
+		if (std::string::npos == pos) { rv += reterr(cmd); return; }
 		pos++;
 		epos = cmd.size();
 
 		Handle h = Json::decode_atom(cmd, pos, epos);
-		if (nullptr == h) return "[]\n";
+		if (nullptr == h) { rv += "[]\n"; return; }
 
 		h = as->get_atom(h);
 
-		if (nullptr == h) return "[]\n";
+		if (nullptr == h) { rv += "[]\n"; return; }
 
 		bool first = true;
-		std::string alist = "[\n";
+		rv += "[\n";
 		for (const Handle& key : h->getKeys())
 		{
-			if (not first) { alist += ",\n"; } else { first = false; }
-			alist += "  {\n";
-			alist += "    \"key\": " + Json::encode_atom(key, "    ") + ",\n";
-			alist += "    \"value\": ";
-			alist += Json::encode_value(h->getValue(key), "    ") + "}";
+			if (not first) { rv += ",\n"; } else { first = false; }
+			rv += "  {\n";
+			rv += "    \"key\": ";
+			Json::encode_atom(rv, key, "    ");
+			rv += ",\n    \"value\": ";
+			Json::encode_value(rv, h->getValue(key), "    ");
+			rv += "}";
 		}
-		alist += "]\n";
-		return alist;
+		rv += "]\n";
+		return;
 	}
 
 	// -----------------------------------------------
-	return reterr(cmd);
+	rv += reterr(cmd);
 }
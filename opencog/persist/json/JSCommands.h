@@ -57,7 +57,21 @@ public:
 	/// Sp far, the query command is not supported. It could be,
 	/// its really easy. See `../sexpr/Commands.cc` for examples.
 	///
+	/// Several function calls, separated by semicolons, are run as
+	/// one batch, concurrently, and a JSON list of the replies, in
+	/// the same order, is returned.
+	///
 	static std::string interpret_command(AtomSpace*, const std::string&);
+
+	/// Interpret one function call, and append the reply to the end
+	/// of the given buffer.
+	static void interpret(AtomSpace*, const std::string&, std::string&);
+
+	/// Interpret a batch of function calls, separated by semicolons
+	/// or newlines, and append a JSON list of the replies to the end
+	/// of the given buffer.
+	static void interpret_batch(AtomSpace*, const std::string&,
+	                            std::string&);
 };
 
 /** @}*/
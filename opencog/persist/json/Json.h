@@ -77,6 +77,17 @@ public:
 
 	static std::string dump_atom(const Handle&);
 	static std::string dump_vatom(const Handle&, const Handle&);
+
+	// Same as above, but these append to the end of the given buffer,
+	// instead of returning a new string.
+	static void encode_atom(std::string&, const Handle&,
+	                        const std::string& = "");
+	static void encode_value(std::string&, const ValuePtr&,
+	                         const std::string& = "");
+	static void encode_atom_values(std::string&, const Handle&);
+
+	static void dump_atom(std::string&, const Handle&);
+	static void dump_vatom(std::string&, const Handle&, const Handle&);
 };
 
 /** @}*/
@@ -0,0 +1,705 @@
+/*
+ * BinaryCommands.cc
+ * Binary framing of the minimalist command set.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <endian.h>
+#include <string.h>
+#include <time.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+#include <opencog/atoms/truthvalue/TruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "BinaryCommands.h"
+
+using namespace opencog;
+
+// The number of node names that will be interned, per connection.
+// Names seen after the tables are full are always sent as text.
+#define MAX_NAMES (1<<20)
+
+// The high bit of a name reference flags a name sent as text.
+#define NAME_TEXT 0x80000000
+
+// A type reference of zero is the null Atom or Value; this one flags
+// a type sent by name. All others are one more than the table index.
+#define TYPE_TEXT 0xffff
+
+// ===================================================================
+// Encoder
+
+void BinaryEncoder::begin(uint8_t op)
+{
+	// The previous frame was never finished.
+	for (const std::string& name : _pending)
+		_names.erase(name);
+	_pending.clear();
+	for (Type t : _pending_types)
+		_types.erase(t);
+	_pending_types.clear();
+
+	_buf.clear();
+	put_u32(0);  // Placeholder for the length.
+	put_u8(op);
+}
+
+const std::string& BinaryEncoder::end(void)
+{
+	uint32_t len = htole32(_buf.size() - sizeof(uint32_t));
+	memcpy(&_buf[0], &len, sizeof(uint32_t));
+	_pending.clear();
+	_pending_types.clear();
+	return _buf;
+}
+
+void BinaryEncoder::put_u8(uint8_t v)
+{
+	_buf.push_back((char) v);
+}
+
+void BinaryEncoder::put_u16(uint16_t v)
+{
+	v = htole16(v);
+	_buf.append((const char*) &v, sizeof(v));
+}
+
+void BinaryEncoder::put_u32(uint32_t v)
+{
+	v = htole32(v);
+	_buf.append((const char*) &v, sizeof(v));
+}
+
+void BinaryEncoder::put_double(double d)
+{
+	uint64_t v;
+	memcpy(&v, &d, sizeof(v));
+	v = htole64(v);
+	_buf.append((const char*) &v, sizeof(v));
+}
+
+void BinaryEncoder::put_string(const std::string& s)
+{
+	put_u32(s.size());
+	_buf.append(s);
+}
+
+void BinaryEncoder::put_name(const std::string& name)
+{
+	auto it = _names.find(name);
+	if (_names.end() != it)
+	{
+		put_u32(it->second);
+		return;
+	}
+
+	// The decoder interns it too, as long as there's room.
+	if (_names.size() < MAX_NAMES)
+	{
+		_names.emplace(name, _names.size());
+		_pending.push_back(name);
+	}
+
+	put_u32(NAME_TEXT | name.size());
+	_buf.append(name);
+}
+
+void BinaryEncoder::put_type(Type t)
+{
+	if (NOTYPE == t)
+	{
+		put_u16(0);
+		return;
+	}
+
+	auto it = _types.find(t);
+	if (_types.end() != it)
+	{
+		put_u16(it->second);
+		return;
+	}
+
+	// There are far fewer types than references, so all get interned.
+	uint16_t ref = _types.size() + 1;
+	_types.emplace(t, ref);
+	_pending_types.push_back(t);
+
+	put_u16(TYPE_TEXT);
+	put_string(nameserver().getTypeName(t));
+}
+
+void BinaryEncoder::put_atom(const Handle& h)
+{
+	if (nullptr == h)
+	{
+		put_type(NOTYPE);
+		return;
+	}
+
+	put_type(h->get_type());
+	if (h->is_node())
+	{
+		put_name(h->get_name());
+		return;
+	}
+
+	put_u32(h->get_arity());
+	for (const Handle& ho : h->getOutgoingSet())
+		put_atom(ho);
+}
+
+void BinaryEncoder::put_atoms(const HandleSeq& hs)
+{
+	put_u32(hs.size());
+	for (const Handle& h : hs)
+		put_atom(h);
+}
+
+void BinaryEncoder::put_value(const ValuePtr& v)
+{
+	if (nullptr == v)
+	{
+		put_type(NOTYPE);
+		return;
+	}
+
+	Type t = v->get_type();
+	if (v->is_atom())
+	{
+		put_atom(HandleCast(v));
+		return;
+	}
+
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		const std::vector<double>& fv = FloatValueCast(v)->value();
+		put_type(t);
+		put_u32(fv.size());
+		for (double d : fv) put_double(d);
+		return;
+	}
+
+	if (nameserver().isA(t, STRING_VALUE))
+	{
+		const std::vector<std::string>& sv = StringValueCast(v)->value();
+		put_type(t);
+		put_u32(sv.size());
+		for (const std::string& s : sv) put_string(s);
+		return;
+	}
+
+	if (nameserver().isA(t, LINK_VALUE))
+	{
+		const std::vector<ValuePtr>& lv = LinkValueCast(v)->value();
+		put_type(t);
+		put_u32(lv.size());
+		for (const ValuePtr& vp : lv) put_value(vp);
+		return;
+	}
+
+	// Anything else cannot be rebuilt at the far end.
+	put_type(NOTYPE);
+}
+
+/// All of the keys on an Atom, and the values on them.
+void BinaryEncoder::put_alist(const Handle& h)
+{
+	HandleSet keys(h->getKeys());
+	put_u32(keys.size());
+	for (const Handle& key : keys)
+	{
+		put_atom(key);
+		put_value(h->getValue(key));
+	}
+}
+
+// ===================================================================
+// Decoder
+
+size_t BinaryDecoder::frame_size(const char* buf, size_t len)
+{
+	if (len < sizeof(uint32_t)) return 0;
+	uint32_t flen;
+	memcpy(&flen, buf, sizeof(uint32_t));
+	size_t fsz = le32toh(flen) + sizeof(uint32_t);
+	if (len < fsz) return 0;
+	return fsz;
+}
+
+uint8_t BinaryDecoder::begin(const char* buf, size_t len)
+{
+	size_t fsz = frame_size(buf, len);
+	if (0 == fsz or fsz == sizeof(uint32_t))
+		throw SyntaxException(TRACE_INFO, "Incomplete binary frame");
+
+	_p = buf + sizeof(uint32_t);
+	_end = buf + fsz;
+	return get_u8();
+}
+
+void BinaryDecoder::need(size_t n)
+{
+	if ((size_t) (_end - _p) < n)
+		throw SyntaxException(TRACE_INFO, "Truncated binary frame");
+}
+
+uint8_t BinaryDecoder::get_u8(void)
+{
+	need(1);
+	return (uint8_t) *_p++;
+}
+
+uint16_t BinaryDecoder::get_u16(void)
+{
+	uint16_t v;
+	need(sizeof(v));
+	memcpy(&v, _p, sizeof(v));
+	_p += sizeof(v);
+	return le16toh(v);
+}
+
+uint32_t BinaryDecoder::get_u32(void)
+{
+	uint32_t v;
+	need(sizeof(v));
+	memcpy(&v, _p, sizeof(v));
+	_p += sizeof(v);
+	return le32toh(v);
+}
+
+double BinaryDecoder::get_double(void)
+{
+	uint64_t v;
+	need(sizeof(v));
+	memcpy(&v, _p, sizeof(v));
+	_p += sizeof(v);
+	v = le64toh(v);
+
+	double d;
+	memcpy(&d, &v, sizeof(d));
+	return d;
+}
+
+std::string BinaryDecoder::get_string(void)
+{
+	uint32_t len = get_u32();
+	need(len);
+	std::string s(_p, len);
+	_p += len;
+	return s;
+}
+
+const std::string& BinaryDecoder::get_name(void)
+{
+	uint32_t ref = get_u32();
+	if (0 == (ref & NAME_TEXT))
+	{
+		if (_names.size() <= ref)
+			throw SyntaxException(TRACE_INFO,
+				"Unknown node name reference %u", ref);
+		return _names[ref];
+	}
+
+	uint32_t len = ref & ~NAME_TEXT;
+	need(len);
+	if (_names.size() < MAX_NAMES)
+	{
+		_names.emplace_back(_p, len);
+		_p += len;
+		return _names.back();
+	}
+
+	// Tables are full; hand back a scratch copy.
+	static thread_local std::string scratch;
+	scratch.assign(_p, len);
+	_p += len;
+	return scratch;
+}
+
+uint32_t BinaryDecoder::get_count(size_t minsz)
+{
+	uint32_t n = get_u32();
+	if ((size_t) (_end - _p) / minsz < n)
+		throw SyntaxException(TRACE_INFO,
+			"Count %u does not fit in the binary frame", n);
+	return n;
+}
+
+/// A type, or NOTYPE for the null Atom or Value.
+Type BinaryDecoder::get_type_ref(void)
+{
+	uint16_t ref = get_u16();
+	if (0 == ref) return NOTYPE;
+
+	if (TYPE_TEXT != ref)
+	{
+		if (_types.size() < ref)
+			throw SyntaxException(TRACE_INFO,
+				"Unknown type reference %u", ref);
+		return _types[ref-1];
+	}
+
+	// Types that this process does not know about cannot be looked
+	// up anywhere, nor can Atoms of that type be built.
+	std::string name(get_string());
+	Type t = nameserver().getType(name);
+	if (NOTYPE == t)
+		throw SyntaxException(TRACE_INFO,
+			"Undefined type %s", name.c_str());
+	_types.push_back(t);
+	return t;
+}
+
+Type BinaryDecoder::get_type(void)
+{
+	Type t = get_type_ref();
+	if (NOTYPE == t)
+		throw SyntaxException(TRACE_INFO, "Expecting a type");
+	return t;
+}
+
+Handle BinaryDecoder::get_atom(void)
+{
+	return get_atom(get_type_ref());
+}
+
+Handle BinaryDecoder::get_atom(Type t)
+{
+	if (NOTYPE == t) return Handle::UNDEFINED;
+
+	if (nameserver().isA(t, NODE))
+		return createNode(t, std::string(get_name()));
+
+	if (not nameserver().isA(t, LINK))
+		throw SyntaxException(TRACE_INFO, "Expecting an Atom type, got %u", t);
+
+	// Each Atom takes at least the two bytes of its type.
+	uint32_t arity = get_count(sizeof(uint16_t));
+	HandleSeq oset;
+	oset.reserve(arity);
+	for (uint32_t i = 0; i < arity; i++)
+		oset.emplace_back(get_atom());
+	return createLink(std::move(oset), t);
+}
+
+HandleSeq BinaryDecoder::get_atoms(void)
+{
+	uint32_t n = get_count(sizeof(uint16_t));
+	HandleSeq hs;
+	hs.reserve(n);
+	for (uint32_t i = 0; i < n; i++)
+		hs.emplace_back(get_atom());
+	return hs;
+}
+
+ValuePtr BinaryDecoder::get_value(void)
+{
+	Type t = get_type_ref();
+	if (NOTYPE == t) return nullptr;
+	if (nameserver().isA(t, ATOM)) return get_atom(t);
+
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		uint32_t n = get_count(sizeof(double));
+		std::vector<double> fv;
+		fv.reserve(n);
+		for (uint32_t i = 0; i < n; i++)
+			fv.push_back(get_double());
+		return valueserver().create(t, fv);
+	}
+
+	if (nameserver().isA(t, STRING_VALUE))
+	{
+		uint32_t n = get_count(sizeof(uint32_t));
+		std::vector<std::string> sv;
+		sv.reserve(n);
+		for (uint32_t i = 0; i < n; i++)
+			sv.emplace_back(get_string());
+		return valueserver().create(t, sv);
+	}
+
+	if (nameserver().isA(t, LINK_VALUE))
+	{
+		uint32_t n = get_count(sizeof(uint16_t));
+		std::vector<ValuePtr> lv;
+		lv.reserve(n);
+		for (uint32_t i = 0; i < n; i++)
+			lv.emplace_back(get_value());
+		return valueserver().create(t, lv);
+	}
+
+	throw SyntaxException(TRACE_INFO, "Unsupported Value type %u", t);
+}
+
+// ===================================================================
+// Interpreter
+
+/// Each request is decoded in full before anything is done to the
+/// AtomSpace. A SyntaxException means that the connection is no longer
+/// usable, as the name and type tables at the two ends may no longer
+/// agree; it is passed on to the caller, who must drop the connection.
+/// This is the case for a malformed frame, and also for any failure
+/// before all of the frame was decoded, as the names and types in the
+/// rest of it were never interned. Any other failure is reported back
+/// to the client, with the FAIL status.
+const std::string&
+BinaryCommands::interpret_command(AtomSpace* as, const char* buf, size_t len)
+{
+	BinOp op = (BinOp) _in.begin(buf, len);
+
+	try
+	{
+		switch (op)
+		{
+			case BinOp::CLEAR:
+			{
+				as->clear();
+				_out.begin(OK);
+				_out.put_bool(true);
+				return _out.end();
+			}
+
+			case BinOp::EXECUTE_CACHE:
+			{
+				Handle query = _in.get_atom();
+				Handle key = _in.get_atom();
+				Handle meta = _in.get_atom();
+				bool force = _in.get_bool();
+
+				query = as->add_atom(query);
+				key = as->add_atom(key);
+				if (meta)
+				{
+					meta = as->add_atom(meta);
+					as->set_value(query, meta,
+						createFloatValue((double)time(0)));
+				}
+				else force = false;
+
+				ValuePtr rslt = query->getValue(key);
+				if (nullptr == rslt or force)
+				{
+					// For now, prevent general execution.
+					Type qt = query->get_type();
+					if (nameserver().isA(qt, PATTERN_LINK) or
+					    nameserver().isA(qt, JOIN_LINK))
+					{
+						rslt = query->execute();
+						as->set_value(query, key, rslt);
+					}
+					else rslt = nullptr;
+				}
+				_out.begin(OK);
+				_out.put_value(rslt);
+				return _out.end();
+			}
+
+			case BinOp::EXTRACT:
+			case BinOp::EXTRACT_RECURSIVE:
+			{
+				Handle h = as->get_atom(_in.get_atom());
+				bool ok = true;
+				if (h)
+					ok = as->extract_atom(h,
+						BinOp::EXTRACT_RECURSIVE == op);
+				_out.begin(OK);
+				_out.put_bool(ok);
+				return _out.end();
+			}
+
+			case BinOp::GET_ATOMS:
+			{
+				Type t = _in.get_type();
+				bool get_subtypes = _in.get_bool();
+				HandleSeq hset;
+				as->get_handles_by_type(hset, t, get_subtypes);
+				_out.begin(OK);
+				_out.put_atoms(hset);
+				return _out.end();
+			}
+
+			case BinOp::INCOMING_BY_TYPE:
+			{
+				Handle h = _in.get_atom();
+				Type t = _in.get_type();
+				h = as->add_atom(h);
+				_out.begin(OK);
+				_out.put_atoms(h->getIncomingSetByType(t));
+				return _out.end();
+			}
+
+			case BinOp::INCOMING_SET:
+			{
+				Handle h = as->add_atom(_in.get_atom());
+				_out.begin(OK);
+				_out.put_atoms(h->getIncomingSet());
+				return _out.end();
+			}
+
+			case BinOp::KEYS_ALIST:
+			{
+				Handle h = as->add_atom(_in.get_atom());
+				_out.begin(OK);
+				_out.put_alist(h);
+				return _out.end();
+			}
+
+			case BinOp::GET_ATOM:
+			{
+				Handle h = as->get_atom(_in.get_atom());
+				_out.begin(OK);
+				_out.put_atom(h);
+				return _out.end();
+			}
+
+			case BinOp::SET_VALUE:
+			{
+				Handle atom = _in.get_atom();
+				Handle key = _in.get_atom();
+				ValuePtr vp = _in.get_value();
+
+				atom = as->add_atom(atom);
+				key = as->add_atom(key);
+				if (vp and vp->is_atom())
+					vp = as->add_atom(HandleCast(vp));
+				as->set_value(atom, key, vp);
+				_out.begin(OK);
+				return _out.end();
+			}
+
+			case BinOp::SET_VALUES:
+			{
+				Handle atom = _in.get_atom();
+				// Each key and value take at least two bytes each.
+				uint32_t n = _in.get_count(2 * sizeof(uint16_t));
+				std::vector<std::pair<Handle, ValuePtr>> kvs;
+				kvs.reserve(n);
+				for (uint32_t i = 0; i < n; i++)
+				{
+					Handle key = _in.get_atom();
+					kvs.emplace_back(key, _in.get_value());
+				}
+
+				atom = as->add_atom(atom);
+				for (auto& kv : kvs)
+				{
+					ValuePtr vp = kv.second;
+					if (vp and vp->is_atom())
+						vp = as->add_atom(HandleCast(vp));
+					as->set_value(atom, as->add_atom(kv.first), vp);
+				}
+				_out.begin(OK);
+				return _out.end();
+			}
+
+			case BinOp::SET_TV:
+			{
+				Handle h = _in.get_atom();
+				TruthValuePtr tv = TruthValueCast(_in.get_value());
+				if (nullptr == tv)
+					throw RuntimeException(TRACE_INFO,
+						"Expecting a TruthValue");
+				as->set_truthvalue(as->add_atom(h), tv);
+				_out.begin(OK);
+				return _out.end();
+			}
+
+			case BinOp::VALUE:
+			{
+				Handle atom = _in.get_atom();
+				Handle key = _in.get_atom();
+				atom = as->add_atom(atom);
+				key = as->add_atom(key);
+				_out.begin(OK);
+				_out.put_value(atom->getValue(key));
+				return _out.end();
+			}
+
+			case BinOp::INCOMING_SET_LIST:
+			{
+				HandleSeq hs = _in.get_atoms();
+				HandleSet seen;
+				HandleSeq iset;
+				for (const Handle& h : hs)
+					for (const Handle& hi : as->add_atom(h)->getIncomingSet())
+						if (seen.insert(hi).second)
+							iset.emplace_back(hi);
+				_out.begin(OK);
+				_out.put_atoms(iset);
+				return _out.end();
+			}
+
+			case BinOp::KEYS_ALIST_LIST:
+			{
+				HandleSeq hs = _in.get_atoms();
+				_out.begin(OK);
+				_out.put_u32(hs.size());
+				for (const Handle& h : hs)
+					_out.put_alist(as->add_atom(h));
+				return _out.end();
+			}
+
+			case BinOp::VALUE_LIST:
+			{
+				Handle key = _in.get_atom();
+				HandleSeq hs = _in.get_atoms();
+				key = as->add_atom(key);
+				_out.begin(OK);
+				_out.put_u32(hs.size());
+				for (const Handle& h : hs)
+					_out.put_value(as->add_atom(h)->getValue(key));
+				return _out.end();
+			}
+		}
+	}
+	catch (const SyntaxException& ex)
+	{
+		throw;
+	}
+	catch (const StandardException& ex)
+	{
+		if (not _in.done())
+			throw SyntaxException(TRACE_INFO,
+				"Undecodable binary frame: %s", ex.get_message());
+		_out.begin(FAIL);
+		_out.put_string(ex.get_message());
+		return _out.end();
+	}
+	catch (const std::exception& ex)
+	{
+		if (not _in.done())
+			throw SyntaxException(TRACE_INFO,
+				"Undecodable binary frame: %s", ex.what());
+		_out.begin(FAIL);
+		_out.put_string(ex.what());
+		return _out.end();
+	}
+
+	throw SyntaxException(TRACE_INFO, "Unknown binary opcode %d", (int) op);
+}
+
+// ===================================================================
@@ -0,0 +1,182 @@
+/*
+ * BinaryCommands.h
+ * Binary framing of the minimalist command set.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _BINARY_COMMANDS_H
+#define _BINARY_COMMANDS_H
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_persist
+ *  @{
+ */
+
+class AtomSpace;
+
+/// Opcodes of the binary protocol. Each one corresponds to one of the
+/// s-expression commands handled by `Commands::interpret_command()`.
+enum class BinOp : uint8_t
+{
+	CLEAR = 1,          // cog-atomspace-clear
+	EXECUTE_CACHE,      // cog-execute-cache!
+	EXTRACT,            // cog-extract!
+	EXTRACT_RECURSIVE,  // cog-extract-recursive!
+	GET_ATOMS,          // cog-get-atoms
+	INCOMING_BY_TYPE,   // cog-incoming-by-type
+	INCOMING_SET,       // cog-incoming-set
+	KEYS_ALIST,         // cog-keys->alist
+	GET_ATOM,           // cog-node and cog-link
+	SET_VALUE,          // cog-set-value!
+	SET_VALUES,         // cog-set-values!
+	SET_TV,             // cog-set-tv!
+	VALUE,              // cog-value
+	INCOMING_SET_LIST,  // cog-incoming-set-list
+	KEYS_ALIST_LIST,    // cog-keys->alist-list
+	VALUE_LIST,         // cog-value-list
+};
+
+/// Serialize Atoms and Values into a binary frame.
+///
+/// A frame is a 4-byte length (not counting the length itself),
+/// followed by a one-byte opcode (for requests) or status (for
+/// replies), followed by the payload. All integers are little-endian.
+///
+/// Atoms are written as a type, followed by either the node name, or
+/// the arity and the outgoing set. Node names are interned: the first
+/// time a name is sent, its text is sent, and it is given the next
+/// free index; after that, only the index is sent. Types are interned
+/// the same way, by name, as the numeric type of an Atom depends on
+/// the order in which the type libraries were loaded, and so differs
+/// from one process to the next. Thus, the encoder and the decoder at
+/// the two ends of a connection must live as long as the connection
+/// does.
+///
+/// FloatValues (including TruthValues) are sent as packed arrays of
+/// IEEE doubles. The null Atom and the null Value are sent as type
+/// reference zero.
+class BinaryEncoder
+{
+	std::string _buf;
+	std::unordered_map<std::string, uint32_t> _names;
+	std::unordered_map<Type, uint16_t> _types;
+
+	// Names and types interned in the current frame. If the frame is
+	// abandoned, these are forgotten, as the decoder never sees them.
+	std::vector<std::string> _pending;
+	std::vector<Type> _pending_types;
+
+public:
+	void begin(uint8_t);
+	const std::string& end(void);
+
+	void put_u8(uint8_t);
+	void put_u16(uint16_t);
+	void put_u32(uint32_t);
+	void put_bool(bool b) { put_u8(b); }
+	void put_double(double);
+	void put_string(const std::string&);
+	void put_name(const std::string&);
+	void put_type(Type);
+
+	void put_atom(const Handle&);
+	void put_atoms(const HandleSeq&);
+	void put_value(const ValuePtr&);
+	void put_alist(const Handle&);
+};
+
+/// Deserialize the frames written by the BinaryEncoder. The decoder
+/// works directly on the received buffer, without copying it.
+class BinaryDecoder
+{
+	const char* _p;
+	const char* _end;
+	std::vector<std::string> _names;
+	std::vector<Type> _types;
+
+	void need(size_t);
+	Type get_type_ref(void);
+	Handle get_atom(Type);
+
+public:
+	BinaryDecoder(void) : _p(nullptr), _end(nullptr) {}
+
+	/// Return the size of the first frame in the buffer, if all of
+	/// it has been received, else return zero.
+	static size_t frame_size(const char*, size_t);
+
+	/// Start decoding a frame. Returns the opcode or status byte.
+	uint8_t begin(const char*, size_t);
+	bool done(void) const { return _p == _end; }
+
+	uint8_t get_u8(void);
+	uint16_t get_u16(void);
+	uint32_t get_u32(void);
+	bool get_bool(void) { return 0 != get_u8(); }
+	double get_double(void);
+	std::string get_string(void);
+	const std::string& get_name(void);
+
+	/// A count of items, each taking at least the given number of
+	/// bytes; counts that cannot fit in the rest of the frame throw.
+	uint32_t get_count(size_t);
+
+	/// A Type, which must be one that the NameServer knows about.
+	Type get_type(void);
+	Handle get_atom(void);
+	HandleSeq get_atoms(void);
+	ValuePtr get_value(void);
+};
+
+/// Interpret binary-framed versions of the commands that `Commands`
+/// interprets. The atomspace-frame (multi-space) variants of these
+/// commands are not supported. One instance is needed per connection,
+/// as the interned name and type tables are per-connection.
+class BinaryCommands
+{
+	BinaryDecoder _in;
+	BinaryEncoder _out;
+
+public:
+	/// Reply status bytes.
+	static constexpr uint8_t OK = 0;
+	static constexpr uint8_t FAIL = 1;
+
+	/// Interpret one complete request frame, and return the reply
+	/// frame. The returned string is reused by the next call.
+	const std::string& interpret_command(AtomSpace*, const char*, size_t);
+	const std::string& interpret_command(AtomSpace* as, const std::string& s)
+	{
+		return interpret_command(as, s.data(), s.size());
+	}
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _BINARY_COMMANDS_H
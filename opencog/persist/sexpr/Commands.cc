@@ -22,6 +22,8 @@
 
 #include <time.h>
 
+#include <algorithm>
+#include <exception>
 #include <functional>
 #include <iomanip>
 #include <string>
@@ -32,6 +34,7 @@
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/query/SearchPool.h>
 
 #include "Commands.h"
 #include "Sexpr.h"
@@ -78,8 +81,169 @@ Commands::get_opt_as(const std::string& cmd, size_t& pos, AtomSpace* as)
 	return as;
 }
 
+/// Decode a parenthesized list of Atoms, such as
+/// `((Concept "a") (Concept "b"))`, starting at `pos`.
+/// Upon return, `pos` points just past the closing paren.
+HandleSeq Commands::get_atom_list(const std::string& cmd, size_t& pos)
+{
+	pos = cmd.find_first_not_of(" \n\t", pos);
+	if (std::string::npos == pos or '(' != cmd[pos])
+		throw SyntaxException(TRACE_INFO, "Expecting a list of atoms: %s",
+			cmd.c_str());
+	pos++;
+
+	HandleSeq hs;
+	while (true)
+	{
+		pos = cmd.find_first_not_of(" \n\t", pos);
+		if (std::string::npos == pos)
+			throw SyntaxException(TRACE_INFO, "Unterminated list: %s",
+				cmd.c_str());
+		if (')' == cmd[pos]) break;
+		hs.emplace_back(Sexpr::decode_atom(cmd, pos, _space_map));
+	}
+	pos++;
+	return hs;
+}
+
+/// Return true if the command `cmd` does not change the AtomSpace
+/// contents in any way that later commands could see, and thus can be
+/// run concurrently with other such commands. These do call
+/// `add_atom()`, but adding an Atom is idempotent and thread-safe.
+static bool is_read_only(const std::string& cmd)
+{
+	static const size_t gtatm = std::hash<std::string>{}("cog-get-atoms");
+	static const size_t incty = std::hash<std::string>{}("cog-incoming-by-type");
+	static const size_t incom = std::hash<std::string>{}("cog-incoming-set");
+	static const size_t incls = std::hash<std::string>{}("cog-incoming-set-list");
+	static const size_t keys = std::hash<std::string>{}("cog-keys->alist");
+	static const size_t keyls = std::hash<std::string>{}("cog-keys->alist-list");
+	static const size_t link = std::hash<std::string>{}("cog-link");
+	static const size_t node = std::hash<std::string>{}("cog-node");
+	static const size_t value = std::hash<std::string>{}("cog-value");
+	static const size_t valls = std::hash<std::string>{}("cog-value-list");
+
+	size_t pos = cmd.find_first_not_of(" \n\t");
+	if (std::string::npos == pos or '(' != cmd[pos]) return false;
+	pos++;
+	size_t epos = cmd.find_first_of(" \n\t", pos);
+	if (std::string::npos == epos) return false;
+
+	size_t act = std::hash<std::string>{}(cmd.substr(pos, epos-pos));
+	return gtatm == act or incty == act or incom == act or
+		incls == act or keys == act or keyls == act or link == act or
+		node == act or value == act or valls == act;
+}
+
+// Runs of read-only commands shorter than this are not worth
+// handing to the thread pool.
+#define MIN_PARALLEL 64
+
+// Each thread taking part gets about this many chunks, so that a
+// thread that finishes early can take over some of the work of a
+// thread that is running slow commands.
+#define CHUNKS_PER_THREAD 4
+
+/// Run the commands `cmds[beg]` to `cmds[end-1]` concurrently, on the
+/// SearchPool threads, and append the replies, in order, to `rv`. The
+/// commands are split into a few contiguous chunks per thread, and the
+/// replies to each chunk are appended to one buffer, so that there is
+/// one buffer per chunk, instead of one string per reply.
+void Commands::run_parallel(AtomSpace* as,
+                            const std::vector<std::string>& cmds,
+                            size_t beg, size_t end, std::string& rv)
+{
+	SearchPool& pool = SearchPool::instance();
+	size_t n = end - beg;
+	size_t nparts = std::min(pool.concurrency(), n);
+	size_t nchunks = std::min(CHUNKS_PER_THREAD * nparts, n);
+	size_t chunk = (n + nchunks - 1) / nchunks;
+	nchunks = (n + chunk - 1) / chunk;
+
+	std::vector<std::string> bufs(nchunks);
+	std::vector<std::exception_ptr> errs(nchunks);
+	pool.run(nchunks, nparts, [&](size_t, size_t k) -> bool
+	{
+		try
+		{
+			size_t lo = beg + k * chunk;
+			size_t hi = std::min(lo + chunk, end);
+			for (size_t i = lo; i < hi; i++)
+				interpret(as, cmds[i], bufs[k]);
+		}
+		catch (...)
+		{
+			errs[k] = std::current_exception();
+		}
+		return false;
+	});
+
+	// Report the first failure, in command order.
+	for (size_t k = 0; k < nchunks; k++)
+		if (errs[k]) std::rethrow_exception(errs[k]);
+
+	for (const std::string& b : bufs)
+		rv += b;
+}
+
+/// Run all of the commands in `cmd` between `pos` and `end`, appending
+/// the replies, in order, to `rv`. Commands that change the AtomSpace
+/// are run one at a time, in order; runs of read-only commands in
+/// between them are run concurrently. When AtomSpace frames are in
+/// use, everything is run in order, as the frame map is shared state.
+void Commands::run_batch(AtomSpace* as, const std::string& cmd,
+                         size_t pos, size_t end, std::string& rv)
+{
+	std::vector<std::string> cmds;
+	while (pos < end)
+	{
+		size_t l = pos;
+		size_t r = end;
+		int cnt = Sexpr::get_next_expr(cmd, l, r, 0);
+		if (l == r) break;   // Trailing whitespace, or a comment.
+		if (0 != cnt)
+			throw SyntaxException(TRACE_INFO, "Unbalanced command: %s",
+				cmd.substr(l).c_str());
+		cmds.emplace_back(cmd.substr(l, r-l+1));
+		pos = r + 1;
+	}
+
+	size_t i = 0;
+	while (i < cmds.size())
+	{
+		size_t j = i;
+		if (not _multi_space)
+			while (j < cmds.size() and is_read_only(cmds[j])) j++;
+
+		if (MIN_PARALLEL <= j - i)
+		{
+			run_parallel(as, cmds, i, j, rv);
+			i = j;
+			continue;
+		}
+
+		if (i == j) j++;
+		for (; i < j; i++)
+			interpret(as, cmds[i], rv);
+	}
+}
+
+void Commands::interpret_batch(AtomSpace* as, const std::string& cmds,
+                               std::string& rv)
+{
+	run_batch(as, cmds, 0, cmds.size(), rv);
+}
+
 std::string Commands::interpret_command(AtomSpace* as,
                                         const std::string& cmd)
+{
+	std::string rv;
+	interpret(as, cmd, rv);
+	return rv;
+}
+
+void Commands::interpret(AtomSpace* as, const std::string& cmd,
+                         std::string& rv)
 {
 	// Fast dispatch. There should be zero hash collisions
 	// here. If there are, we are in trouble. (Well, if there
@@ -92,21 +256,25 @@ std::string Commands::interpret_command(AtomSpace* as,
 	static const size_t gtatm = std::hash<std::string>{}("cog-get-atoms");
 	static const size_t incty = std::hash<std::string>{}("cog-incoming-by-type");
 	static const size_t incom = std::hash<std::string>{}("cog-incoming-set");
+	static const size_t incls = std::hash<std::string>{}("cog-incoming-set-list");
 	static const size_t keys = std::hash<std::string>{}("cog-keys->alist");
+	static const size_t keyls = std::hash<std::string>{}("cog-keys->alist-list");
 	static const size_t link = std::hash<std::string>{}("cog-link");
 	static const size_t node = std::hash<std::string>{}("cog-node");
 	static const size_t stval = std::hash<std::string>{}("cog-set-value!");
 	static const size_t svals = std::hash<std::string>{}("cog-set-values!");
 	static const size_t settv = std::hash<std::string>{}("cog-set-tv!");
 	static const size_t value = std::hash<std::string>{}("cog-value");
+	static const size_t valls = std::hash<std::string>{}("cog-value-list");
 	static const size_t dfine = std::hash<std::string>{}("define");
+	static const size_t batch = std::hash<std::string>{}("cog-batch");
 
 	// Find the command and dispatch
 	size_t pos = cmd.find_first_not_of(" \n\t");
-	if (std::string::npos == pos) return "";
+	if (std::string::npos == pos) return;
 
 	// Ignore comments
-	if (';' == cmd[pos]) return "";
+	if (';' == cmd[pos]) return;
 
 	if ('(' != cmd[pos])
 		throw SyntaxException(TRACE_INFO, "Badly formed command: %s",
@@ -125,8 +293,9 @@ std::string Commands::interpret_command(AtomSpace* as,
 	// (cog-atomspace)
 	if (space == act)
 	{
-		if (not top_space) return "()\n";
-		return top_space->to_string("");
+		if (not top_space) { rv += "()\n"; return; }
+		rv += top_space->to_string("");
+		return;
 	}
 
 	// -----------------------------------------------
@@ -134,7 +303,8 @@ std::string Commands::interpret_command(AtomSpace* as,
 	if (clear == act)
 	{
 		as->clear();
-		return "#t\n";
+		rv += "#t\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -162,18 +332,25 @@ std::string Commands::interpret_command(AtomSpace* as,
 		}
 		ValuePtr rslt = query->getValue(key);
 		if (nullptr != rslt and not force)
-			return Sexpr::encode_value(rslt);
+		{
+			Sexpr::encode_value(rv, rslt);
+			return;
+		}
 
 		// For now, prevent general execution.
 		Type qt = query->get_type();
 		if (not nameserver().isA(qt, PATTERN_LINK) and
 		    not nameserver().isA(qt, JOIN_LINK))
-			return "#f\n";
+		{
+			rv += "#f\n";
+			return;
+		}
 
 		rslt = query->execute();
 		as->set_value(query, key, rslt);
 
-		return Sexpr::encode_value(rslt);
+		Sexpr::encode_value(rv, rslt);
+		return;
 	}
 
 	// -----------------------------------------------
@@ -182,9 +359,10 @@ std::string Commands::interpret_command(AtomSpace* as,
 	{
 		pos = epos + 1;
 		Handle h = as->get_atom(Sexpr::decode_atom(cmd, pos, _space_map));
-		if (nullptr == h) return "#t\n";
-		if (as->extract_atom(h, false)) return "#t\n";
-		return "#f\n";
+		if (nullptr == h) { rv += "#t\n"; return; }
+		if (as->extract_atom(h, false)) { rv += "#t\n"; return; }
+		rv += "#f\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -193,9 +371,10 @@ std::string Commands::interpret_command(AtomSpace* as,
 	{
 		pos = epos + 1;
 		Handle h = as->get_atom(Sexpr::decode_atom(cmd, pos, _space_map));
-		if (nullptr == h) return "#t\n";
-		if (as->extract_atom(h, true)) return "#t\n";
-		return "#f\n";
+		if (nullptr == h) { rv += "#t\n"; return; }
+		if (as->extract_atom(h, true)) { rv += "#t\n"; return; }
+		rv += "#f\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -212,16 +391,16 @@ std::string Commands::interpret_command(AtomSpace* as,
 
 		// as = get_opt_as(cmd, pos, as);
 
-		std::string rv = "(";
+		rv += "(";
 		HandleSeq hset;
 		if (_multi_space and top_space)
 			top_space->get_handles_by_type(hset, t, get_subtypes);
 		else
 			as->get_handles_by_type(hset, t, get_subtypes);
 		for (const Handle& h: hset)
-			rv += Sexpr::encode_atom(h, _multi_space);
+			Sexpr::encode_atom(rv, h, _multi_space);
 		rv += ")";
-		return rv;
+		return;
 	}
 
 	// -----------------------------------------------
@@ -235,12 +414,12 @@ std::string Commands::interpret_command(AtomSpace* as,
 		as = get_opt_as(cmd, pos, as);
 		h = as->add_atom(h);
 
-		std::string alist = "(";
+		rv += "(";
 		for (const Handle& hi : h->getIncomingSetByType(t))
-			alist += Sexpr::encode_atom(hi);
+			Sexpr::encode_atom(rv, hi);
 
-		alist += ")\n";
-		return alist;
+		rv += ")\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -251,12 +430,34 @@ std::string Commands::interpret_command(AtomSpace* as,
 		Handle h = Sexpr::decode_atom(cmd, pos, _space_map);
 		as = get_opt_as(cmd, pos, as);
 		h = as->add_atom(h);
-		std::string alist = "(";
+		rv += "(";
 		for (const Handle& hi : h->getIncomingSet())
-			alist += Sexpr::encode_atom(hi);
+			Sexpr::encode_atom(rv, hi);
 
-		alist += ")\n";
-		return alist;
+		rv += ")\n";
+		return;
+	}
+
+	// -----------------------------------------------
+	// (cog-incoming-set-list ((Concept "foo") (Concept "bar")))
+	// Returns the union of the incoming sets, without duplicates.
+	if (incls == act)
+	{
+		pos = epos + 1;
+		HandleSeq hs = get_atom_list(cmd, pos);
+		as = get_opt_as(cmd, pos, as);
+
+		HandleSet seen;
+		rv += "(";
+		for (const Handle& h : hs)
+		{
+			Handle ah = as->add_atom(h);
+			for (const Handle& hi : ah->getIncomingSet())
+				if (seen.insert(hi).second)
+					Sexpr::encode_atom(rv, hi);
+		}
+		rv += ")\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -268,14 +469,45 @@ std::string Commands::interpret_command(AtomSpace* as,
 		as = get_opt_as(cmd, pos, as);
 		h = as->add_atom(h);
 
-		std::string alist = "(";
+		rv += "(";
 		for (const Handle& key : h->getKeys())
 		{
-			alist += "(" + Sexpr::encode_atom(key) + " . ";
-			alist += Sexpr::encode_value(h->getValue(key)) + ")";
+			rv += "(";
+			Sexpr::encode_atom(rv, key);
+			rv += " . ";
+			Sexpr::encode_value(rv, h->getValue(key));
+			rv += ")";
 		}
-		alist += ")\n";
-		return alist;
+		rv += ")\n";
+		return;
+	}
+
+	// -----------------------------------------------
+	// (cog-keys->alist-list ((Concept "foo") (Concept "bar")))
+	// Returns a list of alists, one per atom, in the same order.
+	if (keyls == act)
+	{
+		pos = epos + 1;
+		HandleSeq hs = get_atom_list(cmd, pos);
+		as = get_opt_as(cmd, pos, as);
+
+		rv += "(";
+		for (const Handle& h : hs)
+		{
+			Handle ah = as->add_atom(h);
+			rv += "(";
+			for (const Handle& key : ah->getKeys())
+			{
+				rv += "(";
+				Sexpr::encode_atom(rv, key);
+				rv += " . ";
+				Sexpr::encode_value(rv, ah->getValue(key));
+				rv += ")";
+			}
+			rv += ")";
+		}
+		rv += ")\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -314,8 +546,9 @@ std::string Commands::interpret_command(AtomSpace* as,
 			as = get_opt_as(cmd, pos, as);
 			h = as->get_link(t, std::move(outgoing));
 		}
-		if (nullptr == h) return "()\n";
-		return Sexpr::encode_atom(h, _multi_space);
+		if (nullptr == h) { rv += "()\n"; return; }
+		Sexpr::encode_atom(rv, h, _multi_space);
+		return;
 	}
 
 	// -----------------------------------------------
@@ -333,7 +566,8 @@ std::string Commands::interpret_command(AtomSpace* as,
 		if (vp)
 			vp = Sexpr::add_atoms(as, vp);
 		as->set_value(atom, key, vp);
-		return "()\n";
+		rv += "()\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -353,7 +587,8 @@ std::string Commands::interpret_command(AtomSpace* as,
 		}
 		Sexpr::decode_slist(h, cmd, pos);
 
-		return "()\n";
+		rv += "()\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -369,9 +604,10 @@ std::string Commands::interpret_command(AtomSpace* as,
 		as = get_opt_as(cmd, pos, as);
 
 		Handle ha = as->add_atom(h);
-		if (nullptr == ha) return "()\n"; // read-only atomspace.
+		if (nullptr == ha) { rv += "()\n"; return; } // read-only atomspace.
 		as->set_truthvalue(ha, TruthValueCast(tv));
-		return "()\n";
+		rv += "()\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -385,7 +621,49 @@ std::string Commands::interpret_command(AtomSpace* as,
 		key = as->add_atom(key);
 
 		ValuePtr vp = atom->getValue(key);
-		return Sexpr::encode_value(vp);
+		Sexpr::encode_value(rv, vp);
+		return;
+	}
+
+	// -----------------------------------------------
+	// (cog-value-list (Predicate "key") ((Concept "foo") (Concept "bar")))
+	// Returns a list of values, one per atom, in the same order.
+	// Missing values are returned as #f.
+	if (valls == act)
+	{
+		pos = epos + 1;
+		Handle key = Sexpr::decode_atom(cmd, pos, _space_map);
+		HandleSeq hs = get_atom_list(cmd, pos);
+		as = get_opt_as(cmd, pos, as);
+		key = as->add_atom(key);
+
+		rv += "(";
+		for (const Handle& h : hs)
+		{
+			Handle ah = as->add_atom(h);
+			Sexpr::encode_value(rv, ah->getValue(key));
+		}
+		rv += ")\n";
+		return;
+	}
+
+	// -----------------------------------------------
+	// (cog-batch (cog-value (Concept "a") (Predicate "key"))
+	//            (cog-value (Concept "b") (Predicate "key")) ...)
+	// Returns a list of the replies, in order.
+	if (batch == act)
+	{
+		// Find the matching close-paren of the batch itself.
+		size_t l = pos - 1;
+		size_t r = cmd.size();
+		if (0 != Sexpr::get_next_expr(cmd, l, r, 0))
+			throw SyntaxException(TRACE_INFO, "Unbalanced batch: %s",
+				cmd.c_str());
+
+		rv += "(";
+		run_batch(as, cmd, epos, r, rv);
+		rv += ")\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -411,7 +689,8 @@ std::string Commands::interpret_command(AtomSpace* as,
 		// Hacky...
 		// _space_map.insert({sym, top_space});
 
-		return "()\n";
+		rv += "()\n";
+		return;
 	}
 
 	// -----------------------------------------------
@@ -24,6 +24,7 @@
 #define _COMMANDS_H
 
 #include <string>
+#include <vector>
 
 namespace opencog
 {
@@ -44,6 +45,13 @@ private:
 	std::unordered_map<std::string, Handle> _space_map;
 
 	AtomSpace* get_opt_as(const std::string&, size_t&, AtomSpace*);
+	HandleSeq get_atom_list(const std::string&, size_t&);
+
+	void interpret(AtomSpace*, const std::string&, std::string&);
+	void run_batch(AtomSpace*, const std::string&, size_t, size_t,
+	               std::string&);
+	void run_parallel(AtomSpace*, const std::vector<std::string>&,
+	                  size_t, size_t, std::string&);
 
 public:
 	Commands(void);
@@ -58,19 +66,31 @@ public:
 	///
 	/// The supported commands are:
 	///    cog-atomspace-clear
+	///    cog-batch
 	///    cog-execute-cache!
 	///    cog-extract!
 	///    cog-extract-recursive!
 	///    cog-get-atoms
 	///    cog-incoming-by-type
 	///    cog-incoming-set
+	///    cog-incoming-set-list
 	///    cog-keys->alist
+	///    cog-keys->alist-list
 	///    cog-link
 	///    cog-node
 	///    cog-set-value!
 	///    cog-set-values!
 	///    cog-set-tv!
 	///    cog-value
+	///    cog-value-list
+	///
+	/// The `-list` variants take a parenthesized list of Atoms, and
+	/// answer for all of them at once; this avoids one network
+	/// round-trip per Atom when fetching many Atoms.
+	///
+	/// The `cog-batch` command wraps any number of the other commands,
+	/// and returns a list of their replies, in the same order. Runs of
+	/// read-only commands in the batch are performed concurrently.
    ///
 	/// They MUST appear only once in the string, at the very beginning,
 	/// and they MUST be followed by valid Atomese s-expressions, and
@@ -78,6 +98,11 @@ public:
 	///
 	std::string interpret_command(AtomSpace*, const std::string&);
 
+	/// Interpret a sequence of commands, one after another, appending
+	/// the replies, in order, to the end of the given buffer. This is
+	/// the same as the `cog-batch` command, without the enclosing list.
+	void interpret_batch(AtomSpace*, const std::string&, std::string&);
+
 	/// If some interpreted command specified an AtomSpace, this
 	/// will be set to that AtomSpace.
 	AtomSpacePtr top_space;
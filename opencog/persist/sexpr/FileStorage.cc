@@ -43,12 +43,23 @@ FileStorageNode::FileStorageNode(Type t, const std::string& uri)
 	: StorageNode(t, uri)
 {
 	_fh = nullptr;
+	_packed = false;
 
 	_filename = get_name();
 
 	// If the URL begins with `file://` then just strip that off.
 	if (0 == _filename.compare(0, 7, "file://"))
 		_filename = _filename.substr(7);
+
+	// If the URL ends with `?packed` then write FloatValues and
+	// TruthValues in the packed binary form.
+	size_t plen = sizeof("?packed") - 1;
+	if (plen < _filename.size() and
+	    0 == _filename.compare(_filename.size() - plen, plen, "?packed"))
+	{
+		_filename.resize(_filename.size() - plen);
+		_packed = true;
+	}
 }
 
 FileStorageNode::~FileStorageNode()
@@ -144,9 +155,12 @@ void FileStorageNode::storeAtom(const Handle& h, bool synchronous)
 		throw IOException(TRACE_INFO,
 		"FileStorageNode %s is not open!", _filename.c_str());
 
-	const std::string sex = Sexpr::dump_atom(h);
-	fwrite(sex.c_str(), sex.length(), 1, _fh);
-	size_t rc = fwrite("\n", 1, 1, _fh);
+	// Reuse the buffer, instead of allocating a new one every time.
+	static thread_local std::string sex;
+	sex.clear();
+	Sexpr::dump_atom(sex, h, _packed);
+	sex += '\n';
+	size_t rc = fwrite(sex.data(), sex.size(), 1, _fh);
 
 	if (1 != rc)
 		throw IOException(TRACE_INFO,
@@ -166,9 +180,11 @@ void FileStorageNode::storeValue(const Handle& h, const Handle& key)
 		throw IOException(TRACE_INFO,
 		"FileStorageNode %s is not open!", _filename.c_str());
 
-	const std::string sex = Sexpr::dump_vatom(h, key);
-	fwrite(sex.c_str(), sex.length(), 1, _fh);
-	size_t rc = fwrite("\n", 1, 1, _fh);
+	static thread_local std::string sex;
+	sex.clear();
+	Sexpr::dump_vatom(sex, h, key, _packed);
+	sex += '\n';
+	size_t rc = fwrite(sex.data(), sex.size(), 1, _fh);
 
 	if (1 != rc)
 		throw IOException(TRACE_INFO,
@@ -38,6 +38,7 @@ class FileStorageNode : public StorageNode
 	private:
 		std::string _filename;
 		FILE* _fh;
+		bool _packed;     // Write FloatValues in packed form.
 
 	public:
 		FileStorageNode(Type t, const std::string& uri);
@@ -55,6 +56,7 @@ class FileStorageNode : public StorageNode
 		// AtomStorage interface
 		Handle getNode(Type, const char *);
 		Handle getLink(Type, const HandleSeq&);
+		bool loadAtom(const Handle& h) { return getAtomCompat(h); }
 		void fetchIncomingSet(AtomSpace*, const Handle&);
 		void fetchIncomingByType(AtomSpace*, const Handle&, Type t);
 		void storeAtom(const Handle&, bool synchronous = false);
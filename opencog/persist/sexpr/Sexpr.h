@@ -110,6 +110,22 @@ public:
 
 	static std::string dump_atom(const Handle&);
 	static std::string dump_vatom(const Handle&, const Handle&);
+
+	// Same as above, but these append to the end of the given buffer,
+	// instead of returning a new string. Use these when building up
+	// large replies or dumps. If `packed` is set, then FloatValues
+	// and TruthValues are written in the packed binary form, as a
+	// base-64 string: `(FloatValue "AQME...")`. This is much smaller
+	// and faster to read back, but only `decode_value()` understands
+	// it; guile does not.
+	static void encode_atom(std::string&, const Handle&, bool=false);
+	static void encode_value(std::string&, const ValuePtr&, bool packed=false);
+	static void encode_atom_values(std::string&, const Handle&,
+	                               bool packed=false);
+
+	static void dump_atom(std::string&, const Handle&, bool packed=false);
+	static void dump_vatom(std::string&, const Handle&, const Handle&,
+	                       bool packed=false);
 };
 
 /** @}*/
@@ -23,6 +23,7 @@
 #include <iomanip>
 
 #include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/value/FloatCodec.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
@@ -177,6 +178,34 @@ ValuePtr Sexpr::decode_value(const std::string& stv, size_t& pos)
 
 	if (nameserver().isA(vtype, FLOAT_VALUE))
 	{
+		// The packed form is a base-64 string.
+		size_t q = stv.find_first_not_of(" \n\t", vos);
+		if (std::string::npos != q and '"' == stv[q])
+		{
+			size_t e = stv.find('"', q+1);
+			if (std::string::npos == e)
+				throw SyntaxException(TRACE_INFO,
+					"Malformed packed FloatValue: %s", stv.substr(pos).c_str());
+			std::vector<double> fv;
+			try
+			{
+				fv = unpack_floats(
+					base64_decode(stv.data() + q + 1, e - q - 1));
+			}
+			catch (const RuntimeException& ex)
+			{
+				throw SyntaxException(TRACE_INFO,
+					"Malformed packed FloatValue: %s", ex.get_message());
+			}
+
+			pos = stv.find_first_not_of(" \n\t", e+1);
+			if (std::string::npos == pos or ')' != stv[pos])
+				throw SyntaxException(TRACE_INFO,
+					"Malformed packed FloatValue: %s", stv.substr(q).c_str());
+			pos++;
+			return valueserver().create(vtype, fv);
+		}
+
 		std::vector<double> fv;
 		while (vos < totlen and stv[vos] != ')')
 		{
@@ -329,165 +358,228 @@ void Sexpr::decode_slist(const Handle& atom,
 }
 
 /* ================================================================== */
+// The encoders below all append to the end of a caller-supplied
+// buffer. This way, large outputs (big incoming sets, entire
+// AtomSpaces) are built up in place, instead of being assembled out
+// of many small temporary strings. The string-returning versions are
+// just wrappers around these.
+//
 // Atom printers that do NOT print associated Values.
 
-static std::string prt_node(const Handle& h, bool multispace)
+static void prt_atom(std::string&, const Handle&, bool);
+
+static void prt_node(std::string& out, const Handle& h, bool multispace)
 {
-	std::stringstream ss;
-	ss << "(" << nameserver().getTypeName(h->get_type())
-		<< " " << std::quoted(h->get_name());
+	out += '(';
+	out += nameserver().getTypeName(h->get_type());
+	out += ' ';
+	print_quoted(out, h->get_name());
 
 	if (multispace and h->getAtomSpace())
-		ss << " (AtomSpace \"" << h->getAtomSpace()->get_name() << "\")";
-
-	ss << ")";
+	{
+		out += " (AtomSpace \"";
+		out += h->getAtomSpace()->get_name();
+		out += "\")";
+	}
 
-	return ss.str();
+	out += ')';
 }
 
-static std::string prt_atom(const Handle&, bool);
-
-static std::string prt_link(const Handle& h, bool multispace)
+static void prt_link(std::string& out, const Handle& h, bool multispace)
 {
-	std::string txt = "(" + nameserver().getTypeName(h->get_type()) + " ";
+	out += '(';
+	out += nameserver().getTypeName(h->get_type());
+	out += ' ';
 	for (const Handle& ho : h->getOutgoingSet())
-		txt += prt_atom(ho, multispace);
+		prt_atom(out, ho, multispace);
 
 	if (multispace and h->getAtomSpace())
-		txt += " (AtomSpace \"" + h->getAtomSpace()->get_name() + "\")";
+	{
+		out += " (AtomSpace \"";
+		out += h->getAtomSpace()->get_name();
+		out += "\")";
+	}
+
+	out += ')';
+}
 
-	txt += ")";
-	return txt;
+static void prt_atom(std::string& out, const Handle& h, bool multispace)
+{
+	if (h->is_node()) prt_node(out, h, multispace);
+	else prt_link(out, h, multispace);
 }
 
-static std::string prt_atom(const Handle& h, bool multispace)
+/// Append the Atom to the buffer. It does NOT print any of the
+/// associated values; use `dump_atom()` to get those.
+void Sexpr::encode_atom(std::string& out, const Handle& h, bool multispace)
 {
-	if (h->is_node()) return prt_node(h, multispace);
-	return prt_link(h, multispace);
+	prt_atom(out, h, multispace);
 }
 
 /// Convert the Atom into a string. It does NOT print any of the
 /// associated values; use `dump_atom()` to get those.
 std::string Sexpr::encode_atom(const Handle& h, bool multispace)
 {
-	return prt_atom(h, multispace);
+	std::string out;
+	prt_atom(out, h, multispace);
+	return out;
 }
 
-/// Convert value (or Atom) into a string.
-std::string Sexpr::encode_value(const ValuePtr& v)
+/// Append the value (or Atom) to the buffer.
+void Sexpr::encode_value(std::string& out, const ValuePtr& v, bool packed)
 {
 	// Empty values are used to erase keys from atoms.
-	if (nullptr == v) return " #f";
+	if (nullptr == v) { out += " #f"; return; }
 
-	if (nameserver().isA(v->get_type(), FLOAT_VALUE))
+	Type t = v->get_type();
+	if (packed and nameserver().isA(t, FLOAT_VALUE))
 	{
-		// The FloatValue to_string() method prints out a high-precision
-		// form of the value, as compared to SimpleTruthValue, which
-		// only prints 6 digits and breaks the unit tests.
-		FloatValuePtr fv(FloatValueCast(v));
-		return fv->FloatValue::to_string();
+		out += '(';
+		out += nameserver().getTypeName(t);
+		out += " \"";
+		base64_encode(out, pack_floats(FloatValueCast(v)->value()));
+		out += "\")";
+		return;
+	}
+
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		// Print the full precision, as compared to SimpleTruthValue,
+		// which only prints 6 digits and breaks the unit tests.
+		out += '(';
+		out += nameserver().getTypeName(t);
+		for (double d : FloatValueCast(v)->value())
+		{
+			out += ' ';
+			print_double(out, d);
+		}
+		out += ')';
+		return;
+	}
+
+	if (STRING_VALUE == t)
+	{
+		out += "(StringValue";
+		for (const std::string& s : StringValueCast(v)->value())
+		{
+			out += ' ';
+			print_quoted(out, s);
+		}
+		out += ')';
+		return;
 	}
 
 	if (not v->is_atom())
-		return v->to_short_string();
-	return prt_atom(HandleCast(v), false);
+	{
+		out += v->to_short_string();
+		return;
+	}
+	prt_atom(out, HandleCast(v), false);
+}
+
+/// Convert value (or Atom) into a string.
+std::string Sexpr::encode_value(const ValuePtr& v)
+{
+	std::string out;
+	encode_value(out, v);
+	return out;
 }
 
 /* ================================================================== */
 
-/// Get all of the values on an Atom and print them as an
-/// association list.
-std::string Sexpr::encode_atom_values(const Handle& h)
+/// Append all of the values on an Atom, as an association list.
+void Sexpr::encode_atom_values(std::string& out, const Handle& h,
+                               bool packed)
 {
-	std::stringstream rv;
-
-	rv << "(alist ";
+	out += "(alist ";
 	for (const Handle& k: h->getKeys())
 	{
-		ValuePtr p = h->getValue(k);
-		rv << "(cons " << prt_atom(k, false) << encode_value(p) << ")";
+		out += "(cons ";
+		prt_atom(out, k, false);
+		encode_value(out, h->getValue(k), packed);
+		out += ')';
 	}
-	rv << ")";
-	return rv.str();
+	out += ')';
 }
 
-/* ================================================================== */
-// Atom printers that encode ALL associated Values.
-
-static std::string dump_node(const Handle& h)
+/// Get all of the values on an Atom and print them as an
+/// association list.
+std::string Sexpr::encode_atom_values(const Handle& h)
 {
-	std::stringstream ss;
-	ss << "(" << nameserver().getTypeName(h->get_type())
-		<< " " << std::quoted(h->get_name());
-
-	if (h->haveValues())
-		ss << " " << Sexpr::encode_atom_values(h);
-
-	ss << ")";
-
-	return ss.str();
+	std::string out;
+	encode_atom_values(out, h);
+	return out;
 }
 
-static std::string dump_link(const Handle& h)
+/* ================================================================== */
+// Atom printers that encode ALL associated Values.
+
+/// Append the Atom, and all of the values attached to it.
+/// Similar to `encode_atom()`, except that it also prints the values.
+/// Values on going Atoms in a Link are NOT dumped!
+/// This is in order to avoid duplication.
+void Sexpr::dump_atom(std::string& out, const Handle& h, bool packed)
 {
-	std::string txt = "(" + nameserver().getTypeName(h->get_type()) + " ";
-	for (const Handle& ho : h->getOutgoingSet())
-		txt += prt_atom(ho, false);
+	out += '(';
+	out += nameserver().getTypeName(h->get_type());
+	out += ' ';
+	if (h->is_node())
+		print_quoted(out, h->get_name());
+	else
+		for (const Handle& ho : h->getOutgoingSet())
+			prt_atom(out, ho, false);
 
 	if (h->haveValues())
 	{
-		txt += " ";
-		txt += Sexpr::encode_atom_values(h);
+		out += ' ';
+		encode_atom_values(out, h, packed);
 	}
 
-	txt += ")";
-	return txt;
+	out += ')';
 }
 
 /// Print the Atom, and all of the values attached to it.
-/// Similar to `encode_atom()`, except that it also prints the values.
-/// Values on going Atoms in a Link are NOT dumped!
-/// This is in order to avoid duplication.
 std::string Sexpr::dump_atom(const Handle& h)
 {
-	if (h->is_node()) return dump_node(h);
-	return dump_link(h);
+	std::string out;
+	dump_atom(out, h);
+	return out;
 }
 
 /* ================================================================== */
 // Atom printers that encode only one associated Value.
 
-static std::string dump_vnode(const Handle& h, const Handle& key)
-{
-	std::stringstream ss;
-	ss << "(" << nameserver().getTypeName(h->get_type())
-		<< " " << std::quoted(h->get_name());
-
-	ValuePtr p = h->getValue(key);
-	if (nullptr != p)
-		ss << " (alist (cons " << prt_atom(key, false) << Sexpr::encode_value(p) << ")))";
-
-	return ss.str();
-}
-
-static std::string dump_vlink(const Handle& h, const Handle& key)
+/// Append the Atom, and just one of the values attached to it.
+void Sexpr::dump_vatom(std::string& out, const Handle& h, const Handle& key,
+                       bool packed)
 {
-	std::string txt = "(" + nameserver().getTypeName(h->get_type()) + " ";
-	for (const Handle& ho : h->getOutgoingSet())
-		txt += prt_atom(ho, false);
+	out += '(';
+	out += nameserver().getTypeName(h->get_type());
+	out += ' ';
+	if (h->is_node())
+		print_quoted(out, h->get_name());
+	else
+		for (const Handle& ho : h->getOutgoingSet())
+			prt_atom(out, ho, false);
 
 	ValuePtr p = h->getValue(key);
 	if (nullptr != p)
-		txt += " (alist (cons " + prt_atom(key, false) + Sexpr::encode_value(p) + ")))";
+	{
+		out += " (alist (cons ";
+		prt_atom(out, key, false);
+		encode_value(out, p, packed);
+		out += "))";
+	}
 
-	return txt;
+	out += ')';
 }
 
 /// Print the Atom, and just one of the values attached to it.
 std::string Sexpr::dump_vatom(const Handle& h, const Handle& key)
 {
-	if (h->is_node()) return dump_vnode(h, key);
-	return dump_vlink(h, key);
+	std::string out;
+	dump_vatom(out, h, key);
+	return out;
 }
 
 /* ================================================================== */
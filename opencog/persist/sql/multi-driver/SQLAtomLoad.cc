@@ -243,6 +243,10 @@ SQLAtomStorage::PseudoPtr SQLAtomStorage::makeAtom(Response &rp, UUID uuid)
 	{
 		atom->name = rp.name;
 	}
+	else if (rp.binary)
+	{
+		atom->oset = rp.outvec;
+	}
 	else
 	{
 		char *p = (char *) rp.outlist;
@@ -74,6 +74,7 @@ SQLAtomStorage::SQLAtomStorage(const std::string uri) :
 	_initial_conn_pool_size = 0;
 	_use_libpq = false;
 	_use_odbc = false;
+	_have_packed = false;
 
 	type_map_was_loaded = false;
 	for (int i=0; i< TYPEMAP_SZ; i++)
@@ -87,6 +88,9 @@ SQLAtomStorage::SQLAtomStorage(const std::string uri) :
 
 SQLAtomStorage::~SQLAtomStorage()
 {
+	// Must be done here, and not in ~StorageNode, as lazy fetches
+	// in progress are still using the connection pool.
+	_residency->detach();
 	close_conn_pool();
 
 	for (int i=0; i<TYPEMAP_SZ; i++)
@@ -158,6 +162,7 @@ void SQLAtomStorage::connect(const char * uri)
 
 	// Need the server version before init'ing the UUID pool.
 	get_server_version();
+	check_packed();
 }
 
 void SQLAtomStorage::open(void)
@@ -198,6 +203,7 @@ void SQLAtomStorage::open(void)
 	enlarge_conn_pool(NUM_OMP_THREADS - 2, _name.c_str());
 
 	if (!connected()) return;
+	_residency->attach(this);
 
 	_uuid_manager.that = this;
 	_uuid_manager.reset_uuid_pool(getMaxObservedUUID());
@@ -241,6 +247,19 @@ void SQLAtomStorage::get_server_version(void)
 	_server_version = rp.intval;
 }
 
+/// Older databases do not have the packedvalue column; FloatValues
+/// are stored as arrays of doubles, in those. See `atom.sql` for how
+/// to upgrade.
+void SQLAtomStorage::check_packed(void)
+{
+	Response rp(conn_pool);
+	rp.exec("SELECT count(*) FROM information_schema.columns "
+	        "WHERE table_name = 'valuations' "
+	        "AND column_name = 'packedvalue';");
+	rp.rs->foreach_row(&Response::intval_cb, &rp);
+	_have_packed = (0 < rp.intval);
+}
+
 /// Rethrow asynchronous exceptions caught during atom storage.
 ///
 /// Atoms are stored asynchronously, from a write queue, from some
@@ -303,7 +322,7 @@ void SQLAtomStorage::rename_tables(void)
 
 void SQLAtomStorage::create_database(void)
 {
-	const std::string& uri(_name);
+	const std::string& uri(_name.str());
 
 	// Parse the URI and make a valiant attempt to extract a
 	// database name from it. This ignores any usernames or
@@ -382,6 +401,7 @@ void SQLAtomStorage::create_tables(void)
 	            "floatvalue DOUBLE PRECISION[],"
 	            "stringvalue TEXT[],"
 	            "linkvalue BIGINT[],"
+	            "packedvalue BYTEA,"
 	            "UNIQUE (key, atom));");
 
 	rp.exec("CREATE INDEX ON Valuations (atom);");
@@ -391,7 +411,8 @@ void SQLAtomStorage::create_tables(void)
 	            "type  SMALLINT,"
 	            "floatvalue DOUBLE PRECISION[],"
 	            "stringvalue TEXT[],"
-	            "linkvalue BIGINT[]);");
+	            "linkvalue BIGINT[],"
+	            "packedvalue BYTEA);");
 
 	rp.exec("CREATE TABLE TypeCodes ("
 	            "type SMALLINT UNIQUE,"
@@ -401,6 +422,7 @@ void SQLAtomStorage::create_tables(void)
 	rp.exec("CREATE SEQUENCE vuid_pool START WITH 1 INCREMENT BY 400;");
 
 	type_map_was_loaded = false;
+	_have_packed = true;
 }
 
 /**
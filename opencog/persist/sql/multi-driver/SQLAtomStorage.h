@@ -28,6 +28,7 @@
 #include <atomic>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 // #include <opencog/util/async_method_caller.h>
@@ -72,6 +73,11 @@ class SQLAtomStorage : public StorageNode
 		int _server_version;
 		void get_server_version(void);
 
+		// True if the tables have the packedvalue column (version 3.2
+		// of the schema). If so, FloatValues are stored there.
+		bool _have_packed;
+		void check_packed(void);
+
 		void connect(const char *);
 
 		// ---------------------------------------------
@@ -104,6 +110,8 @@ class SQLAtomStorage : public StorageNode
 		int getMaxObservedHeight(void);
 		int max_height;
 
+		void load_chunk_binary(AtomSpace*, int, UUID, UUID);
+
 		void getIncoming(AtomSpace&, const char *);
 		// --------------------------
 		// Storing of atoms
@@ -136,6 +144,7 @@ class SQLAtomStorage : public StorageNode
 		std::mutex _value_mutex[NUMVMUT];
 		void store_atom_values(const Handle &);
 		void get_atom_values(Handle &);
+		void get_batch_values(const HandleSeq&, const Handle&);
 
 		typedef unsigned long VUID;
 
@@ -156,6 +165,7 @@ class SQLAtomStorage : public StorageNode
 		void deleteAllValuations(Response&, UUID);
 
 		std::string float_to_string(const FloatValuePtr&);
+		std::string float_to_packed(const FloatValuePtr&);
 		std::string string_to_string(const StringValuePtr&);
 		std::string link_to_string(const LinkValuePtr&);
 
@@ -165,6 +175,7 @@ class SQLAtomStorage : public StorageNode
 		// UUID management
 		UUID check_uuid(const Handle&);
 		UUID get_uuid(const Handle&);
+		void resolve_uuids(const HandleSeq&);
 
 		UUID getMaxObservedUUID(void);
 		VUID getMaxObservedVUID(void);
@@ -244,7 +255,8 @@ class SQLAtomStorage : public StorageNode
 		SQLAtomStorage(std::string uri);
 		virtual ~SQLAtomStorage();
 		void open(void);
-		void close(void) { barrier(); /* FIXME we should do more */ }
+		void close(void) {
+			barrier(); _residency->detach(); /* FIXME we should do more */ }
 		void connect(void);
 		bool connected(void); // connection to DB is alive
 
@@ -262,12 +274,16 @@ class SQLAtomStorage : public StorageNode
 		// AtomStorage interface
 		Handle getNode(Type, const char *);
 		Handle getLink(Type, const HandleSeq&);
+		bool loadAtom(const Handle& h) { return getAtomCompat(h); }
 		void fetchIncomingSet(AtomSpace*, const Handle&);
 		void fetchIncomingByType(AtomSpace*, const Handle&, Type t);
+		void fetchIncomingSets(AtomSpace*, const HandleSeq&);
+		void getAtoms(const HandleSeq&);
 		void storeAtom(const Handle&, bool synchronous = false);
 		void removeAtom(AtomSpace*, const Handle&, bool recursive);
 		void storeValue(const Handle&, const Handle&);
 		void loadValue(const Handle&, const Handle&);
+		void loadValues(const HandleSeq&, const Handle&);
 		void loadType(AtomSpace*, Type);
 		void barrier(AtomSpace* = nullptr);
 		void flushStoreQueue();
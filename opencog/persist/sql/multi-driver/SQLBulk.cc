@@ -44,6 +44,7 @@
 using namespace opencog;
 
 #define BUFSZ 120
+#define BATCHSZ 1000
 /* ================================================================ */
 /**
  * Retrieve the incoming set of the indicated atom.
@@ -109,6 +110,37 @@ void SQLAtomStorage::fetchIncomingSet(AtomSpace* table, const Handle& h)
 	getIncoming(*table, buff);
 }
 
+/**
+ * Retrieve the incoming sets of many atoms at once. The `&&` (overlap)
+ * operator finds all links that contain any one of the atoms, so that
+ * a chunk of incoming sets is obtained with just one query.
+ */
+void SQLAtomStorage::fetchIncomingSets(AtomSpace* table, const HandleSeq& hs)
+{
+	rethrow();
+
+	std::vector<UUID> uuids;
+	for (const Handle& h : hs)
+	{
+		if (nullptr == h) continue;
+		UUID uuid = check_uuid(h);
+		if (TLB::INVALID_UUID != uuid) uuids.push_back(uuid);
+	}
+
+	for (size_t i = 0; i < uuids.size(); i += BATCHSZ)
+	{
+		size_t end = std::min(i + BATCHSZ, uuids.size());
+		std::string qstr = "SELECT * FROM Atoms WHERE outgoing && ARRAY[";
+		for (size_t j = i; j < end; j++)
+		{
+			if (i != j) qstr += ", ";
+			qstr += std::to_string(uuids[j]);
+		}
+		qstr += "]::BIGINT[];";
+		getIncoming(*table, qstr.c_str());
+	}
+}
+
 /**
  * Retrieve the incoming set of the indicated atom, but only those atoms
  * of type t.
@@ -143,6 +175,67 @@ int SQLAtomStorage::getMaxObservedHeight(void)
 	return rp.intval;
 }
 
+/**
+ * Load all atoms of height `hei` having uuids in the range (lo, hi].
+ *
+ * This is a faster variant of the text-based loader below, used when
+ * the postgres native driver is in use. The rows are requested in
+ * binary format and streamed one row at a time, so that the uuids,
+ * types and outgoing-set arrays are decoded directly, without any
+ * string parsing. The entire chunk is decoded first; since all of
+ * the rows are at the same height, the outgoing sets are already in
+ * the TLB, and the chunk can then be inserted into the AtomSpace in
+ * one tight loop. Finally, the values on all of the atoms in the
+ * chunk are fetched with a single query, instead of one query per
+ * atom.
+ */
+void SQLAtomStorage::load_chunk_binary(AtomSpace* table, int hei,
+                                       UUID lo, UUID hi)
+{
+	char buff[2*BUFSZ];
+	std::vector<PseudoPtr> pset;
+	{
+		Response rp(conn_pool);
+		rp.store = this;
+		rp.height = hei;
+		rp.pvec = &pset;
+		snprintf(buff, 2*BUFSZ, "SELECT uuid, type, name, outgoing "
+		         "FROM Atoms WHERE "
+		         "height = %d AND uuid > %lu AND uuid <= %lu;",
+		         hei, lo, hi);
+		rp.exec_binary(buff);
+		rp.rs->foreach_row(&Response::bulk_atom_cb, &rp);
+	}
+
+	if (0 == pset.size()) return;
+
+	for (const PseudoPtr& p : pset)
+	{
+		// Corrupted databases can cause get_recursive_if_not_exists
+		// to throw. Skip the offending atom, and carry on.
+		try
+		{
+			Handle atom(get_recursive_if_not_exists(p));
+			Handle h(table->storage_add_nocheck(atom));
+			_tlbuf.addAtom(h, p->uuid);
+		}
+		catch (const IOException& ex) {}
+	}
+
+	// Get the values only after TLB insertion!!
+	Response rp(conn_pool);
+	rp.store = this;
+	rp.table = table;
+	rp.lazy = lazy_values();
+	snprintf(buff, 2*BUFSZ, "SELECT %s FROM Valuations WHERE atom IN "
+	         "(SELECT uuid FROM Atoms WHERE "
+	         "height = %d AND uuid > %lu AND uuid <= %lu);",
+	         rp.lazy ? "key, atom" : "*", hei, lo, hi);
+	rp.exec(buff);
+	rp.rs->foreach_row(&Response::get_chunk_values_cb, &rp);
+	rp.atom = nullptr;
+}
+
 void SQLAtomStorage::loadAtomSpace(AtomSpace* table)
 {
 	rethrow();
@@ -177,6 +270,12 @@ void SQLAtomStorage::loadAtomSpace(AtomSpace* table)
 		OMP_ALGO::for_each(steps.begin(), steps.end(),
 			[&](unsigned long rec)
 		{
+			if (_use_libpq)
+			{
+				load_chunk_binary(table, hei, rec, rec+stepsize);
+				return;
+			}
+
 			Response rp(conn_pool);
 			rp.table = table;
 			rp.store = this;
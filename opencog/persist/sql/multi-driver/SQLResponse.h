@@ -25,7 +25,9 @@
  * Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
+#include <endian.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <opencog/atoms/base/Atom.h>
@@ -58,6 +60,10 @@ class SQLAtomStorage::Response
 		const char* outlist;
 		int height;
 
+		// Outgoing set, when decoded from a binary-format row.
+		bool binary;
+		std::vector<UUID> outvec;
+
 		// Values
 		double *floatval;
 		const char *stringval;
@@ -74,6 +80,7 @@ class SQLAtomStorage::Response
 		    name(nullptr),
 		    outlist(nullptr),
 		    height(0),
+		    binary(false),
 		    floatval(0),
 		    stringval(nullptr),
 		    linkval(nullptr),
@@ -82,11 +89,14 @@ class SQLAtomStorage::Response
 		    table(nullptr),
 		    store(nullptr),
 		    pvec(nullptr),
+		    atom_map(nullptr),
+		    lazy(false),
 		    uvec(nullptr),
 		    tname(""),
 		    fltval(0),
 		    strval(nullptr),
 		    lnkval(nullptr),
+		    pkdval(nullptr),
 		    intval(0)
 		{}
 
@@ -117,6 +127,13 @@ class SQLAtomStorage::Response
 			if (nullptr == _conn) _conn = _pool.value_pop();
 			rs = _conn->exec(buff, true);
 		}
+		void exec_binary(const char * buff)
+		{
+			if (rs) rs->release();
+			if (nullptr == _conn) _conn = _pool.value_pop();
+			rs = _conn->exec_binary(buff);
+			binary = true;
+		}
 		void exec(const std::string& str)
 		{
 			exec(str.c_str());
@@ -220,6 +237,89 @@ class SQLAtomStorage::Response
 			return false;
 		}
 
+		// Binary-format fetching of atoms -------------------------
+		// Postgres sends integers in network byte order; arrays are
+		// sent as a header, followed by length-prefixed elements.
+		static uint16_t pg_int2(const char* p)
+		{
+			uint16_t v; memcpy(&v, p, sizeof(v)); return be16toh(v);
+		}
+		static uint32_t pg_int4(const char* p)
+		{
+			uint32_t v; memcpy(&v, p, sizeof(v)); return be32toh(v);
+		}
+		static uint64_t pg_int8(const char* p)
+		{
+			uint64_t v; memcpy(&v, p, sizeof(v)); return be64toh(v);
+		}
+
+		// Decode a one-dimensional BIGINT[] array. The header is
+		// ndim, has-nulls flag, element type oid, and then, for each
+		// dimension, the size and lower bound. NULL arrays and empty
+		// arrays both decode as empty.
+		void decode_oset(const char* p, int len)
+		{
+			outvec.clear();
+			if (len < 12) return;
+			uint32_t ndim = pg_int4(p);
+			if (1 != ndim) return;
+
+			uint32_t nelts = pg_int4(p+12);
+			outvec.reserve(nelts);
+			const char* e = p + 20;
+			const char* end = p + len;
+			for (uint32_t i=0; i<nelts and e+4 <= end; i++)
+			{
+				int32_t elen = pg_int4(e);
+				e += 4;
+				if (elen < 0) continue; // NULL element; skip it.
+				outvec.emplace_back(pg_int8(e));
+				e += elen;
+			}
+		}
+
+		bool binary_atom_column_cb(const char *colname,
+		                           const char * colvalue, int len)
+		{
+			// if (!strcmp(colname, "type"))
+			if ('t' == colname[0])
+			{
+				itype = pg_int2(colvalue);
+			}
+			// else if (!strcmp(colname, "name"))
+			else if ('n' == colname[0])
+			{
+				// libpq always null-terminates, even binary values.
+				name = colvalue;
+			}
+			// else if (!strcmp(colname, "outgoing"))
+			else if ('o' == colname[0])
+			{
+				decode_oset(colvalue, len);
+			}
+			// else if (!strcmp(colname, "uuid"))
+			else if ('u' == colname[0])
+			{
+				uuid = pg_int8(colvalue);
+			}
+			return false;
+		}
+
+		// Decode a binary row into a PseudoAtom; the caller is
+		// responsible for inserting them into the AtomSpace.
+		bool bulk_atom_cb(void)
+		{
+			rs->foreach_column_binary(&Response::binary_atom_column_cb, this);
+
+			// Skip atoms with unknown types; see load_all_atoms_cb().
+			try
+			{
+				pvec->emplace_back(store->makeAtom(*this, uuid));
+			}
+			catch (const IOException& ex) {}
+			return false;
+		}
+
 		std::vector<PseudoPtr> *pvec;
 		bool fetch_incoming_set_cb(void)
 		{
@@ -284,6 +384,7 @@ class SQLAtomStorage::Response
 		const char * fltval;
 		const char * strval;
 		const char * lnkval;
+		const char * pkdval;
 		UUID key;
 		bool get_value_cb(void)
 		{
@@ -310,6 +411,11 @@ class SQLAtomStorage::Response
 			{
 				lnkval = colvalue;
 			}
+			// else if (!strcmp(colname, "packedvalue"))
+			else if ('p' == colname[0])
+			{
+				pkdval = colvalue;
+			}
 			// else if (!strcmp(colname, "type"))
 			else if ('t' == colname[0])
 			{
@@ -331,7 +437,35 @@ class SQLAtomStorage::Response
 		bool get_all_values_cb(void)
 		{
 			rs->foreach_column(&Response::get_value_column_cb, this);
+			install_value();
+			return false;
+		}
 
+		// Same as above, except that the rows are for many different
+		// atoms. These are looked up in the atom_map, if it is given,
+		// else they must already be in the TLB.
+		const std::unordered_map<UUID, Handle>* atom_map;
+		bool get_chunk_values_cb(void)
+		{
+			rs->foreach_column(&Response::get_value_column_cb, this);
+			if (atom_map)
+			{
+				auto it = atom_map->find(uuid);
+				if (atom_map->end() == it) return false;
+				atom = it->second;
+			}
+			else
+				atom = store->_tlbuf.getAtom(uuid);
+			if (nullptr == atom) return false;
+			install_value();
+			return false;
+		}
+
+		// If set, place the lazy placeholder on the atom, instead
+		// of the value. Only the key and atom columns are needed.
+		bool lazy;
+		void install_value(void)
+		{
 			Handle hkey(store->_tlbuf.getAtom(key));
 			if (nullptr == hkey)
 			{
@@ -359,9 +493,9 @@ class SQLAtomStorage::Response
 				store->_tlbuf.addAtom(hkey, key);
 			}
 
-			ValuePtr pap = store->doUnpackValue(*this);
+			ValuePtr pap = lazy ? store->lazy_value()
+			                    : store->doUnpackValue(*this);
 			atom->setValue(hkey, pap);
-			return false;
 		}
 
 		// Generic things --------------------------------------------
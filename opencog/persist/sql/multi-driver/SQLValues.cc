@@ -24,9 +24,11 @@
 #include <unistd.h>
 
 #include <iomanip>
+#include <map>
 
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/value/FloatCodec.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
@@ -71,6 +73,15 @@ std::string SQLAtomStorage::float_to_string(const FloatValuePtr& fvle)
 	return str;
 }
 
+/// The packed form of the FloatValue, as a bytea literal.
+std::string SQLAtomStorage::float_to_packed(const FloatValuePtr& fvle)
+{
+	std::string str = "decode('";
+	base64_encode(str, pack_floats(fvle->value()));
+	str += "', 'base64')";
+	return str;
+}
+
 std::string SQLAtomStorage::string_to_string(const StringValuePtr& svle)
 {
 	const char delim {'\\'};
@@ -249,8 +260,16 @@ void SQLAtomStorage::storeValuation(const Handle& key,
 	if (nameserver().isA(vtype, FLOAT_VALUE))
 	{
 		FloatValuePtr fvp = FloatValueCast(pap);
-		std::string fstr = float_to_string(fvp);
-		STMT("floatvalue", fstr);
+		if (_have_packed)
+		{
+			std::string pstr = float_to_packed(fvp);
+			STMT("packedvalue", pstr);
+		}
+		else
+		{
+			std::string fstr = float_to_string(fvp);
+			STMT("floatvalue", fstr);
+		}
 	}
 	else
 	if (nameserver().isA(vtype, STRING_VALUE))
@@ -337,8 +356,16 @@ SQLAtomStorage::VUID SQLAtomStorage::storeValue(const ValuePtr& pap)
 	if (nameserver().isA(vtype, FLOAT_VALUE))
 	{
 		FloatValuePtr fvp = FloatValueCast(pap);
-		std::string fstr = float_to_string(fvp);
-		STMT("floatvalue", fstr);
+		if (_have_packed)
+		{
+			std::string pstr = float_to_packed(fvp);
+			STMT("packedvalue", pstr);
+		}
+		else
+		{
+			std::string fstr = float_to_string(fvp);
+			STMT("floatvalue", fstr);
+		}
 	}
 	else
 	if (nameserver().isA(vtype, STRING_VALUE))
@@ -477,18 +504,45 @@ ValuePtr SQLAtomStorage::doUnpackValue(Response& rp)
 
 	// We expect rp.fltval to be of the form
 	// {1.1,2.2,3.3}
+	// unless the packed form was stored. That one arrives as text,
+	// in the postgres hex format: \x0103... A NULL packed column
+	// arrives as either a null pointer or an empty string. Anything
+	// else (e.g. bytea_output=escape) cannot be decoded here, and the
+	// fltval column is NULL, so give up, instead of returning nothing.
 	if ((vtype == FLOAT_VALUE)
 	    or nameserver().isA(vtype, TRUTH_VALUE))
 	{
 		std::vector<double> fltarr;
-		char *p = (char *) rp.fltval;
-		if (p and *p == '{') p++;
-		while (p)
+		const char *x = rp.pkdval;
+		if (x and '\0' != x[0])
 		{
-			if (*p == '}' or *p == '\0') break;
-			double flt = strtod(p, &p);
-			fltarr.emplace_back(flt);
-			p++; // skip over  comma
+			if ('\\' != x[0] or 'x' != x[1])
+				throw IOException(TRACE_INFO,
+					"Packed value is not in hex format; "
+					"is bytea_output set to 'escape'? value=%.20s", x);
+
+			std::string bytes;
+			for (x += 2; isxdigit(x[0]) and isxdigit(x[1]); x += 2)
+			{
+				char hex[3] = {x[0], x[1], 0};
+				bytes += (char) strtol(hex, nullptr, 16);
+			}
+			if ('\0' != x[0])
+				throw IOException(TRACE_INFO,
+					"Malformed packed value=%.20s", rp.pkdval);
+			fltarr = unpack_floats(bytes);
+		}
+		else
+		{
+			char *p = (char *) rp.fltval;
+			if (p and *p == '{') p++;
+			while (p)
+			{
+				if (*p == '}' or *p == '\0') break;
+				double flt = strtod(p, &p);
+				fltarr.emplace_back(flt);
+				p++; // skip over  comma
+			}
 		}
 		if (vtype == FLOAT_VALUE)
 			return createFloatValue(fltarr);
@@ -606,10 +660,12 @@ void SQLAtomStorage::get_atom_values(Handle& atom)
 {
 	if (nullptr == atom) return;
 
+	// If lazy, the values themselves are fetched later, one at a time.
+	bool lazy = lazy_values();
 	char buff[BUFSZ];
 	snprintf(buff, BUFSZ,
-		"SELECT * FROM Valuations WHERE atom = %lu;",
-		get_uuid(atom));
+		"SELECT %s FROM Valuations WHERE atom = %lu;",
+		lazy ? "key, atom" : "*", get_uuid(atom));
 
 	Response rp(conn_pool);
 	rp.exec(buff);
@@ -617,6 +673,7 @@ void SQLAtomStorage::get_atom_values(Handle& atom)
 	rp.store = this;
 	rp.atom = atom;
 	rp.table = nullptr;
+	rp.lazy = lazy;
 	rp.rs->foreach_row(&Response::get_all_values_cb, &rp);
 	rp.atom = nullptr;
 }
@@ -644,6 +701,196 @@ void SQLAtomStorage::loadValue(const Handle& atom, const Handle& key)
 	catch (const NotFoundException& ex) {}
 }
 
+/* ================================================================== */
+/// Batched fetch of values. All of the Valuations for a chunk of
+/// atoms are obtained with a single query, instead of one query per
+/// atom. If the key is not null, then only that key is fetched.
+/// Atoms that are not in the database are skipped. If the key is
+/// null, and lazy values are enabled, then only the keys are fetched.
+
+#define BATCHSZ 1000
+
+/// Look up the UUIDs of all of the given Atoms, and place them in the
+/// TLB, using one query per chunk of Atoms, instead of one per Atom.
+/// Atoms that are not in the database stay unknown. A Link can only
+/// be looked up once the UUIDs of its outgoing set are known, so the
+/// Atoms are looked up in rounds: first Nodes, then the Links holding
+/// only known Atoms, and so on.
+void SQLAtomStorage::resolve_uuids(const HandleSeq& hs)
+{
+	// Nothing can be in the database yet.
+	if (bulk_store) return;
+
+	// The unknown Atoms, and the unknown Atoms under them.
+	HandleSet todo;
+	HandleSeq stack;
+	for (const Handle& h : hs)
+		if (h) stack.push_back(h);
+	while (not stack.empty())
+	{
+		Handle h(stack.back());
+		stack.pop_back();
+		UUID uuid = _tlbuf.getUUID(h);
+		if (TLB::INVALID_UUID != uuid and nullptr != _tlbuf.getAtom(uuid))
+			continue;
+		if (not todo.insert(h).second) continue;
+		if (h->is_link())
+			for (const Handle& ho : h->getOutgoingSet())
+				stack.push_back(ho);
+	}
+
+	setup_typemap();
+	while (not todo.empty())
+	{
+		// The Atoms that can be looked up in this round, by content.
+		std::map<std::pair<Type, std::string>, Handle> nodes;
+		std::map<std::pair<Type, std::vector<UUID>>, Handle> links;
+		std::vector<std::string> terms;
+		for (const Handle& h : todo)
+		{
+			Type t = h->get_type();
+			if (h->is_node())
+			{
+				nodes[{t, h->get_name()}] = h;
+				terms.push_back("(type = " +
+					std::to_string(storing_typemap[t]) +
+					" AND name = $ocp$" + h->get_name() + "$ocp$)");
+				continue;
+			}
+
+			std::vector<UUID> oset;
+			for (const Handle& ho : h->getOutgoingSet())
+			{
+				UUID uuid = _tlbuf.getUUID(ho);
+				if (TLB::INVALID_UUID == uuid or
+				    nullptr == _tlbuf.getAtom(uuid)) break;
+				oset.push_back(uuid);
+			}
+			if (oset.size() != h->get_arity()) continue;
+
+			links[{t, oset}] = h;
+			terms.push_back("(type = " +
+				std::to_string(storing_typemap[t]) +
+				" AND outgoing = " + oset_to_string(h->getOutgoingSet()) + ")");
+		}
+
+		// The rest hold Atoms that are not in the database, and so
+		// are not in it either.
+		if (terms.empty()) return;
+
+		std::vector<PseudoPtr> found;
+		for (size_t i = 0; i < terms.size(); i += BATCHSZ)
+		{
+			size_t end = std::min(i + BATCHSZ, terms.size());
+			std::string qstr = "SELECT * FROM Atoms WHERE ";
+			for (size_t j = i; j < end; j++)
+			{
+				if (i != j) qstr += " OR ";
+				qstr += terms[j];
+			}
+			qstr += ";";
+
+			Response rp(conn_pool);
+			rp.store = this;
+			rp.height = -1;
+			rp.pvec = &found;
+			rp.exec(qstr.c_str());
+			rp.rs->foreach_row(&Response::fetch_incoming_set_cb, &rp);
+		}
+
+		// Same as doGetNode() and doGetLink(), for each one found.
+		_num_get_nodes += nodes.size();
+		_num_get_links += links.size();
+		for (const PseudoPtr& p : found)
+		{
+			Handle h;
+			if (nameserver().isA(p->type, NODE))
+			{
+				auto it = nodes.find({p->type, p->name});
+				if (nodes.end() == it) continue;
+				h = createNode(p->type, std::string(p->name));
+				_num_got_nodes++;
+			}
+			else
+			{
+				auto it = links.find({p->type, p->oset});
+				if (links.end() == it) continue;
+				h = createLink(HandleSeq(it->second->getOutgoingSet()),
+				               p->type);
+				_num_got_links++;
+			}
+			_tlbuf.addAtom(h, p->uuid);
+		}
+
+		for (const auto& pr : nodes) todo.erase(pr.second);
+		for (const auto& pr : links) todo.erase(pr.second);
+	}
+}
+
+void SQLAtomStorage::get_batch_values(const HandleSeq& hs, const Handle& key)
+{
+	bool lazy = (nullptr == key) and lazy_values();
+	std::string kstr;
+	if (key)
+	{
+		try { kstr = "key = " + std::to_string(get_uuid(key)) + " AND "; }
+		catch (const NotFoundException& ex) { return; }
+	}
+
+	// The values are placed on the Atoms that were passed in, and not
+	// on the TLB versions of them, so keep a map. The UUIDs are all
+	// looked up at once; whatever is still unknown is not stored.
+	resolve_uuids(hs);
+	std::unordered_map<UUID, Handle> amap;
+	std::vector<UUID> uuids;
+	for (const Handle& h : hs)
+	{
+		if (nullptr == h) continue;
+		UUID uuid = _tlbuf.getUUID(h);
+		if (TLB::INVALID_UUID == uuid or nullptr == _tlbuf.getAtom(uuid))
+			continue;
+		if (amap.emplace(uuid, h).second) uuids.push_back(uuid);
+	}
+
+	for (size_t i = 0; i < uuids.size(); i += BATCHSZ)
+	{
+		size_t end = std::min(i + BATCHSZ, uuids.size());
+		std::string qstr = "SELECT ";
+		qstr += lazy ? "key, atom" : "*";
+		qstr += " FROM Valuations WHERE " + kstr;
+		qstr += "atom IN (";
+		for (size_t j = i; j < end; j++)
+		{
+			if (i != j) qstr += ", ";
+			qstr += std::to_string(uuids[j]);
+		}
+		qstr += ");";
+
+		Response rp(conn_pool);
+		rp.exec(qstr.c_str());
+
+		rp.store = this;
+		rp.table = nullptr;
+		rp.atom_map = &amap;
+		rp.lazy = lazy;
+		rp.rs->foreach_row(&Response::get_chunk_values_cb, &rp);
+		rp.atom = nullptr;
+	}
+}
+
+void SQLAtomStorage::getAtoms(const HandleSeq& hs)
+{
+	rethrow();
+	get_batch_values(hs, Handle::UNDEFINED);
+}
+
+void SQLAtomStorage::loadValues(const HandleSeq& hs, const Handle& key)
+{
+	rethrow();
+	if (nullptr == key) return;
+	get_batch_values(hs, key);
+}
+
 void SQLAtomStorage::storeValue(const Handle& atom, const Handle& key)
 {
 	rethrow();
@@ -1,6 +1,13 @@
 --
 -- atom.sql
--- Version 3.1 of the Postgres database schema for the AtomSpace.
+-- Version 3.2 of the Postgres database schema for the AtomSpace.
+--
+-- Changes since version 3.1:
+--   * Add packedvalue column, for compact storage of FloatValues.
+--     Older databases can be upgraded with
+--        ALTER TABLE Valuations ADD COLUMN packedvalue BYTEA;
+--        ALTER TABLE Values ADD COLUMN packedvalue BYTEA;
+--     Databases without this column continue to work as before.
 --
 -- Changes since version 3.0:
 --   * Add SEQUENCE's for multi-user uuid and vuid alloc's.
@@ -96,6 +103,11 @@ CREATE TABLE Valuations (
     stringvalue TEXT[],
     linkvalue BIGINT[], -- ELEMENT REFERENCES Values(vuid),
 
+    -- FloatValues and TruthValues, in the packed binary format of
+    -- opencog/atoms/value/FloatCodec.h. If present, this is used
+    -- instead of the floatvalue column.
+    packedvalue BYTEA,
+
     UNIQUE (key, atom)
 );
 
@@ -119,7 +131,8 @@ CREATE TABLE Values (
     -- but it's not yet implemented in postgres.
     floatvalue DOUBLE PRECISION[],
     stringvalue TEXT[],
-    linkvalue BIGINT[] -- ELEMENT REFERENCES Values(vuid)
+    linkvalue BIGINT[], -- ELEMENT REFERENCES Values(vuid)
+    packedvalue BYTEA
 );
 
 -- -----------------------------------------------------------
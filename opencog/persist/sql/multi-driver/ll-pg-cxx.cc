@@ -139,6 +139,43 @@ LLPGConnection::exec(const char * buff, bool trial_run)
 
 /* =========================================================== */
 
+/// Run the query, asking for results in the postgres binary format,
+/// and delivered in single-row mode. Binary results avoid the
+/// printing of integers and arrays to text on the server, and the
+/// parsing of them on this end. Single-row mode avoids buffering the
+/// entire result set in RAM before the first row can be looked at.
+LLRecordSet *
+LLPGConnection::exec_binary(const char * buff)
+{
+	if (!is_connected) return NULL;
+
+	// The last argument, resultFormat=1, asks for binary results.
+	int rc = PQsendQueryParams(_pgconn, buff, 0,
+	                           nullptr, nullptr, nullptr, nullptr, 1);
+	if (0 == rc or 0 == PQsetSingleRowMode(_pgconn))
+	{
+		std::string msg = "PQsendQueryParams message: ";
+		msg += PQerrorMessage(_pgconn);
+		msg += "\nPQ query was: ";
+		msg += buff;
+
+		// Drain anything that might have been queued up.
+		PGresult* res;
+		while ((res = PQgetResult(_pgconn))) PQclear(res);
+
+		opencog::logger().warn("%s", msg.c_str());
+		throw opencog::RuntimeException(TRACE_INFO,
+			"Failed to execute SQL command!\n%s", msg.c_str());
+	}
+
+	LLPGRecordSet* rs = get_record_set();
+	rs->_single_row = true;
+	rs->ncols = -1;
+	return rs;
+}
+
+/* =========================================================== */
+
 void
 LLPGRecordSet::setup_cols(int new_ncols)
 {
@@ -152,6 +189,10 @@ LLPGRecordSet::setup_cols(int new_ncols)
 	values = new char*[new_ncols];
 	memset(values, 0, new_ncols * sizeof(char*));
 
+	if (vsizes) delete[] vsizes;
+	vsizes = new int[new_ncols];
+	memset(vsizes, 0, new_ncols * sizeof(int));
+
    arrsize = new_ncols;
 }
 
@@ -165,6 +206,7 @@ LLPGRecordSet::LLPGRecordSet(LLPGConnection* _conn)
 	_result = nullptr;
 	_nrows = -1;
 	_curr_row = -1;
+	_single_row = false;
 }
 
 /* =========================================================== */
@@ -174,11 +216,23 @@ LLPGRecordSet::release(void)
 {
 	PQclear(_result);
 	_result = nullptr;
+
+	// If the caller stopped reading rows early, the remainder of
+	// the streamed result must be drained, before the connection
+	// can be used again.
+	if (_single_row)
+	{
+		PGconn* pgconn = ((LLPGConnection*) conn)->_pgconn;
+		PGresult* res;
+		while ((res = PQgetResult(pgconn))) PQclear(res);
+		_single_row = false;
+	}
 	_nrows = -1;
 	_curr_row = -1;
 	ncols = -1;
 	memset(column_labels, 0, arrsize * sizeof(char*));
 	memset(values, 0, arrsize * sizeof(char*));
+	memset(vsizes, 0, arrsize * sizeof(int));
 	LLRecordSet::release();
 }
 
@@ -216,6 +270,8 @@ LLPGRecordSet::get_column_labels(void)
 bool
 LLPGRecordSet::fetch_row(void)
 {
+	if (_single_row) return fetch_single_row();
+
 	if (_nrows < 0)
 	{
 		_curr_row = 0;
@@ -228,10 +284,66 @@ LLPGRecordSet::fetch_row(void)
 	for (int i=0; i< ncols; i++)
 	{
 		values[i] = PQgetvalue(_result, _curr_row, i);
+		vsizes[i] = PQgetlength(_result, _curr_row, i);
 	}
 	_curr_row++;
 	return true;
 }
 
+/* =========================================================== */
+
+/// In single-row mode, each row arrives as it's own PGresult;
+/// the last one is an empty PGRES_TUPLES_OK result.
+bool
+LLPGRecordSet::fetch_single_row(void)
+{
+	PGconn* pgconn = ((LLPGConnection*) conn)->_pgconn;
+
+	PQclear(_result);
+	_result = PQgetResult(pgconn);
+	if (nullptr == _result)
+	{
+		_single_row = false;
+		return false;
+	}
+
+	ExecStatusType rest = PQresultStatus(_result);
+	if (PGRES_SINGLE_TUPLE != rest)
+	{
+		std::string msg;
+		if (PGRES_TUPLES_OK != rest)
+		{
+			msg = "PQresult message: ";
+			msg += PQresultErrorMessage(_result);
+		}
+
+		// Drain the final null result, so that the connection
+		// is ready for the next query.
+		PQclear(_result);
+		_result = nullptr;
+		PGresult* res;
+		while ((res = PQgetResult(pgconn))) PQclear(res);
+		_single_row = false;
+
+		if (PGRES_TUPLES_OK == rest) return false;
+
+		opencog::logger().warn("%s", msg.c_str());
+		throw opencog::RuntimeException(TRACE_INFO,
+			"Failed to fetch SQL row!\n%s", msg.c_str());
+	}
+
+	// The column labels are owned by the PGresult, which changes
+	// with every row. So they must be refreshed every time.
+	ncols = -1;
+	get_column_labels();
+
+	for (int i=0; i< ncols; i++)
+	{
+		values[i] = PQgetvalue(_result, 0, i);
+		vsizes[i] = PQgetlength(_result, 0, i);
+	}
+	return true;
+}
+
 #endif /* HAVE_PGSQL_STORAGE */
 /* ============================= END OF FILE ================= */
@@ -49,6 +49,7 @@ class LLPGConnection : public LLConnection
 		~LLPGConnection();
 
 		LLRecordSet *exec(const char *, bool);
+		LLRecordSet *exec_binary(const char *);
 };
 
 class LLPGRecordSet : public LLRecordSet
@@ -59,6 +60,11 @@ class LLPGRecordSet : public LLRecordSet
 		int _nrows;
 		int _curr_row;
 
+		// True if rows are streamed one at a time, as a result of
+		// exec_binary(); see PQsetSingleRowMode() in the libpq docs.
+		bool _single_row;
+		bool fetch_single_row(void);
+
 		void setup_cols(int ncols);
 		LLPGRecordSet(LLPGConnection *);
 		~LLPGRecordSet();
@@ -65,6 +65,16 @@ LLConnection::~LLConnection()
     }
 }
 
+/* =========================================================== */
+
+LLRecordSet *
+LLConnection::exec_binary(const char * buff)
+{
+    throw opencog::RuntimeException(TRACE_INFO,
+        "This database driver does not support binary queries!");
+    return nullptr;
+}
+
 /* =========================================================== */
 /* pseudo-private routine */
 
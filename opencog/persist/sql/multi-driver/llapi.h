@@ -52,6 +52,13 @@ class LLConnection
         bool connected(void) const { return is_connected; }
 
         virtual LLRecordSet *exec(const char *, bool=false) = 0;
+
+        // Run the query, returning results in the driver's native
+        // binary wire format, one row at a time, instead of as text.
+        // Column values are then raw bytes; use foreach_column_binary()
+        // to obtain their lengths. Not all drivers support this; the
+        // default implementation throws.
+        virtual LLRecordSet *exec_binary(const char *);
 };
 
 class LLRecordSet
@@ -114,6 +121,27 @@ class LLRecordSet
             }
             return false;
         }
+
+        // Same as above, but also passes the length, in bytes, of
+        // each column value. Intended for use with exec_binary(),
+        // where the values are not null-terminated strings.
+        template<class T> bool
+            foreach_column_binary(bool (T::*cb)(const char *, const char *, int),
+                                  T *data)
+        {
+            int i;
+            if (0 > ncols)
+            {
+                get_column_labels();
+            }
+
+            for (i=0; i<ncols; i++)
+            {
+                bool rc = (data->*cb) (column_labels[i], values[i], vsizes[i]);
+                if (rc) return rc;
+            }
+            return false;
+        }
 };
 
 /**
@@ -34,11 +34,32 @@ TLB::TLB(uuid_pool* allocator)
 		_uuid_pool = allocator;
 }
 
+#define SHARED_LOCK(S) std::shared_lock<std::shared_mutex> lck(S.mtx);
+#define UNIQUE_LOCK(S) std::unique_lock<std::shared_mutex> lck(S.mtx);
+
 void TLB::clear()
 {
-    std::lock_guard<std::mutex> lck(_mtx);
-    _handle_map.clear();
-    _uuid_map.clear();
+    for (HandleShard& hs : _handle_shards)
+    {
+        UNIQUE_LOCK(hs);
+        hs.map.clear();
+    }
+    for (UuidShard& us : _uuid_shards)
+    {
+        UNIQUE_LOCK(us);
+        us.map.clear();
+    }
+}
+
+size_t TLB::size()
+{
+    size_t sz = 0;
+    for (UuidShard& us : _uuid_shards)
+    {
+        SHARED_LOCK(us);
+        sz += us.map.size();
+    }
+    return sz;
 }
 
 // ===================================================
@@ -84,19 +105,27 @@ UUID TLB::addAtom(const Handle& h, UUID uuid)
             addAtom(ho, TLB::INVALID_UUID);
     }
 
-    std::lock_guard<std::mutex> lck(_mtx);
+    // The h and hr are content-equal, and so hash to the same shard.
+    // Hold the handle shard for the duration; the uuid shards are
+    // locked only briefly, and always after the handle shard.
+    HandleShard& hs = hshard(hr);
+    UNIQUE_LOCK(hs);
 
     // If we hold something that isn't the atomspace's version,
     // then remove it. Only the atomspace's version has the
     // correct values (including the TV) on it.
     if (hr != h)
     {
-        auto pr = _handle_map.find(h);
-        if (_handle_map.end() != pr)
+        auto pr = hs.map.find(h);
+        if (hs.map.end() != pr)
         {
             UUID oid = pr->second;
-            _handle_map.erase(pr);
-            _uuid_map.erase(oid);
+            hs.map.erase(pr);
+            {
+                UuidShard& us = ushard(oid);
+                std::unique_lock<std::shared_mutex> ulck(us.mtx);
+                us.map.erase(oid);
+            }
 
             OC_ASSERT(uuid == INVALID_UUID or oid == uuid,
                      "Earlier version of atom has mis-matched UUID!");
@@ -106,24 +135,32 @@ UUID TLB::addAtom(const Handle& h, UUID uuid)
         }
     }
 
-    auto pr = _handle_map.find(hr);
+    bool stale = false;
+    auto pr = hs.map.find(hr);
     if (uuid == INVALID_UUID)
     {
-        if (_handle_map.end() != pr) return pr->second;
+        if (hs.map.end() != pr) return pr->second;
 
         while (true)
         {
             // Not found; we need a new uuid.
             uuid = _uuid_pool->get_uuid();
 
-            // Oh wait, is it being used already?
-            auto pr = _uuid_map.find(uuid);
-            if (_uuid_map.end() == pr) break;
+            // Oh wait, is it being used already? Check and claim it
+            // under the same lock, so that no other thread can take
+            // it in between.
+            UuidShard& us = ushard(uuid);
+            std::unique_lock<std::shared_mutex> ulck(us.mtx);
+            if (us.map.end() != us.map.find(uuid)) continue;
+
+            us.map.emplace(std::make_pair(uuid, hr));
+            hs.map.emplace(std::make_pair(hr, uuid));
+            return uuid;
         }
     }
     else
     {
-        if (_handle_map.end() != pr)
+        if (hs.map.end() != pr)
         {
             OC_ASSERT(uuid == pr->second,
                      "Atom is already in the TLB, and UUID's don't match!");
@@ -139,13 +176,16 @@ UUID TLB::addAtom(const Handle& h, UUID uuid)
             if (pas and has and pas == has)
                 return uuid;
 
-            _handle_map.erase(pr);
-            _uuid_map.erase(uuid);
+            hs.map.erase(pr);
+            stale = true;
         }
     }
 
-    _uuid_map.emplace(std::make_pair(uuid, hr));
-    _handle_map.emplace(std::make_pair(hr, uuid));
+    UuidShard& us = ushard(uuid);
+    std::unique_lock<std::shared_mutex> ulck(us.mtx);
+    if (stale) us.map.erase(uuid);
+    us.map.emplace(std::make_pair(uuid, hr));
+    hs.map.emplace(std::make_pair(hr, uuid));
 
     return uuid;
 }
@@ -153,19 +193,21 @@ UUID TLB::addAtom(const Handle& h, UUID uuid)
 Handle TLB::getAtom(UUID uuid)
 {
     if (INVALID_UUID == uuid) return Handle::UNDEFINED;
-    std::lock_guard<std::mutex> lck(_mtx);
-    auto pr = _uuid_map.find(uuid);
+    UuidShard& us = ushard(uuid);
+    SHARED_LOCK(us);
+    auto pr = us.map.find(uuid);
 
-    if (_uuid_map.end() == pr) return Handle::UNDEFINED;
+    if (us.map.end() == pr) return Handle::UNDEFINED;
 
     return pr->second;
 }
 
 UUID TLB::getUUID(const Handle& h)
 {
-    std::lock_guard<std::mutex> lck(_mtx);
-    auto pr = _handle_map.find(h);
-    if (_handle_map.end() != pr)
+    HandleShard& hs = hshard(h);
+    SHARED_LOCK(hs);
+    auto pr = hs.map.find(h);
+    if (hs.map.end() != pr)
         return pr->second;
 
     return INVALID_UUID;
@@ -186,25 +228,25 @@ UUID TLB::getUUID(const Handle& h)
 void TLB::removeAtom(UUID uuid)
 {
     if (INVALID_UUID == uuid) return;
-    std::lock_guard<std::mutex> lck(_mtx);
+    UuidShard& us = ushard(uuid);
+    UNIQUE_LOCK(us);
 
-    auto pr = _uuid_map.find(uuid);
-    if (_uuid_map.end() == pr) return;
-
-    _uuid_map.erase(uuid);
+    us.map.erase(uuid);
     // Do NOT remove from the handle_map. See note above.
-    // _handle_map.erase(pr->second);
 }
 
 void TLB::removeAtom(const Handle& h)
 {
-    std::lock_guard<std::mutex> lck(_mtx);
-    auto pr = _handle_map.find(h);
-    if (_handle_map.end() != pr)
+    HandleShard& hs = hshard(h);
+    UNIQUE_LOCK(hs);
+    auto pr = hs.map.find(h);
+    if (hs.map.end() != pr)
     {
-        _uuid_map.erase(pr->second);
+        UuidShard& us = ushard(pr->second);
+        std::unique_lock<std::shared_mutex> ulck(us.mtx);
+        us.map.erase(pr->second);
         // Do NOT remove from the handle_map. See note above.
-        // _handle_map.erase(pr);
+        // hs.map.erase(pr);
     }
 }
 
@@ -216,11 +258,28 @@ void TLB::removeAtom(const Handle& h)
 void TLB::purgeAtom(UUID uuid)
 {
     if (INVALID_UUID == uuid) return;
-    std::lock_guard<std::mutex> lck(_mtx);
 
-    auto pr = _uuid_map.find(uuid);
-    if (_uuid_map.end() == pr) return;
+    // The handle shard must be locked before the uuid shard, so find
+    // the atom first, and then verify it again after locking both.
+    while (true)
+    {
+        Handle h(getAtom(uuid));
+        if (nullptr == h) return;
+
+        HandleShard& hs = hshard(h);
+        UNIQUE_LOCK(hs);
+        UuidShard& us = ushard(uuid);
+        std::unique_lock<std::shared_mutex> ulck(us.mtx);
+
+        auto pr = us.map.find(uuid);
+        if (us.map.end() == pr) return;
 
-    _uuid_map.erase(uuid);
-    _handle_map.erase(pr->second);
+        // Some other thread raced us, and moved the uuid to an
+        // atom in some other shard. Try again.
+        if (&hshard(pr->second) != &hs) continue;
+
+        hs.map.erase(pr->second);
+        us.map.erase(pr);
+        return;
+    }
 }
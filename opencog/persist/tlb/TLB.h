@@ -27,6 +27,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include <opencog/atoms/base/Atom.h>
@@ -70,18 +71,47 @@ class AtomSpace;
  *
  * Atomspaces are also issued UUID's. This allows atomspaces to be
  * uniquely identified as well.
+ *
+ * The two lookup tables are split into shards, each with its own
+ * reader-writer lock. The uuid-to-handle shards are selected by the
+ * low bits of the UUID; the handle-to-uuid shards by the atom hash.
+ * Lookups take only a shared lock on a single shard, so that the
+ * parallel loader threads do not serialize on the TLB. Updates lock
+ * at most one handle shard and one uuid shard, always in that order.
  */
+#define TLB_NUM_SHARDS 64
+
 class TLB
 {
 private:
     local_uuid_pool _local_pool;
     uuid_pool* _uuid_pool;
 
-    std::mutex _mtx;
-    std::unordered_map<UUID, Handle> _uuid_map;
-    std::unordered_map<Handle, UUID,
+    typedef std::unordered_map<UUID, Handle> UuidMap;
+    typedef std::unordered_map<Handle, UUID,
                       std::hash<opencog::Handle>,
-                      std::equal_to<opencog::Handle> > _handle_map;
+                      std::equal_to<opencog::Handle> > HandleMap;
+
+    // Align each shard to its own cache line, so that threads
+    // working on neighboring shards do not bounce the locks.
+    struct alignas(64) UuidShard
+    {
+        mutable std::shared_mutex mtx;
+        UuidMap map;
+    };
+    struct alignas(64) HandleShard
+    {
+        mutable std::shared_mutex mtx;
+        HandleMap map;
+    };
+
+    UuidShard _uuid_shards[TLB_NUM_SHARDS];
+    HandleShard _handle_shards[TLB_NUM_SHARDS];
+
+    UuidShard& ushard(UUID uuid)
+        { return _uuid_shards[uuid % TLB_NUM_SHARDS]; }
+    HandleShard& hshard(const Handle& h)
+        { return _handle_shards[hash_value(h) % TLB_NUM_SHARDS]; }
 
     // Its a vector, not a set, because it's priority ranked.
     std::vector<const AtomSpace*> _resolver;
@@ -95,7 +125,7 @@ public:
     void set_resolver(const AtomSpace*);
     void clear_resolver(const AtomSpace*);
 
-    size_t size() { return _uuid_map.size(); }
+    size_t size();
     void clear();
 
     /**
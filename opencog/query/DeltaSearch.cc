@@ -0,0 +1,53 @@
+/*
+ * opencog/query/DeltaSearch.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "DeltaSearch.h"
+
+using namespace opencog;
+
+bool opencog::delta_searchable(const PatternLinkPtr& plp, TypeSet& types)
+{
+	types.clear();
+	if (nullptr == plp) return false;
+
+	const Pattern& pat = plp->get_pattern();
+	if (1 != plp->get_components().size()) return false;
+	if (0 < plp->get_virtual().size()) return false;
+	if (pat.have_evaluatables) return false;
+	if (0 < pat.absents.size() or 0 < pat.always.size()) return false;
+	if (0 < pat.defined_terms.size()) return false;
+	if (0 == pat.pmandatory.size()) return false;
+
+	TypeSet ctypes;
+	for (const PatternTermPtr& cl : pat.pmandatory)
+	{
+		if (not cl->isLink()) return false;
+		if (cl->hasAnyEvaluatable() or cl->isChoice()) return false;
+		if (cl->getQuote() != cl->getHandle()) return false;
+		ctypes.insert(cl->getHandle()->get_type());
+	}
+
+	types.swap(ctypes);
+	return true;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,86 @@
+/*
+ * opencog/query/DeltaSearch.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_DELTA_SEARCH_H
+#define _OPENCOG_DELTA_SEARCH_H
+
+#include <opencog/atoms/atom_types/types.h>
+#include <opencog/atoms/pattern/PatternLink.h>
+#include <opencog/query/InitiateSearchMixin.h>
+
+namespace opencog {
+
+/**
+ * Return true if the groundings of the query can be kept up to date
+ * by searching only from the Atoms added to the AtomSpace. This holds
+ * for single-component queries without evaluatable, absent, always or
+ * choice clauses: for those, the results can only grow when Atoms are
+ * added, and a new result must ground some clause with a new Atom.
+ * If so, `types` is set to the types of the clauses; Atoms of other
+ * types cannot ground a clause.
+ */
+bool delta_searchable(const PatternLinkPtr&, TypeSet& types);
+
+/**
+ * Search only for the groundings that ground some clause with one of
+ * the given Atoms. Used to extend earlier results, after these Atoms
+ * were added to the AtomSpace. The query must be delta_searchable().
+ *
+ * SEARCH is the callback class used for the full search; its
+ * constructor arguments follow the list of added Atoms.
+ */
+template<class SEARCH>
+class DeltaSearch : public SEARCH
+{
+		const HandleSeq& _added;
+	public:
+		template<typename ... ARGS>
+		DeltaSearch(const HandleSeq& added, ARGS&&... args) :
+			SEARCH(std::forward<ARGS>(args)...), _added(added) {}
+		virtual ~DeltaSearch() {}
+		virtual bool perform_search(PatternMatchCallback&);
+};
+
+template<class SEARCH>
+bool DeltaSearch<SEARCH>::perform_search(PatternMatchCallback& pmc)
+{
+	// Start the search at each clause in turn, using the added Atoms
+	// of the clause type as the grounding of the entire clause.
+	for (const PatternTermPtr& cl : this->_pattern->pmandatory)
+	{
+		Type ct = cl->getHandle()->get_type();
+		this->_search_set.clear();
+		for (const Handle& h : _added)
+			if (ct == h->get_type()) this->_search_set.push_back(h);
+		if (0 == this->_search_set.size()) continue;
+
+		this->_root = cl;
+		this->_starter_term = cl;
+		if (this->search_loop(pmc, "dddddddddd delta_search ddddddddddd"))
+			return true;
+	}
+	return false;
+}
+
+} // namespace opencog
+
+#endif // _OPENCOG_DELTA_SEARCH_H
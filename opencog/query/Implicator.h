@@ -24,6 +24,8 @@
 #ifndef _OPENCOG_IMPLICATOR_H
 #define _OPENCOG_IMPLICATOR_H
 
+#include <typeinfo>
+
 #include "InitiateSearchMixin.h"
 #include "RewriteMixin.h"
 #include "SatisfyMixin.h"
@@ -37,18 +39,50 @@ class Implicator:
 	public TermMatchMixin,
 	public SatisfyMixin
 {
+	protected:
+		// The original, for copies made by clone(); else null.
+		Implicator* _origin = nullptr;
+
 	public:
 		Implicator(AtomSpace* asp) :
 			InitiateSearchMixin(asp),
 			RewriteMixin(asp),
 			TermMatchMixin(asp) {}
 
+		// Optional clauses seen by a copy were seen by the search.
+		virtual ~Implicator()
+		{
+			if (_origin and _optionals_present)
+				_origin->_optionals_present = true;
+		}
+
 			virtual void set_pattern(const Variables& vars,
 			                         const Pattern& pat)
 			{
 				InitiateSearchMixin::set_pattern(vars, pat);
 				TermMatchMixin::set_pattern(vars, pat);
 			}
+
+			// Subclasses might overload the term callbacks.
+			virtual bool default_term_match(void)
+			{ return typeid(*this) == typeid(Implicator); }
+
+			/// Make a copy that puts its results in the same queue,
+			/// as for the SatisfyingSet. This is done only for this
+			/// class, and not for the classes that inherit from it.
+			virtual PatternMatchCallback* clone(void)
+			{
+				if (typeid(*this) != typeid(Implicator)) return nullptr;
+
+				Implicator* im = new Implicator(RewriteMixin::_as);
+				im->_origin = _origin ? _origin : this;
+				im->_primary = _primary;
+				im->_profile = _profile;
+				im->_result_queue = _result_queue;
+				im->implicand = implicand;
+				im->max_results = max_results;
+				return im;
+			}
 };
 
 }; // namespace opencog
@@ -21,6 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <opencog/atomspace/AtomSpace.h>
 
 #include <opencog/atoms/core/DefineLink.h>
@@ -31,12 +33,7 @@
 
 #include "InitiateSearchMixin.h"
 #include "PatternMatchEngine.h"
-
-#ifdef USE_THREADED_PATTERN_ENGINE
-	// #include <algorithm>
-	// #include <execution>
-	#include <opencog/util/oc_omp.h>
-#endif // USE_THREADED_PATTERN_ENGINE
+#include "SearchPool.h"
 
 using namespace opencog;
 
@@ -54,7 +51,7 @@ InitiateSearchMixin::InitiateSearchMixin(AtomSpace* as) :
 {
 	_variables = nullptr;
 	_pattern = nullptr;
-	_recursing = false;
+	_planned = nullptr;
 
 	_root = PatternTerm::UNDEFINED;
 	_starter_term = PatternTerm::UNDEFINED;
@@ -71,6 +68,35 @@ void InitiateSearchMixin::set_pattern(const Variables& vars,
 	_pattern = &pat;
 }
 
+/// The plan is made only if there is more than one mandatory clause,
+/// as otherwise there is nothing to order. It is kept until the
+/// pattern changes. The pattern is swapped back and forth for each
+/// grounding of a Cartesian product, and so it is not dropped by
+/// `set_pattern()`; only by a new search.
+const QueryPlanner* InitiateSearchMixin::plan(void)
+{
+	if (_pattern->pmandatory.size() < 2) return nullptr;
+	if (nullptr == _planner or _planned != _pattern)
+	{
+		_planner = std::make_shared<QueryPlanner>(_as, *_variables, *_pattern);
+		_planned = _pattern;
+	}
+	return _planner.get();
+}
+
+size_t InitiateSearchMixin::plan_rank(const PatternTermPtr& clause)
+{
+	const QueryPlanner* qp = plan();
+	if (nullptr == qp) return SIZE_MAX;
+	return qp->rank(clause);
+}
+
+double InitiateSearchMixin::expected_groundings(const Variables& vars,
+                                                const Pattern& pat) const
+{
+	return QueryPlanner(_as, vars, pat).groundings();
+}
+
 
 /* ======================================================== */
 
@@ -158,7 +184,15 @@ InitiateSearchMixin::find_starter_recursive(const PatternTermPtr& ptm,
 	{
 		if (VARIABLE_NODE != t and GLOB_NODE != t)
 		{
-			width = h->getIncomingSetSize();
+			// Count only those Links that the search will actually
+			// look at: the ones of the same type as the holding term.
+			// Nodes used in many different ways are otherwise made to
+			// look much thicker than they are.
+			Handle hp(ptm->getParent()->getHandle());
+			if (hp and CHOICE_LINK != hp->get_type())
+				width = h->getIncomingSetSizeByType(hp->get_type(), _as);
+			else
+				width = h->getIncomingSetSize(_as);
 			return h;
 		}
 		return Handle::UNDEFINED;
@@ -344,8 +378,20 @@ bool InitiateSearchMixin::setup_neighbor_search(const PatternTermSeq& clauses)
 	// Note also: the user is allowed to specify patterns that have
 	// no constants in them at all.  In this case, the search is
 	// performed by looping over all links of the given types.
+	//
+	// If there is a plan, start in the clause that it starts in; the
+	// rest of the plan assumes that this clause is grounded first.
 	PatternTermPtr bestclause;
-	Handle best_start = find_thinnest(clauses, _starter_term, bestclause);
+	Handle best_start;
+	const QueryPlanner* qp = plan();
+	if (qp and qp->get_start() and
+	    clauses.end() != std::find(clauses.begin(), clauses.end(),
+	                               qp->get_steps()[0].clause))
+		best_start = find_thinnest({qp->get_steps()[0].clause},
+		                           _starter_term, bestclause);
+
+	if (nullptr == best_start and 0 == _start_choices.size())
+		best_start = find_thinnest(clauses, _starter_term, bestclause);
 
 	// Cannot find a starting point! This can happen if:
 	// 1) all of the clauses contain nothing but variables,
@@ -506,6 +552,7 @@ bool InitiateSearchMixin::perform_search(PatternMatchCallback& pmc)
 	_curr_clause = PatternTerm::UNDEFINED;
 	_search_set.clear();
 	_start_choices.clear();
+	_planner = nullptr;
 
 	// Fallback to the legacy mode.
 	if (1 != _pattern->pmandatory.size())
@@ -1109,6 +1156,57 @@ bool InitiateSearchMixin::setup_no_search(void)
 
 /* ======================================================== */
 
+size_t InitiateSearchMixin::parallel_threshold = 200000;
+
+/// Count the Atoms in a tree.
+static size_t tree_size(const Handle& h)
+{
+	if (h->is_node()) return 1;
+	size_t sz = 1;
+	for (const Handle& ho : h->getOutgoingSet())
+		sz += tree_size(ho);
+	return sz;
+}
+
+/// Decide if a search is worth running in parallel, and if so, on
+/// how many threads. Return 1 to run it in the calling thread.
+///
+/// Going parallel has a fixed cost: the callback must be copied for
+/// each thread, and each copy gets its own transient AtomSpace. For
+/// small searches, this is far more than the search itself (the old,
+/// always-parallel loop made RandomUTest 25x slower, and GetStateUTest
+/// 33x slower) so only large searches are split up.
+///
+/// Patterns with evaluatable terms are never split up: these may run
+/// arbitrary user code (GroundedPredicates, continuations, ...) which
+/// might not be thread-safe. Searches started from inside of another
+/// parallel search (e.g. when there are several components) are not
+/// split up again; the outer search is already using all the threads.
+size_t InitiateSearchMixin::parallel_parts(void)
+{
+	size_t nss = _search_set.size();
+	if (nss < 2) return 1;
+
+	if (SearchPool::in_search()) return 1;
+
+	size_t nthr = SearchPool::instance().concurrency();
+	if (nthr < 2) return 1;
+
+	if (_pattern->have_evaluatables or
+	    not _pattern->defined_terms.empty() or
+	    not _pattern->always.empty())
+		return 1;
+
+	size_t weight = 0;
+	for (const PatternTermPtr& ptm : _pattern->pmandatory)
+		weight += tree_size(ptm->getHandle());
+
+	if (nss * weight < parallel_threshold) return 1;
+
+	// Give each thread at least a few starting points.
+	return std::min(nthr, (nss + 3) / 4);
+}
+
 /// search_loop() -- perform the actual pattern search
 ///
 /// This performs the actual search for matching graphs.
@@ -1119,126 +1217,96 @@ bool InitiateSearchMixin::search_loop(PatternMatchCallback& pmc,
                                       const std::string dbg_banner)
 {
 	// This is the main entry point into the CPU-cycle sucking part of
-	// the pattern search.  If `USE_THREADED_PATTERN_ENGINE` is defined,
-	// then it runs in parallel. It works, unit-tests pass. But ...
-	// But the overhead is so large, that, for small pattern matches,
-	// the setup of going parallel is far more expensive than the gain
-	// from parallelism. (RandomUTest runs 25x slower! GetStateUTest
-	// runs 33x slower!) So this code is currently disabled.
+	// the pattern search. Large searches are spread over several
+	// threads; see `parallel_parts()` for what counts as large. Be
+	// careful not to penalize small users! Small searches run here,
+	// exactly as they always have. See the benchmark `nano-en.scm` in
+	// the opencog/benchmark GitHub repo, for example.
 	//
-	// If `_search_set` is large, or the if pattern is large/complex,
-	// then the extra cost might be worth it. However, this is NOT
-	// always the bottleneck! Be careful not to penalize small users!
-	// See the benchmark `nano-en.scm` in the opencog/benchmark GitHub
-	// repo, for example.
-	//
-#ifndef USE_THREADED_PATTERN_ENGINE
-	// See explanation below for the `_recursing` flag.
-	_recursing = true;
-#endif
-
-	if (_recursing)
+	// Only callbacks that can be copied can be run in parallel.
+	size_t nparts = parallel_parts();
+	if (1 < nparts)
 	{
-		// Plain-old, olde-fashioned sequential search loop.
-		// This works.
-#ifdef QDEBUG
-		size_t i = 0, hsz = _search_set.size();
-#endif
-
-		PatternMatchEngine pme(pmc);
-		pme.set_pattern(*_variables, *_pattern);
-
-		while (0 < _issued_stack.size()) _issued_stack.pop();
-		_issued.clear();
-		_issued.insert(_root);
-		for (const Handle& h : _search_set)
+		std::unique_ptr<PatternMatchCallback> cb(pmc.clone());
+		if (cb)
 		{
 			DO_LOG({LAZY_LOG_FINE << dbg_banner
-			             << "\n       Loop candidate ("
-			             << ++i << "/" << hsz << "):\n"
-			             << h->to_string("       ");})
-			bool found = pme.explore_neighborhood(_starter_term,
-			                                      h, _root);
-			if (found) return true;
+			             << "\n       Parallel search over "
+			             << _search_set.size() << " candidates";})
+			return parallel_search_loop(pmc, std::move(cb), nparts);
 		}
-
-		return false;
 	}
 
-	// Note also: for multi-component patterns, this entire class
-	// is used recursively in multiple threads. This is because
-	// `PatternLink::satisfy()` is recursive, when there are multiple
-	// components. So: we start here, create multiple threads,
-	// and then pass ourselves into each thread. When there are
-	// components, this gets wrapped in PMCGroundings and then
-	// `PatternLink::satisfy()` is called .. once in each thread!
-	// Which causes a new start-point to be searched for, for each
-	// component which clobbers this structure against itself.  Fail.
-	// The `_recursing` flag prevents this double-threading.
-// #define PM_PARALLEL 1
-#ifdef PM_PARALLEL
-	// Parallel loop. This requires linking to -ltbb to work.
-	_recursing = true;
-
-	_issued_stack.clear();
-	_issued.clear();
-	_issued.insert(_root);
-
-	std::atomic<size_t> nfnd = 0;
-	std::for_each(
-		std::execution::par_unseq,
-		_search_set.begin(),
-		_search_set.end(),
-		[&](auto&& h)
-		{
-			PatternMatchEngine pme(pmc);
-			pme.set_pattern(*_variables, *_pattern);
-
-			if (pme.explore_neighborhood(_starter_term, h, _root)) nfnd++;
-		});
-
-	_recursing = false;
-	return 0 < nfnd;
-
+#ifdef QDEBUG
+	size_t i = 0, hsz = _search_set.size();
 #endif
 
-#ifdef USE_THREADED_PATTERN_ENGINE
-	#define OMP_PM_PARALLEL 1
-#endif
-#ifdef OMP_PM_PARALLEL
-	// Parallel loop. This requires OpenMP to work.
-	_recursing = true;
-	_issued_stack.clear();
+	PatternMatchEngine pme(pmc);
+	pme.set_pattern(*_variables, *_pattern);
+
+	while (0 < _issued_stack.size()) _issued_stack.pop();
 	_issued.clear();
 	_issued.insert(_root);
-
-#ifdef QDEBUG
-	size_t i = 0;
-#endif
-
-	std::atomic<size_t> nfnd = 0;
-	size_t hsz = _search_set.size();
-	#pragma omp parallel for
-	for (size_t j=0; j<hsz; j++)
+	for (const Handle& h : _search_set)
 	{
-		PatternMatchEngine pme(pmc);
-		pme.set_pattern(*_variables, *_pattern);
-
-		Handle h(_search_set[j]);
 		DO_LOG({LAZY_LOG_FINE << dbg_banner
 		             << "\n       Loop candidate ("
 		             << ++i << "/" << hsz << "):\n"
-		             << h->to_short_string("       ");})
-
-		if (pme.explore_neighborhood(_starter_term, h, _root)) nfnd++;
+		             << h->to_string("       ");})
+		bool found = pme.explore_neighborhood(_starter_term,
+		                                      h, _root);
+		if (found) return true;
 	}
-	_recursing = false;
-	return 0 < nfnd;
-#endif
 
 	return false;
 }
 
+/// Run the search loop on several threads, with the starting points
+/// shared out between them. The calling thread uses the callback it
+/// was given; each of the other threads uses a copy, made with
+/// `clone()`, as the callbacks hold the state of the search (the
+/// clause stacks, the bound variables) and so cannot be shared. Each
+/// thread also gets its own PatternMatchEngine, for the same reason.
+bool InitiateSearchMixin::parallel_search_loop(PatternMatchCallback& pmc,
+                           std::unique_ptr<PatternMatchCallback>&& copy,
+                           size_t nparts)
+{
+	while (0 < _issued_stack.size()) _issued_stack.pop();
+	_issued.clear();
+	_issued.insert(_root);
+
+	// The callbacks and engines are made by the threads that use
+	// them, the first time that they get some work.
+	std::vector<std::unique_ptr<PatternMatchCallback>> cbs(nparts);
+	std::vector<std::unique_ptr<PatternMatchEngine>> pmes(nparts);
+	cbs[1] = std::move(copy);
+
+	auto explore = [&](size_t part, size_t idx) -> bool
+	{
+		if (nullptr == pmes[part])
+		{
+			PatternMatchCallback* cb = &pmc;
+			if (0 < part)
+			{
+				if (nullptr == cbs[part]) cbs[part].reset(pmc.clone());
+				cb = cbs[part].get();
+				cb->set_pattern(*_variables, *_pattern);
+
+				InitiateSearchMixin* ism =
+					dynamic_cast<InitiateSearchMixin*>(cb);
+				if (ism) ism->_issued.insert(_root);
+			}
+			pmes[part].reset(new PatternMatchEngine(*cb));
+			pmes[part]->set_pattern(*_variables, *_pattern);
+		}
+		return pmes[part]->explore_neighborhood(_starter_term,
+		                                        _search_set[idx], _root);
+	};
+
+	// The engines are destroyed before the callbacks that they use.
+	return SearchPool::instance().run(_search_set.size(), nparts, explore);
+}
+
 /* ======================================================== */
 
 std::string InitiateSearchMixin::to_string(const std::string& indent) const
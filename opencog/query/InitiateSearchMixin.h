@@ -25,11 +25,14 @@
 #ifndef _OPENCOG_INITIATE_SEARCH_H
 #define _OPENCOG_INITIATE_SEARCH_H
 
+#include <memory>
+
 #include <opencog/util/empty_string.h>
 #include <opencog/atoms/atom_types/types.h>
 #include <opencog/atoms/core/Quotation.h>
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/query/PatternMatchCallback.h>
+#include <opencog/query/QueryPlanner.h>
 
 namespace opencog {
 
@@ -62,13 +65,26 @@ public:
 
 	std::string to_string(const std::string& indent=empty_string) const;
 
+	/**
+	 * The number of groundings that a search for the given pattern
+	 * is expected to find, as estimated by the QueryPlanner. Zero if
+	 * there are no clauses that the search could start in.
+	 */
+	double expected_groundings(const Variables&, const Pattern&) const;
+
+	/**
+	 * Searches whose estimated cost is below this are run in the
+	 * calling thread. The cost is the number of starting points,
+	 * times the total size of the mandatory clauses.
+	 */
+	static size_t parallel_threshold;
+
 protected:
 
 	NameServer& _nameserver;
 
 	const Variables* _variables;
 	const Pattern* _pattern;
-	bool _recursing;
 
 	PatternTermPtr _root;
 	PatternTermPtr _starter_term;
@@ -105,6 +121,10 @@ protected:
 	bool legacy_search(PatternMatchCallback&);
 	bool choice_loop(PatternMatchCallback&, const std::string);
 	bool search_loop(PatternMatchCallback&, const std::string);
+	size_t parallel_parts(void);
+	bool parallel_search_loop(PatternMatchCallback&,
+	                          std::unique_ptr<PatternMatchCallback>&&,
+	                          size_t);
 
 	static PatternTermPtr term_of_handle(const Handle&, const PatternTermPtr&);
 	static PatternTermSeq term_choices_of_handle(const Handle&, const PatternTermPtr&);
@@ -125,6 +145,13 @@ protected:
 	bool get_next_thinnest_clause(const GroundingMap&, bool, bool);
 	unsigned int thickness(const PatternTermPtr&, const HandleSet&);
 
+	// Cost-based plan. The search starts in the first clause of the
+	// plan, and grounds the mandatory clauses in the planned order.
+	QueryPlannerPtr _planner;
+	const Pattern* _planned;
+	const QueryPlanner* plan(void);
+	size_t plan_rank(const PatternTermPtr&);
+
 	AtomSpace *_as;
 };
 
@@ -177,6 +177,11 @@ void InitiateSearchMixin::next_connections(const GroundingMap& var_grounding)
 // Danger: this assumes a suitable dataset, as otherwise, the cost
 // of this "optimization" can add un-necessarily to the overhead.
 //
+// If there is a cost-based plan (see QueryPlanner), then it is used
+// instead, for the clauses in it; it uses the incoming-set statistics
+// described above. The thickness orders the clauses that are not in
+// the plan.
+//
 unsigned int InitiateSearchMixin::thickness(const PatternTermPtr& clause,
                                             const HandleSet& live)
 {
@@ -306,16 +311,22 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 	// We are looking for a joining atom, one that is shared in common
 	// with the a fully grounded clause, and an as-yet ungrounded clause.
 	// The joint is called "pursue", and the unsolved clause that it
-	// joins will become our next untried clause. We choose joining atom
-	// with smallest size of its incoming set. If there are many such
-	// atoms we choose one from clauses with minimal number of ungrounded
-	// yet variables.
+	// joins will become our next untried clause. If the plan has any
+	// of the unsolved clauses in it, we take the one that comes first
+	// in the plan, joined by its thinnest joint. Otherwise, we choose
+	// the joining atom with smallest size of its incoming set. If there
+	// are many such atoms we choose one from clauses with minimal number
+	// of ungrounded yet variables.
+	bool planned = nullptr != plan();
+	size_t best_rank = SIZE_MAX;
 	for (const auto& tckvar : thick_vars)
 	{
 		std::size_t pursue_thickness = tckvar.first;
 		const Handle& pursue = tckvar.second;
 
-		if (pursue_thickness > thinnest_joint) break;
+		// A clause that is earlier in the plan might be joined by
+		// a thicker joint; keep looking.
+		if (not planned and pursue_thickness > thinnest_joint) break;
 
 		const auto& root_list = _pattern->connectivity_map.equal_range(pursue);
 		for (auto it = root_list.first; it != root_list.second; it++)
@@ -326,8 +337,13 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 			     and (search_absents or not root->isAbsent()))
 			{
 				unsigned int root_thickness = thickness(root, ungrounded_vars);
-				if (root_thickness < thinnest_clause)
+				size_t rank = planned ? plan_rank(root) : SIZE_MAX;
+				if (rank < best_rank
+				    or (rank == best_rank
+				        and pursue_thickness <= thinnest_joint
+				        and root_thickness < thinnest_clause))
 				{
+					best_rank = rank;
 					thinnest_clause = root_thickness;
 					thinnest_joint = pursue_thickness;
 					unsolved_clause = root;
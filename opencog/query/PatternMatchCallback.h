@@ -30,6 +30,7 @@
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/atoms/pattern/PatternTerm.h> // for pattern context
+#include <opencog/query/QueryProfile.h>
 
 namespace opencog {
 
@@ -384,14 +385,47 @@ class PatternMatchCallback
 		virtual void set_pattern(const Variables& vars,
 		                         const Pattern& pat) = 0;
 
+		/**
+		 * Return a new callback that can be used, in some other
+		 * thread, at the same time as this one, to run part of the
+		 * current search. The copy must report its groundings to the
+		 * same place as this one does, in a thread-safe way; it must
+		 * not share any of the per-search state (the stacks, the
+		 * bound variables, ...). The caller owns the copy, and will
+		 * call `set_pattern()` on it before using it.
+		 *
+		 * Return nullptr if this is not possible; the search will
+		 * then be run in a single thread. This is the default.
+		 */
+		virtual PatternMatchCallback* clone(void) { return nullptr; }
+
+		/**
+		 * Return the profile to which the engine adds the counts of
+		 * the work it did, or nullptr, if no one is interested. Copies
+		 * made with `clone()` must return the same profile.
+		 */
+		virtual QueryProfile* get_profile(void) { return nullptr; }
+
+		/**
+		 * Return true if node_match(), variable_match(), scope_match(),
+		 * link_match(), post_link_match(), post_link_mismatch() and
+		 * fuzzy_match() are exactly those of the TermMatchMixin. The
+		 * engine can then match the simplest terms directly, without
+		 * making any of these calls. Classes overloading any of them
+		 * must return false; this is the default.
+		 */
+		virtual bool default_term_match(void) { return false; }
+
 		/**
 		 * You get to call this, to perform the actual search.
 		 */
 		virtual bool satisfy(const PatternLinkPtr&) = 0;
 };
 
-// See notes in `InitiateSearchMixin.cc` for an explanation of the
-// threading code and its status.
+// Callbacks that are shared between threads must be thread-safe.
+// Large searches are run in parallel only for callbacks that provide
+// `clone()`; see `InitiateSearchMixin::search_loop()`. This older,
+// coarser switch is kept for callbacks that guard their own state.
 // #define USE_THREADED_PATTERN_ENGINE
 #ifdef USE_THREADED_PATTERN_ENGINE
 	#define DECLARE_PE_MUTEX std::mutex _mtx;
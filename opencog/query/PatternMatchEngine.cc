@@ -21,6 +21,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
 #include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
 
@@ -161,7 +165,7 @@ bool PatternMatchEngine::variable_compare(const Handle& hp,
 		logmsg("Found grounding of variable:");
 		logmsg("$$ variable:", hp);
 		logmsg("$$ ground term:", hg);
-		var_grounding[hp] = hg;
+		var_slot(hp) = hg;
 	}
 	return true;
 }
@@ -173,7 +177,7 @@ bool PatternMatchEngine::variable_compare(const Handle& hp,
 bool PatternMatchEngine::self_compare(const PatternTermPtr& ptm)
 {
 	const Handle& hp = ptm->getHandle();
-	if (not ptm->isQuoted()) var_grounding[hp] = hp;
+	if (not ptm->isQuoted()) var_slot(hp) = hp;
 
 	logmsg("Compare atom to itself:", ptm->getQuote());
 	return true;
@@ -193,7 +197,7 @@ bool PatternMatchEngine::node_compare(const Handle& hp,
 		logmsg("Found matching nodes");
 		logmsg("# pattern:", hp);
 		logmsg("# match:", hg);
-		if (hp != hg) var_grounding[hp] = hg;
+		if (hp != hg) var_slot(hp) = hg;
 	}
 	return match;
 }
@@ -270,6 +274,82 @@ bool PatternMatchEngine::ordered_compare(const PatternTermPtr& ptm,
 
 /* ======================================================== */
 
+/// Compare a term that holds only ordered links, constant nodes and
+/// bound variables to the proposed grounding. This does exactly what
+/// `tree_compare` would do, with the default callbacks, but walks the
+/// flattened term in a loop, using an explicit stack for the links,
+/// and with no virtual calls. Groundings are recorded in the same
+/// order, as well, so that it makes no difference which one is used.
+bool PatternMatchEngine::flat_compare(const FlatTerm& prog,
+                                      const Handle& hg)
+{
+	_flat_stack.clear();
+
+	size_t i = 0;
+	const Handle* pg = &hg;
+	while (true)
+	{
+		_counts.tree_compares++;
+		const FlatTermOp& op = prog[i];
+		const Handle& hp = op.handle;
+		const Handle& g = *pg;
+
+		bool descend = false;
+		auto gnd = var_grounding.find(hp);
+		if (gnd != var_grounding.end())
+		{
+			if (gnd->second != g) return false;
+		}
+		else if (FlatTermOp::VAR == op.kind)
+		{
+			if (VARIABLE_NODE == op.type and not _variables->is_type(hp, g))
+				return false;
+			var_slot(hp) = g;
+		}
+		else if (hp == g)
+			var_slot(hp) = hp;
+		else if (FlatTermOp::NODE == op.kind)
+			return false;
+		else
+		{
+			if (not g->is_link() or g->get_type() != op.type or
+			    g->get_arity() != op.arity)
+				return false;
+			descend = true;
+		}
+
+		if (descend and 0 < op.arity)
+		{
+			_flat_stack.push_back({i, pg, 0, i+1});
+		}
+		else
+		{
+			// An empty link has nothing below it to compare.
+			if (descend) var_slot(hp) = g;
+
+			// Pop the links that are done.
+			while (not _flat_stack.empty())
+			{
+				FlatFrame& fr = _flat_stack.back();
+				fr.pos ++;
+				fr.next = prog[fr.next].end;
+				if (fr.pos < prog[fr.op].arity) break;
+
+				var_slot(prog[fr.op].handle) = *fr.gnd;
+				_flat_stack.pop_back();
+			}
+			if (_flat_stack.empty()) return true;
+		}
+
+		// Next subterm of the innermost open link.
+		FlatFrame& fr = _flat_stack.back();
+		i = fr.next;
+		pg = &(*fr.gnd)->getOutgoingSet()[fr.pos];
+	}
+}
+
+/* ======================================================== */
+
 /// Compare the contents of a Present term in the pattern to the
 /// proposed grounding. The term `ptm` points at the Present term.
 ///
@@ -399,6 +479,38 @@ bool PatternMatchEngine::have_choice(const PatternTermPtr& ptm,
 }
 
 /* ======================================================== */
+
+/// Return true if every member can be paired with a distinct member
+/// of the grounding, where `compat[i*n+j]` says if member `i` could
+/// be grounded by `j`. This is bipartite matching, by augmenting
+/// paths; the unordered links are small, so nothing fancier is needed.
+static bool have_pairing(const std::vector<char>& compat, size_t n)
+{
+	std::vector<size_t> paired(n, n);
+	std::vector<char> seen;
+	std::function<bool(size_t)> augment = [&](size_t i) -> bool
+	{
+		for (size_t j=0; j<n; j++)
+		{
+			if (not compat[i*n + j] or seen[j]) continue;
+			seen[j] = true;
+			if (n == paired[j] or augment(paired[j]))
+			{
+				paired[j] = i;
+				return true;
+			}
+		}
+		return false;
+	};
+
+	for (size_t i=0; i<n; i++)
+	{
+		seen.assign(n, false);
+		if (not augment(i)) return false;
+	}
+	return true;
+}
+
 static int facto (int n) { return (n==1)? 1 : n * facto(n-1); };
 
 /// Unordered link comparison
@@ -499,6 +611,37 @@ bool PatternMatchEngine::unorder_compare(const PatternTermPtr& ptm,
 	if (osg.size() != arity and not has_glob)
 		return _pmc.fuzzy_match(hp, hg);
 
+	// Before permuting anything, check that each member of the
+	// pattern could be paired up with a different member of the
+	// grounding. Constants pair only with themselves, typed variables
+	// only with Atoms of the right type, and so on; if no one-to-one
+	// pairing exists, no permutation will match. This holds only for
+	// the default term callbacks; others might accept anything.
+	std::vector<char> compat;
+	bool prune = _default_terms and not has_glob;
+	if (prune)
+	{
+		compat.resize(arity * arity);
+		for (size_t i=0; i<arity; i++)
+			for (size_t j=0; j<arity; j++)
+				compat[i*arity + j] = could_match(osp[i], osg[j]);
+
+		if (not have_perm(ptm, hg) and not have_pairing(compat, arity))
+			return false;
+
+		// Members holding unordered links or choices carry state
+		// from one compare to the next; those can't be skipped.
+		for (const PatternTermPtr& mem : osp)
+			if (mem->hasUnorderedLink() or mem->hasChoice() or
+			    mem->hasAnyEvaluatable() or mem->hasAnyGlobbyVar())
+				prune = false;
+	}
+	auto row = [&](const PatternTermPtr& mem) -> size_t {
+		size_t r = 0;
+		while (osp[r] != mem) r++;
+		return r;
+	};
+
 	// Either we're going to take a step; or we aren't.
 	// If we're not taking a step, then there are unexplored
 	// permutations.
@@ -534,6 +677,8 @@ bool PatternMatchEngine::unorder_compare(const PatternTermPtr& ptm,
 	do
 	{
 		bool match = true;
+		size_t fail_at = arity;
+		_counts.permutations++;
 		solution_push();
 
 		// If we've been told to take a step, then take it now.
@@ -560,9 +705,11 @@ bool PatternMatchEngine::unorder_compare(const PatternTermPtr& ptm,
 		{
 			for (size_t i=0; i<arity; i++)
 			{
-				if (not tree_compare(mutation[i], osg[i], CALL_UNORDER))
+				if ((prune and not compat[row(mutation[i])*arity + i]) or
+				    not tree_compare(mutation[i], osg[i], CALL_UNORDER))
 				{
 					match = false;
+					fail_at = i;
 					break;
 				}
 			}
@@ -702,6 +849,16 @@ take_next_step:
 		if (logger().is_fine_enabled())
 			_perm_count[ptm] ++;
 #endif
+
+		// If member `fail_at` did not match, then neither will any
+		// other permutation that leaves it, and the members before it,
+		// where they are. Skip all of those, by putting the members
+		// after it into their last order; the next step will then
+		// move the member that failed.
+		if (prune and fail_at + 1 < arity)
+			std::sort(mutation.begin() + fail_at + 1, mutation.end(),
+				[](const PatternTermPtr& a, const PatternTermPtr& b)
+				{ return std::less<PatternTermPtr>()(b, a); });
 	} while (std::next_permutation(mutation.begin(), mutation.end(),
 	         std::less<PatternTermPtr>()));
 
@@ -729,6 +886,47 @@ take_next_step:
 	return false;
 }
 
+/// Return false if the term cannot possibly be grounded by `hg`,
+/// given the groundings made so far. This is a quick check, with no
+/// side effects, assuming the default term callbacks. It may return
+/// true for terms that do not match; it never returns false for terms
+/// that do.
+bool PatternMatchEngine::could_match(const PatternTermPtr& ptm,
+                                     const Handle& hg)
+{
+	const Handle& hp = ptm->getHandle();
+	auto gnd = var_grounding.find(hp);
+	if (gnd != var_grounding.end()) return (gnd->second == hg);
+
+	if (ptm->isQuoted() or ptm->hasChoice() or ptm->hasAnyEvaluatable()
+	    or ptm->hasAnyGlobbyVar())
+		return true;
+
+	if (ptm->isBoundVariable())
+		return VARIABLE_NODE != hp->get_type() or _variables->is_type(hp, hg);
+
+	if (hp == hg) return true;
+
+	Type tp = hp->get_type();
+	if (VARIABLE_NODE == tp or DEFINED_SCHEMA_NODE == tp) return true;
+	if (hp->is_node()) return false;
+
+	if (not hg->is_link() or hg->get_type() != tp) return false;
+	if (hp->get_arity() != hg->get_arity()) return false;
+
+	// Don't bother looking inside of these.
+	if (ptm->isUnorderedLink() or _nameserver.isA(tp, SCOPE_LINK) or
+	    ptm->getArity() != hp->get_arity())
+		return true;
+
+	const PatternTermSeq& osp = ptm->getOutgoingSet();
+	const HandleSeq& osg = hg->getOutgoingSet();
+	for (size_t i=0; i<osp.size(); i++)
+		if (not could_match(osp[i], osg[i])) return false;
+
+	return true;
+}
+
 /// Return the saved unordered-link permutation for this
 /// particular point in the tree comparison (i.e. for the
 /// particular unordered link hp in the pattern.)
@@ -833,6 +1031,7 @@ bool PatternMatchEngine::glob_compare(const PatternTermSeq& osp,
 	bool cannot_backtrack_anymore = false;
 	auto backtrack = [&](bool is_glob)
 	{
+		_counts.glob_backtracks++;
 		backtracking = true;
 
 		// If we are looking at a glob right now and fail
@@ -872,7 +1071,7 @@ bool PatternMatchEngine::glob_compare(const PatternTermSeq& osp,
 		_glob_state[osp] = {glob_grd, glob_pos_stack};
 
 		Handle glp(createLink(std::move(glob_seq), LIST_LINK));
-		var_grounding[glob->getHandle()] = glp;
+		var_slot(glob->getHandle()) = glp;
 
 		logmsg("Found grounding of glob:");
 		logmsg("$$ glob:", glob->getQuote());
@@ -1136,13 +1335,20 @@ bool PatternMatchEngine::glob_compare(const PatternTermSeq& osp,
  * is gounded when all variables in it are grounded). This is done
  * progressively, so that earlier groundings will be recorded even if
  * later ones fail. Thus, in order to use this method safely, the caller
- * must make a temp copy of `var_grounding`, and restore the temp if
- * there is no match.
+ * must call `solution_push()` first, and `solution_pop()` if there is
+ * no match, so that the partial groundings are undone.
  */
 bool PatternMatchEngine::tree_compare(const PatternTermPtr& ptm,
                                       const Handle& hg,
                                       Caller caller)
 {
+	if (_flat_ok)
+	{
+		const FlatTerm& prog = ptm->getFlat();
+		if (not prog.empty()) return flat_compare(prog, hg);
+	}
+
+	_counts.tree_compares++;
 	const Handle& hp = ptm->getHandle();
 
 	// Do we already have a grounding for this? If we do, and the
@@ -1889,7 +2095,7 @@ bool PatternMatchEngine::do_term_up(const PatternTermPtr& ptm,
 		// been grounded!  If they're not, something is badly wrong!
 		logmsg("Term inside evaluatable, move up to it's top:",
 			       clause->getQuote());
-		bool found = _pmc.evaluate_sentence(clause->getHandle(), var_grounding);
+		bool found = evaluate_sentence(clause->getHandle(), var_grounding);
 		logmsg("After evaluating clause, found = ", found);
 		if (found)
 			return clause_accept(clause, hg);
@@ -1967,13 +2173,13 @@ bool PatternMatchEngine::clause_accept(const PatternTermPtr& clause,
 
 	if (not clause->hasAnyEvaluatable())
 	{
-		clause_grounding[clause_root] = hg;
+		clause_slot(clause_root) = hg;
 
 		// Handle the highly unusual case of the top-most clause
 		// being a GlobNode. We were unable to record this earlier,
 		// in variable_compare(), so we do it here.
 		if (clause_root->get_type() == GLOB_NODE)
-			var_grounding[clause_root] = hg;
+			var_slot(clause_root) = hg;
 
 		logmsg("---------------------\nclause:", clause_root);
 		logmsg("ground:", hg);
@@ -2052,7 +2258,7 @@ bool PatternMatchEngine::do_next_clause(void)
 			              << (do_clause->hasAnyEvaluatable()?
 			                  "dynamically evaluatable" : "non-dynamic");
 		logmsg("Joining variable is", joiner->getQuote());
-		logmsg("Joining grounding is", var_grounding[joiner->getQuote()]); })
+		logmsg("Joining grounding is", var_slot(joiner->getQuote())); })
 
 		// Start solving the next unsolved clause. Note: this is a
 		// recursive call, and not a loop. Recursion is halted when
@@ -2064,12 +2270,12 @@ bool PatternMatchEngine::do_next_clause(void)
 
 		clause_stacks_push();
 		clause_accepted = false;
-		Handle hgnd(var_grounding[joiner->getHandle()]);
+		Handle hgnd(var_slot(joiner->getHandle()));
 		if (nullptr == hgnd)
 		{
 			// Hack for clauses with no variables...
 			const Handle& j(joiner->getHandle());
-			var_grounding[j] = j;
+			var_slot(j) = j;
 			hgnd = j;
 		}
 		found |= explore_clause(joiner, hgnd, do_clause);
@@ -2103,7 +2309,7 @@ bool PatternMatchEngine::do_next_clause(void)
 			return false;
 		}
 
-		clause_grounding[curr_root] = Handle::UNDEFINED;
+		clause_slot(curr_root) = Handle::UNDEFINED;
 		_pmc.next_connections(var_grounding);
 		have_more = _pmc.get_next_clause(do_clause, joiner);
 		if (not have_more)
@@ -2121,7 +2327,7 @@ bool PatternMatchEngine::do_next_clause(void)
 		// or not. If it does, we'll recurse. If it does not,
 		// we'll loop around back to here again.
 		clause_accepted = false;
-		const Handle& hgnd(var_grounding[joiner->getHandle()]);
+		const Handle& hgnd(var_slot(joiner->getHandle()));
 
 		found = explore_term_branches(joiner, hgnd, do_clause);
 	}
@@ -2151,11 +2357,11 @@ bool PatternMatchEngine::do_next_clause(void)
  */
 void PatternMatchEngine::clause_stacks_push(void)
 {
+	_counts.clause_pushes++;
 	_clause_stack_depth++;
 	logmsg("--- CLAUSE stack push to depth=", _clause_stack_depth);
 
-	var_solutn_stack.push(var_grounding);
-	_clause_solutn_stack.push(clause_grounding);
+	_trail_marks.push_back(_trail.size());
 
 	choice_stack.push(_choice_state);
 
@@ -2183,11 +2389,12 @@ void PatternMatchEngine::clause_stacks_push(void)
  */
 void PatternMatchEngine::clause_stacks_pop(void)
 {
+	_counts.clause_pops++;
 	_pmc.pop();
 
 	// The grounding stacks are handled differently.
-	POPSTK(_clause_solutn_stack, clause_grounding);
-	POPSTK(var_solutn_stack, var_grounding);
+	trail_undo(_trail_marks.back());
+	_trail_marks.pop_back();
 
 	POPSTK(choice_stack, _choice_state);
 
@@ -2209,14 +2416,13 @@ void PatternMatchEngine::clause_stacks_clear(void)
 	_clause_stack_depth = 0;
 #if 0
 	// Currently, only GlobUTest fails when this is uncommented.
-	OC_ASSERT(0 == _clause_solutn_stack.size());
-	OC_ASSERT(0 == var_solutn_stack.size());
+	OC_ASSERT(0 == _trail_marks.size());
 	OC_ASSERT(0 == choice_stack.size());
 	OC_ASSERT(0 == _perm_stack.size());
 	OC_ASSERT(0 == _perm_stepper_stack.size());
 #else
-	while (!_clause_solutn_stack.empty()) _clause_solutn_stack.pop();
-	while (!var_solutn_stack.empty()) var_solutn_stack.pop();
+	_trail_marks.clear();
+	_trail.clear();
 	while (!choice_stack.empty()) choice_stack.pop();
 	while (!_perm_stack.empty()) _perm_stack.pop();
 	while (!_perm_stepper_stack.empty()) _perm_stepper_stack.pop();
@@ -2224,22 +2430,56 @@ void PatternMatchEngine::clause_stacks_clear(void)
 #endif
 }
 
+Handle& PatternMatchEngine::slot(GroundingMap& gm, const Handle& key)
+{
+	auto it = gm.find(key);
+	bool had = (gm.end() != it);
+
+	// Nothing to undo, if nothing has been pushed.
+	if (not _trail_marks.empty())
+		_trail.push_back({&gm, key,
+			had ? it->second : Handle::UNDEFINED, had});
+
+	if (had) return it->second;
+	return gm[key];
+}
+
+/// Undo all changes to the groundings, back to the given length
+/// of the trail. Undo them in the reverse order, as the same key
+/// may have been changed several times.
+void PatternMatchEngine::trail_undo(size_t mark)
+{
+	OC_ASSERT(mark <= _trail.size(), "Unbalanced grounding trail");
+	while (mark < _trail.size())
+	{
+		TrailEntry& te = _trail.back();
+		if (te.had)
+			(*te.map)[te.key] = std::move(te.prev);
+		else
+			te.map->erase(te.key);
+		_trail.pop_back();
+	}
+}
+
 void PatternMatchEngine::solution_push(void)
 {
-	var_solutn_stack.push(var_grounding);
-	_clause_solutn_stack.push(clause_grounding);
+	_trail_marks.push_back(_trail.size());
 }
 
 void PatternMatchEngine::solution_pop(void)
 {
-	POPSTK(var_solutn_stack, var_grounding);
-	POPSTK(_clause_solutn_stack, clause_grounding);
+	trail_undo(_trail_marks.back());
+	_trail_marks.pop_back();
 }
 
+/// Keep the changes made since the last push. They stay on the
+/// trail, and so are undone by an earlier push, if it is popped.
 void PatternMatchEngine::solution_drop(void)
 {
-	var_solutn_stack.pop();
-	_clause_solutn_stack.pop();
+	_trail_marks.pop_back();
+
+	// If nothing else was pushed, there is nothing left to undo.
+	if (_trail_marks.empty()) _trail.clear();
 }
 
 /* ======================================================== */
@@ -2253,7 +2493,10 @@ bool PatternMatchEngine::report_grounding(const GroundingMap &var_soln,
 	// If there is no for-all clause (no AlwaysLink clause)
 	// then report groundings as they are found.
 	if (_pat->always.size() == 0)
+	{
+		_counts.groundings++;
 		return _pmc.grounding(var_soln, term_soln);
+	}
 
 	// Don't even bother caching, if we know we are losing.
 	if (not _forall_state) return false;
@@ -2280,6 +2523,7 @@ bool PatternMatchEngine::report_forall(void)
 		OC_ASSERT(_term_ground_cache.size() == nitems);
 		for (size_t i=0; i<nitems; i++)
 		{
+			_counts.groundings++;
 			halt = _pmc.grounding(_var_ground_cache[i],
 			                      _term_ground_cache[i]);
 			if (halt) break;
@@ -2322,6 +2566,7 @@ bool PatternMatchEngine::explore_neighborhood(const PatternTermPtr& term,
                                               const Handle& grnd,
                                               const PatternTermPtr& clause)
 {
+	_counts.candidates++;
 	clause_stacks_clear();
 	clear_current_state();
 	_nack_cache.clear();
@@ -2409,12 +2654,12 @@ bool PatternMatchEngine::explore_clause_evaluatable(const PatternTermPtr& term,
 	// happy, and record the suggested grounding. There's nowhere
 	// else to do this, so we do it here.
 	if (term->isBoundVariable() or term->isGlobbyVar())
-		var_grounding[term->getHandle()] = grnd;
+		var_slot(term->getHandle()) = grnd;
 
 	// All variables in the clause had better be grounded!
 	OC_ASSERT(is_clause_grounded(clause), "Internal error!");
 
-	bool found = _pmc.evaluate_sentence(clause->getHandle(), var_grounding);
+	bool found = evaluate_sentence(clause->getHandle(), var_grounding);
 	logmsg("Post evaluating clause, found = ", found);
 	if (found)
 	{
@@ -2603,7 +2848,7 @@ bool PatternMatchEngine::explore_clause(const PatternTermPtr& term,
 		logmsg("Cache hit!");
 
 		// Record the clause grounding.
-		var_grounding[clause] = cac->second;
+		var_slot(clause) = cac->second;
 
 		// Copy variable groundings, which were stored in the key.
 		// Usually, this is not needed; however, if the variable
@@ -2613,7 +2858,7 @@ bool PatternMatchEngine::explore_clause(const PatternTermPtr& term,
 		const HandleSeq& clvars(_pat->clause_variables.at(pclause));
 		size_t cvsz = clvars.size();
 		for (size_t iv=0; iv<cvsz; iv++)
-			var_grounding[clvars[iv]] = key[iv+1];
+			var_slot(clvars[iv]) = key[iv+1];
 
 		return do_next_clause();
 	}
@@ -2647,11 +2892,11 @@ void PatternMatchEngine::record_grounding(const PatternTermPtr& ptm,
 	// Otherwise, just record the raw grounding.
 	// Tested in UnorderedUTest::test_quote() and elsewhere.
 	if (not ptm->isQuoted())
-		var_grounding[hp] = hg;
+		var_slot(hp) = hg;
 	else if (const Handle& quote = ptm->getQuote())
-		var_grounding[quote] = hg;
+		var_slot(quote) = hg;
 	else
-		var_grounding[hp] = hg;
+		var_slot(hp) = hg;
 }
 
 /**
@@ -2686,6 +2931,19 @@ void PatternMatchEngine::clear_current_state(void)
 	_glob_state.clear();
 }
 
+/// Evaluate an evaluatable clause, keeping track of the time spent.
+bool PatternMatchEngine::evaluate_sentence(const Handle& clause,
+                                           const GroundingMap& gnds)
+{
+	auto start = std::chrono::steady_clock::now();
+	bool found = _pmc.evaluate_sentence(clause, gnds);
+	std::chrono::duration<double> secs =
+		std::chrono::steady_clock::now() - start;
+	_counts.evaluations++;
+	_counts.eval_seconds += secs.count();
+	return found;
+}
+
 bool PatternMatchEngine::explore_constant_evaluatables(const PatternTermSeq& clauses)
 {
 	bool found = true;
@@ -2693,7 +2951,7 @@ bool PatternMatchEngine::explore_constant_evaluatables(const PatternTermSeq& cla
 	{
 		if (clause->hasAnyEvaluatable())
 		{
-			found = _pmc.evaluate_sentence(clause->getHandle(), GroundingMap());
+			found = evaluate_sentence(clause->getHandle(), GroundingMap());
 			if (not found)
 				break;
 		}
@@ -2711,6 +2969,9 @@ PatternMatchEngine::PatternMatchEngine(PatternMatchCallback& pmcb)
 	_pat(nullptr),
 	clause_accepted(false)
 {
+	_default_terms = _pmc.default_term_match();
+	_flat_ok = flat_match and _default_terms;
+
 	// current state
 	depth = 0;
 
@@ -2732,6 +2993,15 @@ PatternMatchEngine::PatternMatchEngine(PatternMatchCallback& pmcb)
 	_perm_odo_state.clear();
 }
 
+bool PatternMatchEngine::flat_match = true;
+
+/// Hand the counts over to whoever is collecting them.
+PatternMatchEngine::~PatternMatchEngine()
+{
+	QueryProfile* prof = _pmc.get_profile();
+	if (prof) prof->add(_counts);
+}
+
 void PatternMatchEngine::set_pattern(const Variables& v,
                                      const Pattern& p)
 {
@@ -142,6 +142,11 @@ private:
 	void perm_push(void);
 	void perm_pop(void);
 
+	// Pruning of permutations, when the default term callbacks are
+	// in use. See unorder_compare().
+	bool _default_terms;
+	bool could_match(const PatternTermPtr&, const Handle&);
+
 	// --------------------------------------------
 	// Glob state management
 
@@ -198,9 +203,28 @@ private:
 	void solution_pop(void);
 	void solution_drop(void);
 
-	// Stacks containing partial groundings.
-	std::stack<GroundingMap> var_solutn_stack;
-	std::stack<GroundingMap> _clause_solutn_stack;
+	// Partial groundings are not copied onto a stack. Instead, every
+	// change to `var_grounding` and `clause_grounding` is recorded on
+	// a trail (an undo log), and a push records how long the trail
+	// is. A pop undoes the changes made since the matching push. Thus,
+	// push and pop cost O(changes) rather than O(groundings). This
+	// matters for patterns with many clauses, where the maps get big.
+	struct TrailEntry
+	{
+		GroundingMap* map;
+		Handle key;
+		Handle prev;   // The earlier grounding, if there was one.
+		bool had;      // False, if there was no earlier grounding.
+	};
+	std::vector<TrailEntry> _trail;
+	std::vector<size_t> _trail_marks;
+
+	// Writable reference to the grounding of `key`, creating it if
+	// needed. The old grounding is saved on the trail, first.
+	Handle& var_slot(const Handle& key) { return slot(var_grounding, key); }
+	Handle& clause_slot(const Handle& key) { return slot(clause_grounding, key); }
+	Handle& slot(GroundingMap&, const Handle&);
+	void trail_undo(size_t);
 
 	std::stack<ChoiceState> choice_stack;
 
@@ -223,6 +247,10 @@ private:
 	                      const GroundingMap &term_soln);
 	bool report_forall(void);
 
+	// Counts of the work done, for the query profile.
+	QueryCounts _counts;
+	bool evaluate_sentence(const Handle&, const GroundingMap&);
+
 	// -------------------------------------------
 	// Recursive tree comparison algorithm.
 	unsigned int depth; // Recursion depth for tree_compare.
@@ -247,6 +275,20 @@ private:
 	bool unorder_compare(const PatternTermPtr&, const Handle&);
 	bool glob_compare(const PatternTermSeq&, const HandleSeq&);
 
+	// Simple terms are compared by walking their flattened form in
+	// a loop, instead of recursing through the callbacks above. This
+	// is only done if the callbacks are the default ones.
+	struct FlatFrame
+	{
+		size_t op;          // The link being compared ...
+		const Handle* gnd;  // ... to this grounding.
+		Arity pos;          // The next subterm to compare,
+		size_t next;        // and its instruction.
+	};
+	bool _flat_ok;
+	std::vector<FlatFrame> _flat_stack;
+	bool flat_compare(const FlatTerm&, const Handle&);
+
 	// -------------------------------------------
 	// Upwards-walking and grounding of a single clause.
 	// See PatternMatchEngine.cc for descriptions
@@ -286,8 +328,12 @@ private:
 
 public:
 	PatternMatchEngine(PatternMatchCallback&);
+	~PatternMatchEngine();
 	void set_pattern(const Variables&, const Pattern&);
 
+	/// Set to false to run all terms through the general matcher.
+	static bool flat_match;
+
 	// Examine the locally connected neighborhood for possible
 	// matches.
 	bool explore_neighborhood(const PatternTermPtr&, const Handle&,
@@ -0,0 +1,318 @@
+/*
+ * opencog/query/QueryPlanner.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cfloat>
+#include <cstdio>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/core/TypeChoice.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "QueryPlanner.h"
+
+using namespace opencog;
+
+// ====================================================================
+
+QueryPlanner::QueryPlanner(AtomSpace* as,
+                           const Variables& vars,
+                           const Pattern& pat) :
+	_as(as), _variables(vars), _pattern(pat),
+	_stats(QueryStats::of(as)),
+	_start_width(0.0), _cost(0.0), _groundings(0.0)
+{
+	choose_start();
+	order_clauses();
+}
+
+size_t QueryPlanner::rank(const PatternTermPtr& clause) const
+{
+	auto it = _rank.find(clause);
+	if (_rank.end() == it) return SIZE_MAX;
+	return it->second;
+}
+
+// ====================================================================
+
+/// Same rule as `InitiateSearchMixin::find_thinnest()`: the search
+/// cannot start in an evaluatable clause, except for IdenticalLink.
+bool QueryPlanner::startable(const PatternTermPtr& clause) const
+{
+	return not clause->hasAnyEvaluatable() or clause->isIdentical();
+}
+
+/// The number of Links that the search will have to look at, if it
+/// starts at this constant: the size of the incoming set, restricted
+/// to the type of the term holding the constant.
+double QueryPlanner::constant_width(const PatternTermPtr& ptm) const
+{
+	const Handle& h = ptm->getHandle();
+	const PatternTermPtr& parent = ptm->getParent();
+	if (nullptr == parent or nullptr == parent->getHandle()
+	    or CHOICE_LINK == parent->getHandle()->get_type())
+		return h->getIncomingSetSize(_as);
+
+	return h->getIncomingSetSizeByType(parent->getQuote()->get_type(), _as);
+}
+
+/// Find the thinnest constant in the term. As in
+/// `InitiateSearchMixin::find_starter_recursive()`, evaluatable
+/// terms are skipped.
+void QueryPlanner::find_start(const PatternTermPtr& ptm,
+                              Handle& best, double& width) const
+{
+	const Handle& h = ptm->getHandle();
+	Type t = h->get_type();
+	if (nameserver().isNode(t))
+	{
+		if (VARIABLE_NODE == t or GLOB_NODE == t) return;
+		double w = constant_width(ptm);
+		if (w < width)
+		{
+			best = h;
+			width = w;
+		}
+		return;
+	}
+
+	if (ptm->hasEvaluatable() and not ptm->isIdentical()) return;
+
+	for (const PatternTermPtr& sub : ptm->getOutgoingSet())
+		find_start(sub, best, width);
+}
+
+/// The expected number of groundings of the clause, given a grounding
+/// of the (variable) joint: how many Links, of the type holding the
+/// joint, does a typical grounding appear in?
+double QueryPlanner::joint_width(const PatternTermPtr& clause,
+                                 const Handle& joint) const
+{
+	auto ptms = _pattern.connected_terms_map.find({joint, clause});
+	if (_pattern.connected_terms_map.end() == ptms) return DBL_MAX;
+
+	// If the variable has a single type, use the degree histogram
+	// for that type; else use the fan-out of the Link type.
+	Type vtype = NOTYPE;
+	auto tvl = _variables._typemap.find(joint);
+	if (_variables._typemap.end() != tvl)
+	{
+		TypeChoicePtr tch = tvl->second->get_typedecl();
+		if (tch and tch->get_deep_typeset().empty()
+		    and 1 == tch->get_simple_typeset().size())
+			vtype = *tch->get_simple_typeset().begin();
+	}
+
+	double width = DBL_MAX;
+	for (const PatternTermPtr& ptm : ptms->second)
+	{
+		const PatternTermPtr& parent = ptm->getParent();
+
+		// The clause is the variable itself.
+		if (nullptr == parent or nullptr == parent->getHandle())
+			return 1.0;
+
+		Type lt = parent->getQuote()->get_type();
+		double w = (NOTYPE != vtype) ?
+			_stats->degree(vtype, lt).mean :
+			_stats->fanout(lt).mean;
+		if (w < width) width = w;
+	}
+	return width;
+}
+
+/// Estimate the number of groundings of the clause, per grounding of
+/// the clauses before it. Returns DBL_MAX if the clause does not share
+/// any variables with those clauses; else sets `joint` to the variable
+/// giving the estimate.
+double QueryPlanner::estimate(const PatternTermPtr& clause,
+                              const HandleSet& grounded,
+                              Handle& joint) const
+{
+	auto cvars = _pattern.clause_variables.find(clause);
+	if (_pattern.clause_variables.end() == cvars or
+	    cvars->second.empty())
+		return 1.0;
+
+	double est = DBL_MAX;
+	for (const Handle& v : cvars->second)
+	{
+		if (grounded.end() == grounded.find(v)) continue;
+		double w = joint_width(clause, v);
+		if (w < est)
+		{
+			est = w;
+			joint = v;
+		}
+	}
+	if (DBL_MAX == est) return est;
+
+	// No more groundings than the thinnest constant allows.
+	Handle cst;
+	double cwid = DBL_MAX;
+	find_start(clause, cst, cwid);
+	if (cwid < est)
+	{
+		est = cwid;
+		joint = cst;
+	}
+	return est;
+}
+
+// ====================================================================
+
+void QueryPlanner::choose_start(void)
+{
+	PatternTermPtr best_clause;
+	double best_width = DBL_MAX;
+	for (const PatternTermPtr& clause : _pattern.pmandatory)
+	{
+		if (not startable(clause)) continue;
+
+		Handle h;
+		double w = DBL_MAX;
+		find_start(clause, h, w);
+		if (h and w < best_width)
+		{
+			_start = h;
+			best_width = w;
+			best_clause = clause;
+		}
+	}
+
+	// No constants; the search will have to look at every Link
+	// of the clause type.
+	if (nullptr == best_clause)
+	{
+		for (const PatternTermPtr& clause : _pattern.pmandatory)
+		{
+			if (not startable(clause)) continue;
+			double w = _stats->count(clause->getQuote()->get_type());
+			if (w < best_width)
+			{
+				best_width = w;
+				best_clause = clause;
+			}
+		}
+	}
+	if (nullptr == best_clause) return;
+
+	_start_width = best_width;
+	_steps.push_back({best_clause, _start, best_width});
+	_rank[best_clause] = 0;
+}
+
+/// Greedy ordering: ground next whichever clause is expected to
+/// produce the fewest groundings, given the variables grounded so far.
+void QueryPlanner::order_clauses(void)
+{
+	if (_steps.empty()) return;
+
+	HandleSet grounded;
+	auto add_vars = [&](const PatternTermPtr& clause)
+	{
+		auto cvars = _pattern.clause_variables.find(clause);
+		if (_pattern.clause_variables.end() == cvars) return;
+		grounded.insert(cvars->second.begin(), cvars->second.end());
+	};
+	add_vars(_steps[0].clause);
+
+	PatternTermSeq todo;
+	for (const PatternTermPtr& clause : _pattern.pmandatory)
+		if (startable(clause) and 0 == _rank.count(clause))
+			todo.push_back(clause);
+
+	double rows = _start_width;
+	_cost = rows;
+	while (not todo.empty())
+	{
+		size_t best = 0;
+		Handle best_joint;
+		double best_est = DBL_MAX;
+		for (size_t i = 0; i < todo.size(); i++)
+		{
+			Handle joint;
+			double est = estimate(todo[i], grounded, joint);
+			if (est < best_est)
+			{
+				best = i;
+				best_est = est;
+				best_joint = joint;
+			}
+		}
+
+		// Not connected to anything grounded so far; this is a
+		// Cartesian product with every Link of that type.
+		if (DBL_MAX == best_est)
+			best_est = _stats->count(todo[best]->getQuote()->get_type());
+
+		const PatternTermPtr& clause = todo[best];
+		_rank[clause] = _steps.size();
+		_steps.push_back({clause, best_joint, best_est});
+		add_vars(clause);
+
+		rows *= best_est;
+		_cost += rows;
+		todo.erase(todo.begin() + best);
+	}
+	_groundings = rows;
+}
+
+// ====================================================================
+
+std::string QueryPlanner::explain(const std::string& indent) const
+{
+	char buf[80];
+	if (_steps.empty())
+		return indent + "No clauses to plan; the search is not indexed.\n";
+
+	snprintf(buf, sizeof(buf), "Estimated cost: %.1f\n", _cost);
+	std::string rs = indent + buf;
+
+	if (_start)
+	{
+		snprintf(buf, sizeof(buf), "Start (width %.0f): ",
+		         _start_width);
+		rs += indent + buf + _start->to_short_string() + "\n";
+	}
+	else
+	{
+		snprintf(buf, sizeof(buf), "No constants; scan all %.0f links\n",
+		         _start_width);
+		rs += indent + buf;
+	}
+
+	std::string ind2 = indent + "   ";
+	for (size_t i = 0; i < _steps.size(); i++)
+	{
+		const Step& st = _steps[i];
+		snprintf(buf, sizeof(buf), "Step %zu: estimate %.2f", i+1,
+		         st.estimate);
+		rs += indent + buf;
+		if (0 < i and st.joint)
+			rs += " joined by " + st.joint->to_short_string();
+		rs += "\n";
+		rs += st.clause->getHandle()->to_short_string(ind2) + "\n";
+	}
+	return rs;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,122 @@
+/*
+ * opencog/query/QueryPlanner.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_QUERY_PLANNER_H
+#define _OPENCOG_QUERY_PLANNER_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/core/Variables.h>
+#include <opencog/atoms/pattern/Pattern.h>
+#include <opencog/query/QueryStats.h>
+
+namespace opencog {
+
+class AtomSpace;
+
+/**
+ * Cost-based plan for grounding the mandatory clauses of a pattern.
+ *
+ * The plan picks the constant Atom at which the search starts, and
+ * then the order in which the remaining clauses are grounded. At each
+ * step, the next clause is the one expected to produce the fewest
+ * candidate groundings, given the variables grounded so far. The
+ * estimates come from `QueryStats`: the exact number of Links of the
+ * needed type that a constant appears in, and the sampled degree (or
+ * fan-out) of the joining variable.
+ *
+ * The cost of the plan is the total number of partial groundings that
+ * the search is expected to visit; that is, the sum, over all steps,
+ * of the product of the estimates so far.
+ *
+ * The pattern engine starts in the first clause of the plan, and then
+ * grounds the clauses in the planned order, as far as the groundings
+ * allow: it can only move on to a clause that shares a grounded
+ * variable with the clauses before it. Clauses that are not in the
+ * plan (evaluatables, optionals) are grounded after the others.
+ * `explain()` shows what the search will do, and why.
+ */
+class QueryPlanner
+{
+public:
+	struct Step
+	{
+		PatternTermPtr clause;
+		Handle joint;       // The variable (or constant) joining it.
+		double estimate;    // Expected groundings per incoming row.
+	};
+
+private:
+	AtomSpace* _as;
+	const Variables& _variables;
+	const Pattern& _pattern;
+	QueryStatsPtr _stats;
+
+	Handle _start;
+	double _start_width;
+	std::vector<Step> _steps;
+	std::map<PatternTermPtr, size_t> _rank;
+	double _cost;
+	double _groundings;
+
+	bool startable(const PatternTermPtr&) const;
+	void find_start(const PatternTermPtr&, Handle&, double&) const;
+	double constant_width(const PatternTermPtr&) const;
+	double joint_width(const PatternTermPtr&, const Handle&) const;
+	double estimate(const PatternTermPtr&, const HandleSet&, Handle&) const;
+
+	void choose_start(void);
+	void order_clauses(void);
+
+public:
+	QueryPlanner(AtomSpace*, const Variables&, const Pattern&);
+
+	/// The constant Atom at which the search is expected to start.
+	/// Undefined if the pattern has no usable constants.
+	const Handle& get_start(void) const { return _start; }
+
+	/// The clauses, in the planned order; the first is the one
+	/// holding the start.
+	const std::vector<Step>& get_steps(void) const { return _steps; }
+
+	/// Position of the clause in the plan; clauses that are not in
+	/// the plan (evaluatables, optionals) come after all the others.
+	size_t rank(const PatternTermPtr&) const;
+
+	/// Expected number of partial groundings visited.
+	double cost(void) const { return _cost; }
+
+	/// Expected number of groundings of the whole pattern; that is,
+	/// the product of the estimates of all of the steps.
+	double groundings(void) const { return _groundings; }
+
+	std::string explain(const std::string& indent=empty_string) const;
+};
+
+typedef std::shared_ptr<QueryPlanner> QueryPlannerPtr;
+
+} // namespace opencog
+
+#endif // _OPENCOG_QUERY_PLANNER_H
@@ -0,0 +1,108 @@
+/*
+ * opencog/query/QueryProfile.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdio>
+
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/FloatValue.h>
+
+#include "QueryProfile.h"
+
+using namespace opencog;
+
+// ====================================================================
+
+void QueryCounts::add(const QueryCounts& other)
+{
+	candidates += other.candidates;
+	tree_compares += other.tree_compares;
+	clause_pushes += other.clause_pushes;
+	clause_pops += other.clause_pops;
+	permutations += other.permutations;
+	glob_backtracks += other.glob_backtracks;
+	evaluations += other.evaluations;
+	eval_seconds += other.eval_seconds;
+	groundings += other.groundings;
+}
+
+// ====================================================================
+
+void QueryProfile::add(const QueryCounts& counts)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_counts.add(counts);
+}
+
+QueryCounts QueryProfile::get(void) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _counts;
+}
+
+void QueryProfile::clear(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_counts = QueryCounts();
+}
+
+const Handle& QueryProfile::key(void)
+{
+	static Handle pk(createNode(PREDICATE_NODE, "*-QueryProfileKey-*"));
+	return pk;
+}
+
+ValuePtr QueryProfile::get_value(void) const
+{
+	QueryCounts c(get());
+	return createFloatValue(std::vector<double>({
+		(double) c.candidates,
+		(double) c.tree_compares,
+		(double) c.clause_pushes,
+		(double) c.clause_pops,
+		(double) c.permutations,
+		(double) c.glob_backtracks,
+		(double) c.evaluations,
+		c.eval_seconds,
+		(double) c.groundings}));
+}
+
+std::string QueryProfile::to_string(void) const
+{
+	QueryCounts c(get());
+	char buf[400];
+	snprintf(buf, sizeof(buf),
+		"candidates: %zu\n"
+		"tree compares: %zu\n"
+		"clause pushes: %zu\n"
+		"clause pops: %zu\n"
+		"permutations: %zu\n"
+		"glob backtracks: %zu\n"
+		"evaluations: %zu\n"
+		"evaluation secs: %f\n"
+		"groundings: %zu\n",
+		c.candidates, c.tree_compares, c.clause_pushes, c.clause_pops,
+		c.permutations, c.glob_backtracks, c.evaluations,
+		c.eval_seconds, c.groundings);
+	return buf;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,88 @@
+/*
+ * opencog/query/QueryProfile.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_QUERY_PROFILE_H
+#define _OPENCOG_QUERY_PROFILE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog {
+
+/**
+ * Counts of the work done by the pattern engine, for one query.
+ * Each PatternMatchEngine keeps its own counts, with no locking, and
+ * adds them to the QueryProfile of the query when it is done. These
+ * are cheap enough to be always on; the QDEBUG logs are not.
+ */
+struct QueryCounts
+{
+	size_t candidates = 0;       // Starting points explored.
+	size_t tree_compares = 0;    // Calls to tree_compare().
+	size_t clause_pushes = 0;    // Clause-stack pushes ...
+	size_t clause_pops = 0;      // ... and pops.
+	size_t permutations = 0;     // Unordered-link permutations tried.
+	size_t glob_backtracks = 0;  // Glob groundings retracted.
+	size_t evaluations = 0;      // Evaluatable clauses evaluated ...
+	double eval_seconds = 0.0;   // ... and the time spent on them.
+	size_t groundings = 0;       // Groundings reported.
+
+	void add(const QueryCounts&);
+};
+
+/**
+ * The profile of one query run. Shared between all of the engines
+ * working on the query, including those on other threads.
+ *
+ * After each run, the query's PatternLink keeps the profile. It is
+ * attached to the query Atom only when asked for, by
+ * `cog-query-profile`, as a FloatValue at `QueryProfile::key()`. The
+ * FloatValue holds the counts in the order in which they are declared
+ * above.
+ */
+class QueryProfile
+{
+	mutable std::mutex _mtx;
+	QueryCounts _counts;
+
+public:
+	void add(const QueryCounts&);
+	QueryCounts get(void) const;
+	void clear(void);
+
+	/// The counts, as a FloatValue.
+	ValuePtr get_value(void) const;
+	std::string to_string(void) const;
+
+	/// The key under which the profile is attached to the query.
+	static const Handle& key(void);
+};
+
+typedef std::shared_ptr<QueryProfile> QueryProfilePtr;
+
+} // namespace opencog
+
+#endif // _OPENCOG_QUERY_PROFILE_H
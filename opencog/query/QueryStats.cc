@@ -0,0 +1,201 @@
+/*
+ * opencog/query/QueryStats.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "QueryStats.h"
+
+using namespace opencog;
+
+size_t QueryStats::sample_size = 64;
+
+// ====================================================================
+
+QueryStats::QueryStats(AtomSpace* as) :
+	_as(as)
+{
+}
+
+/// Stats are kept for the most recently used AtomSpaces. They are
+/// keyed by the UUID, which is never re-used, and so stats for an
+/// AtomSpace that is gone are never handed out; they just age out,
+/// the least recently used first.
+QueryStatsPtr QueryStats::of(AtomSpace* as)
+{
+	static std::mutex mtx;
+	static std::map<UUID, std::pair<QueryStatsPtr, size_t>> registry;
+	static size_t clock = 0;
+	static const size_t max_kept = 64;
+
+	std::lock_guard<std::mutex> lck(mtx);
+	clock++;
+	UUID id = as->get_uuid();
+	auto it = registry.find(id);
+	if (registry.end() != it)
+	{
+		it->second.second = clock;
+		return it->second.first;
+	}
+
+	if (max_kept <= registry.size())
+	{
+		auto oldest = std::min_element(registry.begin(), registry.end(),
+			[](const auto& a, const auto& b)
+				{ return a.second.second < b.second.second; });
+		registry.erase(oldest);
+	}
+
+	QueryStatsPtr qs(std::make_shared<QueryStats>(as));
+	registry.insert({id, {qs, clock}});
+	return qs;
+}
+
+size_t QueryStats::count(Type t)
+{
+	return _as->get_num_atoms_of_type(t);
+}
+
+// ====================================================================
+
+static void add_to(QueryStats::Degree& deg, size_t d)
+{
+	size_t b = 0;
+	while ((((size_t) 2) << b) - 1 <= d) b++;
+	if (deg.buckets.size() <= b) deg.buckets.resize(b+1, 0);
+	deg.buckets[b]++;
+	deg.mean += d;
+}
+
+/// Sample the Atoms of type `t` (or the Links of type `t`, if `link`
+/// is set), unless the sample that we have is still good. The lock
+/// must be held.
+QueryStats::Sample& QueryStats::sample(std::map<Type, Sample>& samples,
+                                       Type t, bool link)
+{
+	size_t pop = count(t);
+	auto it = samples.find(t);
+	if (samples.end() != it)
+	{
+		size_t was = it->second.population;
+		if (4 * pop <= 5 * was and 4 * was <= 5 * pop)
+			return it->second;
+	}
+
+	Sample& smp = samples[t];
+	smp.population = pop;
+	smp.sampled = 0;
+	smp.degrees.clear();
+
+	// This is called during searches; don't copy all of the Atoms
+	// of the type, just to look at a few of them.
+	HandleSeq some;
+	_as->sample_by_type(some, t, sample_size);
+
+	size_t n = 0;
+	for (const Handle& h : some)
+	{
+		if (link)
+		{
+			// Fan-out: for each member of the Link, how many Links of
+			// this type is it in?
+			Degree& deg = smp.degrees[t];
+			for (const Handle& ho : h->getOutgoingSet())
+			{
+				add_to(deg, ho->getIncomingSetSizeByType(t, _as));
+				deg.sampled++;
+			}
+			continue;
+		}
+
+		// Degree: how many Links of each type is the Atom in?
+		n++;
+		std::map<Type, size_t> deg;
+		for (const Handle& hi : h->getIncomingSet(_as))
+			deg[hi->get_type()]++;
+		for (const auto& pr : deg)
+		{
+			add_to(smp.degrees[pr.first], pr.second);
+			smp.degrees[pr.first].sampled++;
+		}
+	}
+
+	// The Atoms that are not in any Link of some type have degree
+	// zero, for that type.
+	for (auto& pr : smp.degrees)
+	{
+		Degree& deg = pr.second;
+		if (not link and deg.sampled < n)
+		{
+			if (deg.buckets.empty()) deg.buckets.resize(1, 0);
+			deg.buckets[0] += n - deg.sampled;
+			deg.sampled = n;
+		}
+		if (0 < deg.sampled) deg.mean /= deg.sampled;
+	}
+
+	smp.sampled = n;
+	return smp;
+}
+
+QueryStats::Degree QueryStats::degree(Type t, Type lt)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	Sample& smp = sample(_by_type, t, false);
+	auto it = smp.degrees.find(lt);
+	if (smp.degrees.end() != it) return it->second;
+
+	// None of the sampled Atoms are in any such Links.
+	Degree none;
+	none.sampled = smp.sampled;
+	if (0 < none.sampled) none.buckets.push_back(none.sampled);
+	return none;
+}
+
+QueryStats::Degree QueryStats::fanout(Type lt)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	Sample& smp = sample(_by_link, lt, true);
+	auto it = smp.degrees.find(lt);
+	if (smp.degrees.end() != it) return it->second;
+	return Degree();
+}
+
+// ====================================================================
+
+std::string QueryStats::Degree::to_string(void) const
+{
+	char buf[40];
+	snprintf(buf, sizeof(buf), "mean=%.2f", mean);
+	std::string rs = buf;
+	rs += " sampled=" + std::to_string(sampled) + " hist=[";
+	for (size_t i = 0; i < buckets.size(); i++)
+	{
+		if (0 < i) rs += " ";
+		rs += std::to_string(buckets[i]);
+	}
+	return rs + "]";
+}
+
+/* ===================== END OF FILE ===================== */
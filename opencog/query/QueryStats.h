@@ -0,0 +1,110 @@
+/*
+ * opencog/query/QueryStats.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_QUERY_STATS_H
+#define _OPENCOG_QUERY_STATS_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog {
+
+class AtomSpace;
+
+/**
+ * Cheap statistics about the contents of an AtomSpace, for use by
+ * the query planner when it estimates how many candidate groundings
+ * each step of a search will produce.
+ *
+ * Two kinds of statistics are kept:
+ *
+ * -- The degree histogram of Atoms of type T, into Links of type L.
+ *    That is, how many Links of type L does a typical Atom of type T
+ *    appear in? This is used for typed variables.
+ *
+ * -- The fan-out of Links of type L: for a typical Atom appearing in
+ *    some L, how many L's does it appear in? This is used for untyped
+ *    variables.
+ *
+ * Both are found by sampling a few Atoms, the first time that they
+ * are needed. They are re-sampled after the number of Atoms of that
+ * type has changed by a quarter, so the cost of keeping them is
+ * amortized over the Atoms added.
+ */
+class QueryStats
+{
+public:
+	/// Histogram of the number of Links of some type that an Atom
+	/// appears in. Bucket `i` counts the Atoms with degree in the
+	/// range [2^i - 1, 2^(i+1) - 1), so bucket zero is degree zero.
+	struct Degree
+	{
+		size_t sampled = 0;
+		double mean = 0.0;
+		std::vector<size_t> buckets;
+		std::string to_string(void) const;
+	};
+
+private:
+	AtomSpace* _as;
+	std::mutex _mtx;
+
+	struct Sample
+	{
+		size_t population;
+		size_t sampled;
+		std::map<Type, Degree> degrees;
+	};
+	std::map<Type, Sample> _by_type;
+	std::map<Type, Sample> _by_link;
+
+	static size_t sample_size;
+
+	Sample& sample(std::map<Type, Sample>&, Type, bool);
+
+public:
+	QueryStats(AtomSpace*);
+
+	/// The stats for the given AtomSpace. These are shared by all
+	/// queries, and kept for the most recently used AtomSpaces.
+	static std::shared_ptr<QueryStats> of(AtomSpace*);
+
+	/// Number of Atoms of type t. Exact.
+	size_t count(Type t);
+
+	/// Degree of Atoms of type `t` into Links of type `lt`.
+	Degree degree(Type t, Type lt);
+
+	/// Fan-out of the Atoms appearing in Links of type `lt`.
+	Degree fanout(Type lt);
+};
+
+typedef std::shared_ptr<QueryStats> QueryStatsPtr;
+
+} // namespace opencog
+
+#endif // _OPENCOG_QUERY_STATS_H
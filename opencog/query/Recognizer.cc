@@ -26,6 +26,7 @@
 #include <opencog/atoms/core/FindUtils.h>
 #include <opencog/query/PatternMatchEngine.h>
 #include "Recognizer.h"
+#include "RuleIndex.h"
 
 using namespace opencog;
 
@@ -37,6 +38,8 @@ using namespace opencog;
 #define dbgprt(f, varargs...)
 #endif
 
+bool Recognizer::use_index = true;
+
 /* ======================================================== */
 
 bool Recognizer::do_search(PatternMatchCallback& pmc, const Handle& top)
@@ -78,15 +81,40 @@ bool Recognizer::do_search(PatternMatchCallback& pmc, const Handle& top)
 	return false;
 }
 
+/// Try each of the candidate rules, as a grounding of the entire
+/// clause.
+bool Recognizer::index_search(PatternMatchCallback& pmc,
+                              const HandleSeq& rules)
+{
+	PatternMatchEngine pme(pmc);
+	pme.set_pattern(*_vars, *_pattern);
+
+	_starter_term = _root;
+	for (const Handle& h : rules)
+	{
+		dbgprt("Index candidate (%lu):\n%s\n", _cnt++,
+		       h->to_short_string().c_str());
+		bool found = pme.explore_neighborhood(_root, h, _root);
+		if (found) return true;
+	}
+	return false;
+}
+
 bool Recognizer::perform_search(PatternMatchCallback& pmc)
 {
 	const PatternTermSeq& clauses = _pattern->pmandatory;
 
+	RuleIndexPtr idx;
+	if (use_index) idx = RuleIndex::of(_as);
+
 	_cnt = 0;
 	for (const PatternTermPtr& ptm: clauses)
 	{
 		_root = ptm;
-		bool found = do_search(pmc, ptm->getHandle());
+		const Handle& body = ptm->getHandle();
+		bool found = (idx and RuleIndex::can_recognize(body)) ?
+			index_search(pmc, idx->recognize(body)) :
+			do_search(pmc, body);
 		if (found) return true;
 	}
 	return false;
@@ -44,6 +44,10 @@ namespace opencog {
  * The is, the constant clause `I love you` can be recognized as
  * grounding two different graphs with variables in them: the graph
  * `I * you` and `I love *`.
+ *
+ * When the AtomSpace has a RuleIndex, only the rules that the index
+ * offers up are tried; otherwise, the incoming sets of each of the
+ * Nodes in the data are walked, and every Link found is tried.
  */
 class Recognizer :
 	public TermMatchMixin,
@@ -60,11 +64,16 @@ class Recognizer :
 		PatternTermPtr _starter_term;
 		size_t _cnt;
 		bool do_search(PatternMatchCallback&, const Handle&);
+		bool index_search(PatternMatchCallback&, const HandleSeq&);
 		bool loose_match(const Handle&, const Handle&);
 
 	public:
 		HandleSet _rules;
 
+		/// Look up candidate rules in the RuleIndex of the AtomSpace,
+		/// instead of walking the incoming sets. On by default.
+		static bool use_index;
+
 		Recognizer(AtomSpace* as) :
 		    TermMatchMixin(as),
 		    _pattern(nullptr),
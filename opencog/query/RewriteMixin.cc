@@ -29,7 +29,7 @@
 using namespace opencog;
 
 RewriteMixin::RewriteMixin(AtomSpace* as)
-	: _as(as), inst(as), max_results(SIZE_MAX)
+	: _as(as), _primary(this), inst(as), max_results(SIZE_MAX)
 {
 }
 
@@ -46,9 +46,16 @@ RewriteMixin::RewriteMixin(AtomSpace* as)
 bool RewriteMixin::grounding(const GroundingMap &var_soln,
                              const GroundingMap &term_soln)
 {
-	LOCK_PE_MUTEX;
+	// Copies made by clone() take the lock of the original. The
+	// implicand is instantiated under the lock, too, as it might
+	// run user code (e.g. a GroundedSchema) that is not thread-safe.
+	std::lock_guard<std::mutex> lck(_primary->_gnd_mtx);
 	// PatternMatchEngine::print_solution(var_soln, term_soln);
 
+	// Some other copy might have found the last one already.
+	if (_primary->_result_set.size() >= max_results)
+		return true;
+
 	// Catch and ignore SilentExceptions. This arises when
 	// running with the URE, which creates ill-formed links
 	// (due to rules producing nothing). Ideally this should
@@ -62,12 +69,12 @@ bool RewriteMixin::grounding(const GroundingMap &var_soln,
 		for (const Handle& himp: implicand)
 		{
 			ValuePtr v(inst.instantiate(himp, var_soln, true));
-			insert_result(v);
+			_primary->insert_result(v);
 		}
 	} catch (const SilentException& ex) {}
 
 	// If we found as many as we want, then stop looking for more.
-	return (_result_set.size() >= max_results);
+	return (_primary->_result_set.size() >= max_results);
 }
 
 void RewriteMixin::insert_result(ValuePtr v)
@@ -24,6 +24,7 @@
 #ifndef _OPENCOG_REWRITE_MIXIN_H
 #define _OPENCOG_REWRITE_MIXIN_H
 
+#include <mutex>
 #include <vector>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -58,7 +59,11 @@ class RewriteMixin :
 	protected:
 		AtomSpace* _as;
 
-		DECLARE_PE_MUTEX;
+		// Copies made by clone() put their results into the set and
+		// the queue of the original, under its lock, so that results
+		// are unique, and max_results is honored exactly.
+		RewriteMixin* _primary;
+		std::mutex _gnd_mtx;
 		ValueSet _result_set;
 		QueueValuePtr _result_queue;
 		void insert_result(ValuePtr);
@@ -0,0 +1,348 @@
+/*
+ * opencog/query/RuleIndex.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <functional>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+
+#include "RuleIndex.h"
+
+using namespace opencog;
+
+// The arity filed for Links that stand for any Link of their type.
+static const Arity ANY_ARITY = (Arity) -1;
+
+// If more than this many Atoms are added or removed between lookups,
+// rebuild the index, instead of filing each of them.
+#define MAX_PENDING 100000
+
+// ====================================================================
+
+bool RuleIndex::Key::operator<(const Key& other) const
+{
+	if (type != other.type) return type < other.type;
+	if (arity != other.arity) return arity < other.arity;
+
+	// Links have no node; nodes are compared by name.
+	if (node == other.node or nullptr == other.node) return false;
+	if (nullptr == node) return true;
+	return node < other.node;
+}
+
+static bool is_wild(Type t)
+{
+	return VARIABLE_NODE == t or GLOB_NODE == t;
+}
+
+static void find_kinds(const Handle& h, bool& wild, bool& constant)
+{
+	if (h->is_node())
+	{
+		if (is_wild(h->get_type())) wild = true;
+		else constant = true;
+		return;
+	}
+	for (const Handle& ho : h->getOutgoingSet())
+	{
+		find_kinds(ho, wild, constant);
+		if (wild and constant) return;
+	}
+}
+
+/// Rules have both variables and constants in them. Those without
+/// constants can never be found by walking incoming sets, and so
+/// were never recognized; they are not indexed.
+bool RuleIndex::is_rule(const Handle& h)
+{
+	if (not h->is_link()) return false;
+	bool wild = false;
+	bool constant = false;
+	find_kinds(h, wild, constant);
+	return wild and constant;
+}
+
+RuleIndex::Key RuleIndex::key_of(const Handle& h)
+{
+	if (h->is_node()) return {h->get_type(), 0, h};
+	return {h->get_type(), h->get_arity(), Handle::UNDEFINED};
+}
+
+/// Depth-first, with the end of the subtree of each Atom.
+void RuleIndex::flatten(const Handle& h, Flat& flat)
+{
+	size_t at = flat.size();
+	flat.push_back({key_of(h), 0});
+	if (h->is_link())
+		for (const Handle& ho : h->getOutgoingSet())
+			flatten(ho, flat);
+	flat[at].second = flat.size();
+}
+
+static bool is_unsupported(const Handle& h)
+{
+	Type t = h->get_type();
+	if (is_wild(t)) return true;
+	if (DEFINED_SCHEMA_NODE == t or DEFINED_PREDICATE_NODE == t)
+		return true;
+	if (h->is_node()) return false;
+
+	NameServer& ns = nameserver();
+	if (QUOTE_LINK == t or UNQUOTE_LINK == t or LOCAL_QUOTE_LINK == t or
+	    DONT_EXEC_LINK == t or ns.isA(t, CHOICE_LINK) or
+	    ns.isA(t, PRESENT_LINK))
+		return true;
+
+	for (const Handle& ho : h->getOutgoingSet())
+		if (is_unsupported(ho)) return true;
+	return false;
+}
+
+bool RuleIndex::can_recognize(const Handle& input)
+{
+	return input->is_link() and not is_unsupported(input);
+}
+
+// ====================================================================
+
+/// Walk down the trie to where `h` is filed, creating the branches
+/// as needed. If `path` is given, the steps taken are recorded.
+RuleIndex::Branch* RuleIndex::file(Branch* br, const Handle& h, Path* path)
+{
+	Type t = h->get_type();
+	if (is_wild(t))
+	{
+		if (nullptr == br->any) br->any.reset(new Branch());
+		if (path) path->push_back({br, nullptr});
+		return br->any.get();
+	}
+
+	// Links with globs directly in them can match Links of any
+	// arity; and unordered Links, in any order. Don't look inside.
+	Key key(key_of(h));
+	bool wild = false;
+	if (h->is_link())
+	{
+		if (nameserver().isA(t, UNORDERED_LINK))
+			wild = true;
+		else
+			for (const Handle& ho : h->getOutgoingSet())
+				if (GLOB_NODE == ho->get_type()) { wild = true; break; }
+		if (wild) key.arity = ANY_ARITY;
+	}
+
+	auto it = br->next.find(key);
+	if (br->next.end() == it)
+		it = br->next.emplace(key, new Branch()).first;
+	if (path) path->push_back({br, &it->first});
+	br = it->second.get();
+
+	if (wild or h->is_node()) return br;
+	for (const Handle& ho : h->getOutgoingSet())
+		br = file(br, ho, path);
+	return br;
+}
+
+void RuleIndex::insert(const Handle& h)
+{
+	Branch* br = file(&_root, h, nullptr);
+	if (br->rules.insert(h).second) _size++;
+}
+
+void RuleIndex::remove(const Handle& h)
+{
+	Path path;
+	Branch* br = file(&_root, h, &path);
+	if (br->rules.erase(h)) _size--;
+
+	// Prune the branches left empty, from the leaf up.
+	for (auto step = path.rbegin(); step != path.rend(); step++)
+	{
+		Branch* parent = step->first;
+		if (nullptr == step->second)
+		{
+			if (not parent->any->empty()) return;
+			parent->any.reset();
+			continue;
+		}
+		auto it = parent->next.find(*step->second);
+		if (not it->second->empty()) return;
+		parent->next.erase(it);
+	}
+}
+
+/// Collect the rules filed at the branches that agree with the input,
+/// from position `pos` onwards.
+void RuleIndex::lookup(const Branch* br, const Flat& flat, size_t pos,
+                       HandleSeq& found) const
+{
+	if (flat.size() == pos)
+	{
+		found.insert(found.end(), br->rules.begin(), br->rules.end());
+		return;
+	}
+
+	const Key& key = flat[pos].first;
+	size_t end = flat[pos].second;
+
+	// A variable takes the whole subtree.
+	if (br->any) lookup(br->any.get(), flat, end, found);
+
+	// So does a Link that can have any arity.
+	if (Handle::UNDEFINED == key.node)
+	{
+		auto it = br->next.find({key.type, ANY_ARITY, Handle::UNDEFINED});
+		if (br->next.end() != it) lookup(it->second.get(), flat, end, found);
+	}
+
+	auto it = br->next.find(key);
+	if (br->next.end() != it) lookup(it->second.get(), flat, pos+1, found);
+}
+
+// ====================================================================
+
+RuleIndex::RuleIndex(AtomSpace* as) :
+	_as(as->weak_from_this()), _asp(as), _size(0), _stale(true)
+{
+	// Listen first, so that nothing added during the first scan is
+	// missed. Rules filed twice are filed once.
+	_add_sig = as->atomAddedSignal().connect(
+		std::bind(&RuleIndex::added, this, std::placeholders::_1));
+	_rem_sig = as->atomRemovedSignal().connect(
+		std::bind(&RuleIndex::removed, this, std::placeholders::_1));
+}
+
+RuleIndex::~RuleIndex()
+{
+	// If the AtomSpace is gone, so are its signals. This includes the
+	// case where the AtomSpace is destroying this index.
+	ValuePtr keep(_as.lock());
+	if (nullptr == keep) return;
+	_asp->atomAddedSignal().disconnect(_add_sig);
+	_asp->atomRemovedSignal().disconnect(_rem_sig);
+}
+
+/// The index is held by the AtomSpace, and so lives exactly as long
+/// as it does. AtomSpaces that are not held by a smart pointer cannot
+/// be followed, and frames do not see the changes to the AtomSpaces
+/// below them; neither get one.
+RuleIndexPtr RuleIndex::of(AtomSpace* as)
+{
+	if (nullptr == as or 0 < as->get_arity()) return nullptr;
+	if (as->weak_from_this().expired()) return nullptr;
+
+	std::lock_guard<std::mutex> lck(as->_rule_mtx);
+	if (nullptr == as->_rule_index)
+		as->_rule_index = std::make_shared<RuleIndex>(as);
+	return as->_rule_index;
+}
+
+/// File the rules added and removed since the last lookup, or, if the
+/// index is stale, rebuild it. Must be called with `_mtx` held.
+void RuleIndex::catch_up(void)
+{
+	if (_stale)
+	{
+		_root.next.clear();
+		_root.any.reset();
+		_root.rules.clear();
+		_size = 0;
+		_pending.clear();
+
+		HandleSeq links;
+		_asp->get_handles_by_type(links, LINK, true);
+		for (const Handle& h : links)
+			if (is_rule(h)) insert(h);
+		_stale = false;
+		return;
+	}
+
+	for (const auto& pr : _pending)
+	{
+		if (not is_rule(pr.first)) continue;
+		if (pr.second) insert(pr.first);
+		else remove(pr.first);
+	}
+	_pending.clear();
+}
+
+HandleSeq RuleIndex::recognize(const Handle& input)
+{
+	// An index held past the end of its AtomSpace finds nothing.
+	ValuePtr keep(_as.lock());
+	if (nullptr == keep) return HandleSeq();
+
+	Flat flat;
+	flatten(input, flat);
+
+	HandleSeq found;
+	std::lock_guard<std::mutex> lck(_mtx);
+	catch_up();
+	lookup(&_root, flat, 0, found);
+
+	// AtomSpace::clear() does not send signals; drop the rules that
+	// were cleared out, when they turn up.
+	HandleSeq live;
+	for (const Handle& h : found)
+	{
+		if (_asp == h->getAtomSpace()) live.push_back(h);
+		else remove(h);
+	}
+	return live;
+}
+
+size_t RuleIndex::size(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	catch_up();
+	return _size;
+}
+
+// ====================================================================
+// Signal handlers. These are called from within the AtomSpace.
+
+void RuleIndex::added(const Handle& h)
+{
+	if (not h->is_link()) return;
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (_stale) return;
+	_pending.push_back({h, true});
+	if (MAX_PENDING < _pending.size())
+	{
+		_pending.clear();
+		_stale = true;
+	}
+}
+
+void RuleIndex::removed(const Handle& h)
+{
+	if (not h->is_link()) return;
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (_stale) return;
+	_pending.push_back({h, false});
+	if (MAX_PENDING < _pending.size())
+	{
+		_pending.clear();
+		_stale = true;
+	}
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,138 @@
+/*
+ * opencog/query/RuleIndex.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_RULE_INDEX_H
+#define _OPENCOG_RULE_INDEX_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog {
+
+class RuleIndex;
+typedef std::shared_ptr<RuleIndex> RuleIndexPtr;
+
+/**
+ * A discrimination tree over the rules in an AtomSpace, for use by
+ * the Recognizer. A rule is any Link having both VariableNodes or
+ * GlobNodes and constant Nodes in it; rules are the things that a
+ * DualLink recognizes.
+ *
+ * Rules are walked depth-first, and filed in a trie, by the type of
+ * each Atom in turn, together with the arity of Links and the name
+ * of Nodes. A VariableNode is filed as a wildcard, standing for any
+ * one Atom, and so is any Link with a GlobNode directly in it, or an
+ * unordered Link: these stand for any Atom of that type. Thus, to
+ * recognize some input, only the branches of the trie that agree
+ * with the input are walked; all other rules are never looked at.
+ *
+ * The candidates found this way are a superset of the rules that the
+ * input grounds; each must still be checked by the pattern engine.
+ *
+ * The index is built the first time it is asked for, and is kept in,
+ * and destroyed with, the AtomSpace. It follows the AtomSpace add and
+ * remove signals; these only note the Atom, which is filed the next
+ * time the index is used. Only AtomSpaces held by a smart pointer get
+ * an index.
+ */
+class RuleIndex
+{
+	struct Key
+	{
+		Type type;
+		Arity arity;
+		Handle node;
+		bool operator<(const Key&) const;
+	};
+
+	struct Branch
+	{
+		std::map<Key, std::unique_ptr<Branch>> next;
+		std::unique_ptr<Branch> any;
+		UnorderedHandleSet rules;
+		bool empty(void) const
+			{ return next.empty() and nullptr == any and rules.empty(); }
+	};
+
+	// A step along the path to a rule: the branch, and the key taken
+	// out of it, or null, for the wildcard.
+	typedef std::vector<std::pair<Branch*, const Key*>> Path;
+
+	// The input, flattened depth-first, with the end of each subtree.
+	typedef std::vector<std::pair<Key, size_t>> Flat;
+
+	std::weak_ptr<Value> _as;
+	AtomSpace* _asp;
+	std::mutex _mtx;
+	Branch _root;
+	size_t _size;
+
+	// Atoms added (true) or removed (false) since the last lookup.
+	// If there are too many, or none were filed yet, the index is
+	// stale, and is rebuilt from the AtomSpace instead.
+	std::vector<std::pair<Handle, bool>> _pending;
+	bool _stale;
+	void catch_up(void);
+
+	int _add_sig;
+	int _rem_sig;
+
+	static bool is_rule(const Handle&);
+	static Key key_of(const Handle&);
+	static void flatten(const Handle&, Flat&);
+
+	Branch* file(Branch*, const Handle&, Path*);
+	void insert(const Handle&);
+	void remove(const Handle&);
+	void lookup(const Branch*, const Flat&, size_t, HandleSeq&) const;
+
+	void added(const Handle&);
+	void removed(const Handle&);
+
+public:
+	RuleIndex(AtomSpace*);
+	~RuleIndex();
+
+	/// The index of the rules in the given AtomSpace, or null, if it
+	/// cannot have one. These are shared by all Recognizers, and kept
+	/// in the AtomSpace.
+	static RuleIndexPtr of(AtomSpace*);
+
+	/// Return true if the index can be used to recognize `input`.
+	/// It cannot, if `input` itself holds variables or quotes.
+	static bool can_recognize(const Handle& input);
+
+	/// The rules that `input` might ground.
+	HandleSeq recognize(const Handle& input);
+
+	/// The number of rules in the index.
+	size_t size(void);
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_RULE_INDEX_H
@@ -21,6 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <typeinfo>
+
 #include <opencog/util/oc_assert.h>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -130,7 +132,7 @@ bool Satisfier::search_finished(bool done)
 bool SatisfyingSet::grounding(const GroundingMap &var_soln,
                               const GroundingMap &term_soln)
 {
-	LOCK_PE_MUTEX;
+	std::lock_guard<std::mutex> lck(_primary->_gnd_mtx);
 	// PatternMatchEngine::log_solution(var_soln, term_soln);
 
 	// Do not accept new solution if maximum number has been already reached
@@ -195,4 +197,21 @@ bool SatisfyingSet::search_finished(bool done)
 	return done;
 }
 
+/// Make a copy that puts its results in the same queue. This is done
+/// only for this class, and not for classes that inherit from it, as
+/// those might have state that must not be shared, or must not be
+/// left out. They get a single-threaded search, unless they provide
+/// their own clone().
+PatternMatchCallback* SatisfyingSet::clone(void)
+{
+	if (typeid(*this) != typeid(SatisfyingSet)) return nullptr;
+
+	SatisfyingSet* ss = new SatisfyingSet(_as);
+	ss->_primary = _primary;
+	ss->_profile = _profile;
+	ss->_result_queue = _result_queue;
+	ss->max_results = max_results;
+	return ss;
+}
+
 /* ===================== END OF FILE ===================== */
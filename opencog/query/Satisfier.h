@@ -24,6 +24,8 @@
 #ifndef _OPENCOG_SATISFIER_H
 #define _OPENCOG_SATISFIER_H
 
+#include <mutex>
+#include <typeinfo>
 #include <vector>
 
 #include <opencog/atoms/truthvalue/TruthValue.h>
@@ -81,6 +83,10 @@ class Satisfier :
 
 		// Final pass, if no grounding was found.
 		virtual bool search_finished(bool);
+
+		// Subclasses might overload the term callbacks.
+		virtual bool default_term_match(void)
+		{ return typeid(*this) == typeid(Satisfier); }
 };
 
 /**
@@ -100,14 +106,18 @@ class SatisfyingSet :
 {
 	protected:
 		AtomSpace* _as;
-		DECLARE_PE_MUTEX;
 		HandleSeq _varseq;
 		QueueValuePtr _result_queue;
 
+		// Copies made by clone() report to the original, and take
+		// its lock, so that max_results is honored exactly.
+		SatisfyingSet* _primary;
+		std::mutex _gnd_mtx;
+
 	public:
 		SatisfyingSet(AtomSpace* as) :
 			ContinuationMixin(as),
-			_as(as), max_results(SIZE_MAX) {}
+			_as(as), _primary(this), max_results(SIZE_MAX) {}
 
 		size_t max_results;
 
@@ -129,6 +139,11 @@ class SatisfyingSet :
 		virtual bool start_search(void);
 		virtual bool search_finished(bool);
 
+		virtual PatternMatchCallback* clone(void);
+
+		virtual bool default_term_match(void)
+		{ return typeid(*this) == typeid(SatisfyingSet); }
+
 		virtual QueueValuePtr get_result_queue()
 		{ return _result_queue; }
 };
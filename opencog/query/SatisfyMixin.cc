@@ -21,11 +21,16 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <chrono>
+
 #include <opencog/util/oc_assert.h>
 #include <opencog/util/Logger.h>
 
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atoms/core/FindUtils.h>
 
+#include <opencog/query/InitiateSearchMixin.h>
 #include <opencog/query/SatisfyMixin.h>
 #include <opencog/query/PatternMatchEngine.h>
 #include <opencog/query/TermMatchMixin.h>
@@ -40,7 +45,7 @@ using namespace opencog;
 /// used to piece together graphs out of multiple components.
 class PMCGroundings : public SatisfyMixin
 {
-	private:
+	protected:
 		PatternMatchCallback& _cb;
 
 	public:
@@ -99,6 +104,14 @@ class PMCGroundings : public SatisfyMixin
 		{
 			return _cb.get_link(hg, t, std::move(oset));
 		}
+		QueryProfile* get_profile(void)
+		{
+			return _cb.get_profile();
+		}
+		bool default_term_match(void)
+		{
+			return _cb.default_term_match();
+		}
 		void push(void) { _cb.push(); }
 		void pop(void) { _cb.pop(); }
 		void next_connections(const GroundingMap& var_grounding)
@@ -154,54 +167,137 @@ class PMCGroundings : public SatisfyMixin
  * as the total size is the product of the sizes of each of the
  * component.
  *
- * The loop is implemented recursively: The first set is expanded, then
- * the second set, etc. and so we recurse to depth N. Only at this
- * deepest call does a single tuple become available.
+ * The product is streamed: one of the components is not grounded up
+ * front; instead, as each grounding for it is found, it is joined to
+ * the groundings of the other components, and the tuples are handed
+ * to the callback right away. If the callback halts the search (e.g.
+ * because it has as many results as it wanted), then the streamed
+ * component stops being searched, and the rest of the product is
+ * never made. The other components are grounded in full, first; the
+ * pattern engine cannot be paused in the middle of a search, to be
+ * resumed later.
  *
- * During this expansion, filtering is applied. The filters (if any)
- * are called 'virtual links'. The prototypical example is the
+ * During the join, filtering is applied. The filters (if any) are
+ * called 'virtual links'. The prototypical example is the
  * GreaterThanLink. The virtual links return a true/false value, when
- * applied to the tuple (or to the currently-available fragment of the
- * tuple), thus accepting/rejecting that tuple.
- *
- * The virtual links are in 'virtuals', a partial set of groundings
- * are in 'var_gnds' and 'term_gnds', and a collection of possible
- * groundings for disconnected graph components are in 'comp_var_gnds'
- * and 'comp_term_gnds'.
- *
- * The recursion step terminates when comp_var_gnds, comp_term_gnds
- * are empty, at which point the actual unification is done.
- *
- * Return false if no solution is found, true otherwise.
- * (As always, 'false' means 'search some more' and 'true' means 'halt'.
- *
- * XXX FIXME: A major performance optimization is possible, to handle
- * the truly explosive combinatorial case. The optimization is to first
- * locate all of the variables in the virtual clauses, and perform the
- * recursion in the order of these variables. Once all of the variables
- * in a particular virtual clause have been found, that clause can be
- * evaluated on the spot. If it rejects the match, then one does not
- * have to recurse to the bitter end. This basically prunes the search
- * space. (Similar to how SAT solving works).
- *
- * This perf optimization has not been done because basically no one
- * uses the pattern engine to explore large, complex cartesian products
- * in this way.
+ * applied to the tuple, thus accepting/rejecting that tuple. Each is
+ * applied as soon as all of the components it connects are grounded,
+ * so that rejected fragments are not joined to the rest of the
+ * components. To make this happen as early as possible, the components
+ * that the virtual links connect are joined first.
  */
-bool SatisfyMixin::cartesian_product(
-            const HandleSeq& virtuals,
-            const PatternTermSeq& absents,
-            const GroundingMap& var_gnds,
-            const GroundingMap& term_gnds,
-            // copies, NOT references!
-            GroundingMapSeqSeq comp_var_gnds,
-            GroundingMapSeqSeq comp_term_gnds)
+class PMCProduct : public PMCGroundings
 {
-	// If we are done with the recursive step, then we have one of the
-	// many combinatoric possibilities in the var_gnds and term_gnds
-	// maps. Submit this grounding map to the virtual links, and see
-	// what they've got to say about it.
-	if (0 == comp_var_gnds.size())
+	private:
+		const Variables& _vars;
+		const Pattern& _pat;
+		const PatternTermSeq& _absents;
+
+		// The pattern of the streamed component.
+		const Variables* _cvars;
+		const Pattern* _cpat;
+
+		// Groundings of the other components, in join order.
+		GroundingMapSeqSeq _comp_var_gnds;
+		GroundingMapSeqSeq _comp_term_gnds;
+
+		// The virtual links to apply once the component at that
+		// level (the streamed one is at level zero) is joined.
+		HandleSeqSeq _filters;
+		QueryCounts _counts;
+
+	public:
+		PMCProduct(PatternMatchCallback& cb,
+		           const Variables& vars, const Pattern& pat) :
+			PMCGroundings(cb), _vars(vars), _pat(pat),
+			_absents(pat.absents), _cvars(&vars), _cpat(&pat)
+		{}
+		~PMCProduct()
+		{
+			QueryProfile* prof = _cb.get_profile();
+			if (prof) prof->add(_counts);
+		}
+
+		void add_component(GroundingMapSeq&& vgs, GroundingMapSeq&& pgs)
+		{
+			_comp_var_gnds.emplace_back(std::move(vgs));
+			_comp_term_gnds.emplace_back(std::move(pgs));
+		}
+		void set_filters(HandleSeqSeq&& filters)
+		{
+			_filters = std::move(filters);
+		}
+
+		// The start and the end of the search are those of the
+		// product, and not of the streamed component.
+		bool start_search(void) { return false; }
+		bool search_finished(bool done) { return done; }
+
+		void set_pattern(const Variables& vars, const Pattern& pat)
+		{
+			_cvars = &vars;
+			_cpat = &pat;
+			_cb.set_pattern(vars, pat);
+		}
+
+		bool join(size_t, const GroundingMap&, const GroundingMap&);
+
+		// Join each grounding of the streamed component to the rest.
+		// The callbacks expect to see the whole pattern, while the
+		// pattern engine expects to see just the component.
+		bool grounding(const GroundingMap& var_soln,
+		               const GroundingMap& term_soln)
+		{
+			_cb.set_pattern(_vars, _pat);
+			bool halt = join(0, var_soln, term_soln);
+			_cb.set_pattern(*_cvars, *_cpat);
+			return halt;
+		}
+};
+
+/// Apply the filters for level `lvl`, and then join the groundings of
+/// the next component, if any, recursing to the deepest level. Only
+/// at the deepest level does a single tuple become available.
+///
+/// Return false if no solution is found, true otherwise.
+/// (As always, 'false' means 'search some more' and 'true' means 'halt'.
+bool PMCProduct::join(size_t lvl,
+                      const GroundingMap& var_gnds,
+                      const GroundingMap& term_gnds)
+{
+	for (const Handle& virt : _filters[lvl])
+	{
+		// At this time, we expect all virtual links to be in
+		// one of two forms: either EvaluationLink's or
+		// GreaterThanLink's. The EvaluationLinks should have
+		// the structure
+		//
+		//   EvaluationLink
+		//       GroundedPredicateNode "scm:blah"
+		//       ListLink
+		//           Arg1Atom
+		//           Arg2Atom
+		//
+		// The GreaterThanLink's should have the "obvious" structure
+		//
+		//   GreaterThanLink
+		//       Arg1Atom
+		//       Arg2Atom
+		//
+		// In either case, one or more VariableNodes should appear
+		// in the Arg atoms. So, we ground the args, and pass that
+		// to the callback.
+		auto start = std::chrono::steady_clock::now();
+		bool match = _cb.evaluate_sentence(virt, var_gnds);
+		std::chrono::duration<double> secs =
+			std::chrono::steady_clock::now() - start;
+		_counts.evaluations++;
+		_counts.eval_seconds += secs.count();
+
+		if (not match) return false;
+	}
+
+	if (_comp_var_gnds.size() == lvl)
 	{
 #ifdef QDEBUG
 		if (logger().is_fine_enabled())
@@ -212,87 +308,33 @@ bool SatisfyMixin::cartesian_product(
 			PatternMatchEngine::log_solution(var_gnds, term_gnds);
 		}
 #endif
-
-		// Note, FYI, that if there are no virtual clauses at all,
-		// then this loop falls straight-through, and the grounding
-		// is reported as a match to the callback.  That is, the
-		// virtuals only serve to reject possibilities.
-		for (const Handle& virt : virtuals)
-		{
-			// At this time, we expect all virtual links to be in
-			// one of two forms: either EvaluationLink's or
-			// GreaterThanLink's. The EvaluationLinks should have
-			// the structure
-			//
-			//   EvaluationLink
-			//       GroundedPredicateNode "scm:blah"
-			//       ListLink
-			//           Arg1Atom
-			//           Arg2Atom
-			//
-			// The GreaterThanLink's should have the "obvious" structure
-			//
-			//   GreaterThanLink
-			//       Arg1Atom
-			//       Arg2Atom
-			//
-			// In either case, one or more VariableNodes should appear
-			// in the Arg atoms. So, we ground the args, and pass that
-			// to the callback.
-
-			bool match = evaluate_sentence(virt, var_gnds);
-
-			if (not match) return false;
-		}
-
 		Handle empty;
-		for (const PatternTermPtr& opt: absents)
+		for (const PatternTermPtr& opt: _absents)
 		{
-			bool match = optional_clause_match(opt->getHandle(), empty, var_gnds);
+			bool match = _cb.optional_clause_match(opt->getHandle(),
+			                                       empty, var_gnds);
 			if (not match) return false;
 		}
 
 		// Yay! We found one! We now have a fully and completely grounded
 		// pattern! See what the callback thinks of it.
-		return grounding(var_gnds, term_gnds);
+		return _cb.grounding(var_gnds, term_gnds);
 	}
-#ifdef QDEBUG
-	LAZY_LOG_FINE << "Component recursion: num comp=" << comp_var_gnds.size();
-#endif
-
-	// Recurse over all components. If component k has N_k groundings,
-	// and there are m components, then we have to explore all
-	// N_0 * N_1 * N_2 * ... N_m possible combinations of groundings.
-	// We do this recursively, by popping N_m off the back, and calling
-	// ourselves.
-	//
-	// vg and vp will be the collection of all of the different possible
-	// groundings for one of the components (well, its for component m,
-	// in the above notation.) So the loop below tries every possibility.
-	GroundingMapSeq vg = comp_var_gnds.back();
-	comp_var_gnds.pop_back();
-	GroundingMapSeq pg = comp_term_gnds.back();
-	comp_term_gnds.pop_back();
 
+	// Given a set of groundings, tack on those for the next component,
+	// and recurse. We need to make a copy, of course.
+	const GroundingMapSeq& vg = _comp_var_gnds[lvl];
+	const GroundingMapSeq& pg = _comp_term_gnds[lvl];
 	size_t ngnds = vg.size();
 	for (size_t i=0; i<ngnds; i++)
 	{
-		// Given a set of groundings, tack on those for this component,
-		// and recurse, with one less component. We need to make a copy,
-		// of course.
 		GroundingMap rvg(var_gnds);
 		GroundingMap rpg(term_gnds);
-
-		const GroundingMap& cand_vg(vg[i]);
-		const GroundingMap& cand_pg(pg[i]);
-		rvg.insert(cand_vg.begin(), cand_vg.end());
-		rpg.insert(cand_pg.begin(), cand_pg.end());
-
-		bool accept = cartesian_product(virtuals, absents, rvg, rpg,
-		                                comp_var_gnds, comp_term_gnds);
+		rvg.insert(vg[i].begin(), vg[i].end());
+		rpg.insert(pg[i].begin(), pg[i].end());
 
 		// Halt recursion immediately if match is accepted.
-		if (accept) return true;
+		if (join(lvl+1, rvg, rpg)) return true;
 	}
 	return false;
 }
@@ -405,16 +447,15 @@ bool SatisfyMixin::satisfy(const PatternLinkPtr& form)
 	//    the product is necessarily the empty set (and so halts further
 	//    search.) A (combinatorially explosive!) loop will then loop
 	//    over the product, passing each combination to the rewrite
-	//    mixin. (The URE typically assembles some deduction in that
-	//    final rewrite.)
+	//    mixin, as soon as it is found. (The URE typically assembles
+	//    some deduction in that final rewrite.)
 	// 3) Virtual clauses. This is a special case of the Cartesian
 	//    product. Some clauses, such as GreaterThanLink, when removed,
 	//    result in a graph with multiple disconnected components. In
-	//    this case, the Cartesian product is constructed and then the
-	//    elements of the product are passed through the virtual links,
-	//    which produce true/false values which are used to keep/discard
-	//    that particular product. Basically, its just a filter on the
-	//    Cartesian product.
+	//    this case, the virtual links are filters on the product: they
+	//    produce true/false values which are used to keep/discard each
+	//    partial product, as soon as it has all of the groundings that
+	//    they need.
 	//
 	// And so, we start grounding the components.
 
@@ -440,66 +481,62 @@ bool SatisfyMixin::satisfy(const PatternLinkPtr& form)
 
 	Type patty = pat.body->get_type();
 	bool have_orlink = (OR_LINK == patty) or (CHOICE_LINK == patty);
-	GroundingMapSeqSeq comp_term_gnds;
-	GroundingMapSeqSeq comp_var_gnds;
 	const HandleSeq& comp_patterns = jit->get_component_patterns();
 
+	// Disconnected pure absents are checked first; the others are
+	// joined below.
+	std::vector<PatternLinkPtr> joined;
 	for (size_t i = 0; i < num_comps; i++)
 	{
-#ifdef QDEBUG
-		LAZY_LOG_FINE << "BEGIN COMPONENT GROUNDING " << i+1
-		              << " of " << num_comps << ": ===========\n";
-#endif
-
 		PatternLinkPtr clp(PatternLinkCast(comp_patterns.at(i)));
 		const Pattern& pat(clp->get_pattern());
-		bool is_pure_absent = false;
-		if (pat.pmandatory.size() == 0 and pat.absents.size() > 0)
-			is_pure_absent = true;
-
-		// Pass through the callbacks, collect up answers.
-		PMCGroundings gcb(*this);
-		gcb.satisfy(clp);
-
-		// Special handling for disconnected pure absents --
-		// Returns false to end the search if this disconnected
-		// pure absent is found.
-		if (is_pure_absent)
+		if (0 < pat.pmandatory.size() or 0 == pat.absents.size())
 		{
-			// XXX FIXME terrible hack.
-			TermMatchMixin* intu =
-				dynamic_cast<TermMatchMixin*>(this);
-			if (intu->optionals_present()) return false;
+			joined.push_back(clp);
+			continue;
 		}
-		else
-		{
+
 #ifdef QDEBUG
-			logger().fine("Found %lu groundings for component %lu",
-				gcb._term_groundings.size(), i+1);
+		LAZY_LOG_FINE << "BEGIN PURE ABSENT COMPONENT " << i+1
+		              << " of " << num_comps << ": ===========\n";
 #endif
-			if (not have_orlink and gcb._term_groundings.empty())
-				return false;
+		// Special handling for disconnected pure absents --
+		// Returns false to end the search if this disconnected
+		// pure absent is found.
+		PMCGroundings gcb(*this);
+		gcb.satisfy(clp);
 
-			comp_var_gnds.push_back(gcb._var_groundings);
-			comp_term_gnds.push_back(gcb._term_groundings);
-		}
+		// XXX FIXME terrible hack.
+		TermMatchMixin* intu =
+			dynamic_cast<TermMatchMixin*>(this);
+		if (intu->optionals_present()) return false;
 	}
 
-	// The pattern was clobbered by the individual component searches.
-	// We need to reset it.
-	set_pattern(vars, pat);
-
 	// ---------------------------------------------------
-	// OK we've grounded all the components.
-	// Now its time to reassemble them.
 	// In the case of OrLink, the final result is just the set-union
 	// of the groundings delivered by the individual components.
 	if (have_orlink)
 	{
 		OC_ASSERT(0 == virts.size(), "Not expecting virtuals here!");
+
+		// Pass through the callbacks, collect up answers.
+		GroundingMapSeqSeq comp_term_gnds;
+		GroundingMapSeqSeq comp_var_gnds;
+		for (const PatternLinkPtr& clp : joined)
+		{
+			PMCGroundings gcb(*this);
+			gcb.satisfy(clp);
+			comp_var_gnds.push_back(gcb._var_groundings);
+			comp_term_gnds.push_back(gcb._term_groundings);
+		}
+
+		// The pattern was clobbered by the individual component
+		// searches. We need to reset it.
+		set_pattern(vars, pat);
+
 		bool done = start_search();
 		if (done) return done;
-		for (size_t i = 0; i < num_comps; i++)
+		for (size_t i = 0; i < comp_var_gnds.size(); i++)
 		{
 			for (size_t j = 0; j < comp_var_gnds[i].size(); j++)
 			{
@@ -512,21 +549,95 @@ bool SatisfyMixin::satisfy(const PatternLinkPtr& form)
 
 	// ---------------------------------------------------
 	// If we are here, we have to deal with the Cartesian product.
-	// Loop over everything in that product, and filter it through
-	// the virtual clauses (if any).
+	// Join the components connected by virtual clauses first, and
+	// apply each virtual clause right after the last of the components
+	// that it connects.
+	auto touches = [](const PatternLinkPtr& clp, const Handle& virt) {
+		return any_unquoted_unscoped_in_tree(virt,
+			clp->get_variables().varset);
+	};
+	std::stable_partition(joined.begin(), joined.end(),
+		[&](const PatternLinkPtr& clp) {
+			for (const Handle& virt : virts)
+				if (touches(clp, virt)) return true;
+			return false;
+		});
+
+	// The first component is streamed; all of the others are held in
+	// memory. Stream the one expected to have the most groundings, so
+	// as to hold as few as possible. The filters are placed after the
+	// order is final, and so are still applied as early as possible.
+	InitiateSearchMixin* ism = dynamic_cast<InitiateSearchMixin*>(this);
+	if (ism and 1 < joined.size())
+	{
+		size_t most = 0;
+		double most_gnds = -1.0;
+		for (size_t k = 0; k < joined.size(); k++)
+		{
+			double gnds = ism->expected_groundings(
+				joined[k]->get_variables(), joined[k]->get_pattern());
+			if (most_gnds < gnds)
+			{
+				most = k;
+				most_gnds = gnds;
+			}
+		}
+		std::rotate(joined.begin(), joined.begin() + most,
+		            joined.begin() + most + 1);
+	}
+
+	HandleSeqSeq filters(std::max((size_t) 1, joined.size()));
+	for (const Handle& virt : virts)
+	{
+		size_t lvl = 0;
+		for (size_t k = 0; k < joined.size(); k++)
+			if (touches(joined[k], virt)) lvl = k;
+		filters[lvl].push_back(virt);
+	}
+
+	PMCProduct pcb(*this, vars, pat);
+	pcb.set_filters(std::move(filters));
+
+	// All but the first component are grounded in full. If there are
+	// zero groundings in any of them, then the product is necessarily
+	// empty.
+	for (size_t k = 1; k < joined.size(); k++)
+	{
 #ifdef QDEBUG
-	LAZY_LOG_FINE << "BEGIN cartesian recursion on virtual clausess:"
+		LAZY_LOG_FINE << "BEGIN COMPONENT GROUNDING " << k+1
+		              << " of " << joined.size() << ": ===========\n";
+#endif
+		PMCGroundings gcb(*this);
+		gcb.satisfy(joined[k]);
+
+#ifdef QDEBUG
+		logger().fine("Found %lu groundings for component %lu",
+			gcb._term_groundings.size(), k+1);
+#endif
+		if (gcb._term_groundings.empty()) return false;
+		pcb.add_component(std::move(gcb._var_groundings),
+		                  std::move(gcb._term_groundings));
+	}
+
+	// The pattern was clobbered by the individual component searches.
+	// We need to reset it.
+	set_pattern(vars, pat);
+
+	// The first component is streamed into the join.
+#ifdef QDEBUG
+	LAZY_LOG_FINE << "BEGIN streaming cartesian product:"
 	              << " ==========="
-	              << " num comp=" << comp_var_gnds.size()
+	              << " num comp=" << joined.size()
 	              << " num virts=" << num_virts;
 #endif
-	GroundingMap empty_vg;
-	GroundingMap empty_pg;
 	bool done = start_search();
 	if (done) return done;
-	done = cartesian_product(virts, pat.absents,
-	                         empty_vg, empty_pg,
-	                         comp_var_gnds, comp_term_gnds);
+	if (joined.empty())
+		done = pcb.join(0, GroundingMap(), GroundingMap());
+	else
+		done = pcb.satisfy(joined[0]);
+
+	set_pattern(vars, pat);
 	done = search_finished(done);
 	return done;
 }
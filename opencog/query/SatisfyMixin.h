@@ -31,16 +31,15 @@ namespace opencog {
 class SatisfyMixin:
 	public virtual PatternMatchCallback
 {
-	bool cartesian_product(const HandleSeq& virtuals,
-	                       const PatternTermSeq& absents,
-	                       const GroundingMap& var_gnds,
-	                       const GroundingMap& term_gnds,
-	                       // copies, NOT references!
-	                       GroundingMapSeqSeq comp_var_gnds,
-	                       GroundingMapSeqSeq comp_term_gnds);
+	protected:
+		QueryProfilePtr _profile = std::make_shared<QueryProfile>();
 
 	public:
 		virtual bool satisfy(const PatternLinkPtr&);
+
+		/// Counts for all of the searches run by `satisfy()` so far.
+		virtual QueryProfile* get_profile(void) { return _profile.get(); }
+		const QueryProfilePtr& get_profile_ptr(void) const { return _profile; }
 };
 
 }; // namespace opencog
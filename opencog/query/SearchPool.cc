@@ -0,0 +1,256 @@
+/*
+ * opencog/query/SearchPool.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <exception>
+
+#include "SearchPool.h"
+
+using namespace opencog;
+
+// ====================================================================
+
+/// Set while the current thread is inside of a call made by `run()`.
+static thread_local bool in_pool_search = false;
+
+/// The range of indexes still to be done by one participant. The
+/// owner takes from the front; thieves take from the back.
+struct Range
+{
+	std::mutex mtx;
+	size_t lo;
+	size_t hi;
+};
+
+struct SearchPool::Job
+{
+	const std::function<bool(size_t, size_t)>& fn;
+	size_t nparts;
+	std::unique_ptr<Range[]> ranges;
+
+	std::atomic<bool> stop;
+	std::atomic<bool> found;
+	std::exception_ptr error;
+
+	// Participants join under the lock; the caller closes the job
+	// under the lock, so that nothing joins after it has returned.
+	std::mutex mtx;
+	std::condition_variable done;
+	size_t joined;
+	size_t active;
+	bool closed;
+
+	Job(const std::function<bool(size_t, size_t)>& f,
+	    size_t nitems, size_t np) :
+		fn(f), nparts(np), ranges(new Range[np]),
+		stop(false), found(false), joined(1), active(0), closed(false)
+	{
+		for (size_t p = 0; p < np; p++)
+		{
+			ranges[p].lo = (p * nitems) / np;
+			ranges[p].hi = ((p+1) * nitems) / np;
+		}
+	}
+
+	bool take(size_t part, size_t& idx)
+	{
+		Range& r = ranges[part];
+		std::lock_guard<std::mutex> lck(r.mtx);
+		if (r.hi <= r.lo) return false;
+		idx = r.lo++;
+		return true;
+	}
+
+	bool steal(size_t part, size_t& idx)
+	{
+		for (size_t k = 1; k < nparts; k++)
+		{
+			size_t lo, hi;
+			{
+				Range& v = ranges[(part + k) % nparts];
+				std::lock_guard<std::mutex> lck(v.mtx);
+				if (v.hi <= v.lo) continue;
+
+				// Take the back half, rounded up.
+				hi = v.hi;
+				lo = v.hi - (v.hi - v.lo + 1) / 2;
+				v.hi = lo;
+			}
+			idx = lo;
+			if (lo + 1 < hi)
+			{
+				Range& r = ranges[part];
+				std::lock_guard<std::mutex> lck(r.mtx);
+				r.lo = lo + 1;
+				r.hi = hi;
+			}
+			return true;
+		}
+		return false;
+	}
+};
+
+// ====================================================================
+
+SearchPool::SearchPool(void) :
+	_generation(0), _stopping(false)
+{
+}
+
+SearchPool::~SearchPool()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stopping = true;
+	}
+	_cv.notify_all();
+	for (std::thread& t : _workers)
+		t.join();
+}
+
+SearchPool& SearchPool::instance(void)
+{
+	static SearchPool pool;
+	return pool;
+}
+
+size_t SearchPool::concurrency(void) const
+{
+	size_t ncpu = std::thread::hardware_concurrency();
+	return (0 == ncpu) ? 1 : ncpu;
+}
+
+bool SearchPool::in_search(void)
+{
+	return in_pool_search;
+}
+
+/// Start the workers, if they have not been started already.
+/// Must be called with the lock held.
+void SearchPool::start(void)
+{
+	if (not _workers.empty()) return;
+	size_t nw = concurrency() - 1;
+	for (size_t i = 0; i < nw; i++)
+		_workers.emplace_back(&SearchPool::worker_loop, this);
+}
+
+// ====================================================================
+
+/// Do the work of one participant: first its own range, then
+/// whatever can be stolen from the others.
+void SearchPool::work(Job& job, size_t part)
+{
+	in_pool_search = true;
+	size_t idx;
+	while (not job.stop and
+	       (job.take(part, idx) or job.steal(part, idx)))
+	{
+		try
+		{
+			if (job.fn(part, idx))
+			{
+				job.found = true;
+				job.stop = true;
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lck(job.mtx);
+			if (nullptr == job.error)
+				job.error = std::current_exception();
+			job.stop = true;
+		}
+	}
+	in_pool_search = false;
+}
+
+void SearchPool::worker_loop(void)
+{
+	size_t seen = 0;
+	while (true)
+	{
+		std::shared_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lck(_mtx);
+			_cv.wait(lck, [&]{ return _stopping or seen != _generation; });
+			if (_stopping) return;
+			seen = _generation;
+			job = _job;
+		}
+		if (nullptr == job) continue;
+
+		size_t part;
+		{
+			std::lock_guard<std::mutex> lck(job->mtx);
+			if (job->closed or job->nparts <= job->joined) continue;
+			part = job->joined++;
+			job->active++;
+		}
+
+		work(*job, part);
+
+		std::lock_guard<std::mutex> lck(job->mtx);
+		if (0 == --job->active) job->done.notify_all();
+	}
+}
+
+// ====================================================================
+
+bool SearchPool::run(size_t nitems, size_t nparts,
+                     const std::function<bool(size_t, size_t)>& fn)
+{
+	if (nparts < 1) nparts = 1;
+	std::shared_ptr<Job> job(std::make_shared<Job>(fn, nitems, nparts));
+
+	// Post the job. If another search posts its own job before the
+	// workers get to this one, that's OK; the caller does the rest.
+	if (1 < nparts)
+	{
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			start();
+			_job = job;
+			_generation++;
+		}
+		_cv.notify_all();
+	}
+
+	work(*job, 0);
+
+	// Wait for the workers that joined, as `fn` belongs to the caller.
+	{
+		std::unique_lock<std::mutex> lck(job->mtx);
+		job->closed = true;
+		job->done.wait(lck, [&]{ return 0 == job->active; });
+	}
+
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (_job == job) _job = nullptr;
+	}
+
+	if (job->error) std::rethrow_exception(job->error);
+	return job->found;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,94 @@
+/*
+ * opencog/query/SearchPool.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SEARCH_POOL_H
+#define _OPENCOG_SEARCH_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opencog {
+
+/**
+ * A persistent pool of worker threads, for running the outer loop of
+ * large pattern searches in parallel.
+ *
+ * The threads are started once, the first time that they are needed,
+ * and then sleep until there is work. Starting threads for each search
+ * is far too expensive: it made small searches 25x-33x slower.
+ *
+ * Work is handed out as ranges of indexes. Each participant starts
+ * with an equal share; when it runs out, it steals half of what is
+ * left from some other participant. The calling thread always takes
+ * part, so the work gets done even if all of the workers are busy
+ * with some other search; and so searches can be run from several
+ * threads at once.
+ */
+class SearchPool
+{
+	struct Job;
+
+	std::mutex _mtx;
+	std::condition_variable _cv;
+	std::vector<std::thread> _workers;
+	std::shared_ptr<Job> _job;
+	size_t _generation;
+	bool _stopping;
+
+	void start(void);
+	void worker_loop(void);
+	static void work(Job&, size_t);
+
+	SearchPool(void);
+public:
+	~SearchPool();
+
+	static SearchPool& instance(void);
+
+	/// The number of threads that can take part in a search,
+	/// counting the calling thread.
+	size_t concurrency(void) const;
+
+	/// Call `fn(part, i)` for every `i` in `[0, nitems)`, using up to
+	/// `nparts` threads, the calling thread included. `part` is a
+	/// number in `[0, nparts)` that is different for each thread
+	/// taking part; the calling thread is always part zero.
+	///
+	/// Once any call returns true, no more calls are started, and
+	/// true is returned. If a call throws, no more calls are started,
+	/// and the exception is rethrown here, in the calling thread.
+	bool run(size_t nitems, size_t nparts,
+	         const std::function<bool(size_t, size_t)>& fn);
+
+	/// Return true if the current thread is running a call made
+	/// by `run()`. Searches started from within a search should not
+	/// go parallel again.
+	static bool in_search(void);
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_SEARCH_POOL_H
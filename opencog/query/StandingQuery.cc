@@ -0,0 +1,437 @@
+/*
+ * opencog/query/StandingQuery.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <functional>
+
+#include <opencog/util/Logger.h>
+#include <opencog/atoms/pattern/QueryLink.h>
+#include <opencog/atoms/value/LinkValue.h>
+
+#include "DeltaSearch.h"
+#include "Implicator.h"
+#include "Satisfier.h"
+#include "StandingQuery.h"
+
+namespace opencog
+{
+
+// Callback for standing MeetLinks. The groundings are recorded with
+// the StandingQuery, and not in a queue of their own.
+class StandingSatisfyingSet : public SatisfyingSet
+{
+		StandingQuery* _sq;
+	public:
+		StandingSatisfyingSet(StandingQuery* sq, AtomSpace* as) :
+			SatisfyingSet(as), _sq(sq) {}
+		virtual ~StandingSatisfyingSet() {}
+		virtual bool grounding(const GroundingMap&, const GroundingMap&);
+
+		// The StandingQuery is not locked; search in one thread only.
+		virtual PatternMatchCallback* clone(void) { return nullptr; }
+		virtual bool default_term_match(void) { return true; }
+};
+
+// Callback for standing QueryLinks.
+class StandingImplicator : public Implicator
+{
+		StandingQuery* _sq;
+	public:
+		StandingImplicator(StandingQuery* sq, AtomSpace* as) :
+			Implicator(as), _sq(sq) {}
+		virtual ~StandingImplicator() {}
+		virtual bool grounding(const GroundingMap&, const GroundingMap&);
+		virtual bool default_term_match(void) { return true; }
+};
+
+} // namespace opencog
+
+using namespace opencog;
+
+std::mutex StandingQuery::_reg_mtx;
+std::map<Handle, StandingQueryPtr> StandingQuery::_registry;
+
+// ====================================================================
+
+bool StandingSatisfyingSet::grounding(const GroundingMap& var_soln,
+                                      const GroundingMap& term_soln)
+{
+	HandleSeq key(_sq->key_of(var_soln));
+	if (_sq->have(key)) return false;
+
+	// Same as the results of the SatisfyingSet.
+	ValueSeq vals;
+	if (1 == key.size())
+		vals.emplace_back(key[0]);
+	else
+		vals.emplace_back(createLinkValue(ValueSeq(key.begin(), key.end())));
+
+	_sq->record(std::move(key), term_soln, std::move(vals));
+	return false;
+}
+
+bool StandingImplicator::grounding(const GroundingMap& var_soln,
+                                   const GroundingMap& term_soln)
+{
+	HandleSeq key(_sq->key_of(var_soln));
+	if (_sq->have(key)) return false;
+
+	// Same as the results of the RewriteMixin.
+	ValueSeq vals;
+	try {
+		for (const Handle& himp: implicand)
+		{
+			ValuePtr v(inst.instantiate(himp, var_soln, true));
+			if (nullptr == v) continue;
+			if (v->is_atom())
+				v = RewriteMixin::_as->add_atom(HandleCast(v));
+			vals.emplace_back(v);
+		}
+	} catch (const SilentException& ex) {}
+
+	_sq->record(std::move(key), term_soln, std::move(vals));
+	return false;
+}
+
+// ====================================================================
+
+StandingQuery::StandingQuery(const Handle& query) :
+	_query(query), _stop(false), _busy(true), _orphan(false)
+{
+	Type qt = query->get_type();
+	_plp = PatternLinkCast(query);
+	if (nullptr == _plp or not (nameserver().isA(qt, MEET_LINK) or
+	                            nameserver().isA(qt, QUERY_LINK)))
+		throw SyntaxException(TRACE_INFO,
+			"Expecting a MeetLink or QueryLink, got %s",
+			query->to_short_string().c_str());
+
+	if (not delta_searchable(_plp, _types))
+		throw RuntimeException(TRACE_INFO,
+			"Cannot keep the results of this query current: %s",
+			query->to_short_string().c_str());
+
+	// Searching needs the AtomSpace, but it is not held on to; a
+	// weak pointer tells if it is still there.
+	AtomSpace* as = query->getAtomSpace();
+	if (nullptr == as or as->weak_from_this().expired())
+		throw RuntimeException(TRACE_INFO,
+			"The query must be in an AtomSpace held by a smart pointer");
+	AtomSpacePtr asp(AtomSpaceCast(as));
+	_as = asp;
+
+	_varseq = _plp->get_variables().varseq;
+	_results = createQueueValue();
+	_retracted = createQueueValue();
+
+	// Listen first, so that nothing added during the first search
+	// is missed. Anything found twice is skipped.
+	_add_sig = asp->atomAddedSignal().connect(
+		std::bind(&StandingQuery::added, this, std::placeholders::_1));
+	_rem_sig = asp->atomRemovedSignal().connect(
+		std::bind(&StandingQuery::removed, this, std::placeholders::_1));
+
+	_worker = std::thread(&StandingQuery::run, this);
+}
+
+StandingQuery::~StandingQuery()
+{
+	stop();
+}
+
+/// The signal handlers take `_mtx`, while the signal holds its own
+/// lock; thus, `_mtx` must not be held while disconnecting. If the
+/// AtomSpace is gone, so are its signals.
+void StandingQuery::stop(void)
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (_stop) return;
+		_stop = true;
+	}
+	AtomSpacePtr as(_as.lock());
+	if (as)
+	{
+		as->atomAddedSignal().disconnect(_add_sig);
+		as->atomRemovedSignal().disconnect(_rem_sig);
+	}
+
+	_cv.notify_all();
+	_worker.join();
+
+	_results->close();
+	_retracted->close();
+}
+
+void StandingQuery::drain(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	_cv.wait(lck, [this] {
+		return _stop or _orphan or
+			(not _busy and _added.empty() and _removed.empty());
+	});
+}
+
+bool StandingQuery::orphaned(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _orphan or _as.expired();
+}
+
+// ====================================================================
+// Signal handlers. These are called from within AtomSpace::add() and
+// AtomSpace::extract(); they must not touch the AtomSpace.
+
+void StandingQuery::added(const Handle& h)
+{
+	if (0 == _types.count(h->get_type())) return;
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_added.push_back(h);
+	_cv.notify_all();
+}
+
+void StandingQuery::removed(const Handle& h)
+{
+	if (h == _query)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_orphan = true;
+		_cv.notify_all();
+		return;
+	}
+	if (0 == _types.count(h->get_type())) return;
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_removed.push_back(h);
+	_cv.notify_all();
+}
+
+// ====================================================================
+
+/// The worker thread: run the query, and then keep it current.
+void StandingQuery::run(void)
+{
+	search(nullptr);
+
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (true)
+	{
+		_busy = false;
+		_cv.notify_all();
+		_cv.wait(lck, [this] {
+			return _stop or _orphan or
+				not _added.empty() or not _removed.empty();
+		});
+		if (_stop or _orphan) break;
+
+		HandleSeq added, removed;
+		added.swap(_added);
+		removed.swap(_removed);
+		_busy = true;
+		lck.unlock();
+
+		// Removals first; an Atom might have been added, and then
+		// removed again, before we got to it.
+		retract(removed);
+
+		HandleSeq live;
+		for (const Handle& h : added)
+			if (h->getAtomSpace()) live.push_back(h);
+		if (0 < live.size()) search(&live);
+
+		lck.lock();
+	}
+}
+
+/// Search for new groundings; all of them if `added` is null, else
+/// only those that ground some clause with one of the `added` Atoms.
+void StandingQuery::search(const HandleSeq* added)
+{
+	AtomSpacePtr as(_as.lock());
+	if (nullptr == as) return;
+
+	try
+	{
+		if (nameserver().isA(_query->get_type(), QUERY_LINK))
+		{
+			const HandleSeq& imp(QueryLinkCast(_query)->get_implicand());
+			if (added)
+			{
+				DeltaSearch<StandingImplicator> impl(*added, this, as.get());
+				impl.implicand = imp;
+				impl.satisfy(_plp);
+			}
+			else
+			{
+				StandingImplicator impl(this, as.get());
+				impl.implicand = imp;
+				impl.satisfy(_plp);
+			}
+			return;
+		}
+
+		if (added)
+		{
+			DeltaSearch<StandingSatisfyingSet> sater(*added, this, as.get());
+			sater.satisfy(_plp);
+		}
+		else
+		{
+			StandingSatisfyingSet sater(this, as.get());
+			sater.satisfy(_plp);
+		}
+	}
+	catch (const std::exception& ex)
+	{
+		// There is no one to report this to; keep going.
+		logger().warn("StandingQuery: search failed: %s", ex.what());
+	}
+}
+
+// ====================================================================
+
+HandleSeq StandingQuery::key_of(const GroundingMap& var_soln) const
+{
+	HandleSeq key;
+	for (const Handle& hv : _varseq)
+	{
+		auto it = var_soln.find(hv);
+		key.push_back(var_soln.end() == it ? hv : it->second);
+	}
+	return key;
+}
+
+void StandingQuery::record(HandleSeq&& key, const GroundingMap& term_soln,
+                           ValueSeq&& values)
+{
+	Found& fnd = _found[key];
+	for (const auto& pr : term_soln)
+	{
+		fnd.support.push_back(pr.second);
+		_support[pr.second].insert(key);
+	}
+
+	fnd.values = std::move(values);
+	for (const ValuePtr& v : fnd.values)
+		deliver(v);
+}
+
+void StandingQuery::retract(const HandleSeq& removed)
+{
+	for (const Handle& h : removed)
+	{
+		auto sit = _support.find(h);
+		if (_support.end() == sit) continue;
+
+		std::set<HandleSeq> keys;
+		keys.swap(sit->second);
+		_support.erase(sit);
+
+		for (const HandleSeq& key : keys)
+		{
+			auto fit = _found.find(key);
+			if (_found.end() == fit) continue;
+
+			// Forget the other Atoms supporting this, too.
+			for (const Handle& sup : fit->second.support)
+			{
+				auto oit = _support.find(sup);
+				if (_support.end() == oit) continue;
+				oit->second.erase(key);
+				if (oit->second.empty()) _support.erase(oit);
+			}
+
+			for (const ValuePtr& v : fit->second.values)
+				withdraw(v);
+			_found.erase(fit);
+		}
+	}
+}
+
+void StandingQuery::deliver(const ValuePtr& v)
+{
+	if (v->is_atom() and 1 < ++_refs[HandleCast(v)]) return;
+	_results->push(v);
+}
+
+void StandingQuery::withdraw(const ValuePtr& v)
+{
+	if (v->is_atom())
+	{
+		auto it = _refs.find(HandleCast(v));
+		if (_refs.end() == it) return;
+		if (0 < --it->second) return;
+		_refs.erase(it);
+	}
+	_retracted->push(v);
+}
+
+// ====================================================================
+
+/// Stop the queries whose AtomSpace is gone, or that were removed
+/// from it, and forget them.
+void StandingQuery::sweep(void)
+{
+	std::vector<StandingQueryPtr> dead;
+	{
+		std::lock_guard<std::mutex> lck(_reg_mtx);
+		for (auto it = _registry.begin(); it != _registry.end(); )
+		{
+			if (it->second->orphaned())
+			{
+				dead.push_back(it->second);
+				it = _registry.erase(it);
+			}
+			else it++;
+		}
+	}
+	for (const StandingQueryPtr& sq : dead)
+		sq->stop();
+}
+
+StandingQueryPtr StandingQuery::start(const Handle& query)
+{
+	sweep();
+	std::lock_guard<std::mutex> lck(_reg_mtx);
+	auto it = _registry.find(query);
+	if (_registry.end() != it) return it->second;
+
+	StandingQueryPtr sq(std::make_shared<StandingQuery>(query));
+	_registry.emplace(query, sq);
+	return sq;
+}
+
+void StandingQuery::cancel(const Handle& query)
+{
+	sweep();
+	StandingQueryPtr sq;
+	{
+		std::lock_guard<std::mutex> lck(_reg_mtx);
+		auto it = _registry.find(query);
+		if (_registry.end() == it) return;
+		sq = it->second;
+		_registry.erase(it);
+	}
+	sq->stop();
+}
+
+/* ===================== END OF FILE ===================== */
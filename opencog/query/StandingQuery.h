@@ -0,0 +1,159 @@
+/*
+ * opencog/query/StandingQuery.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_STANDING_QUERY_H
+#define _OPENCOG_STANDING_QUERY_H
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+#include <opencog/atoms/atom_types/types.h>
+#include <opencog/atoms/pattern/PatternLink.h>
+#include <opencog/atoms/value/QueueValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog {
+
+class StandingQuery;
+typedef std::shared_ptr<StandingQuery> StandingQueryPtr;
+
+/**
+ * A query that stays registered, and keeps its results current as
+ * Atoms are added to, and removed from, the AtomSpace.
+ *
+ * The query is run once, in full, when it is started. After that,
+ * the AtomSpace add and remove signals are used to note the Atoms
+ * that can change the results, and a worker thread brings the
+ * results up to date:
+ *
+ * -- New groundings are found by a DeltaSearch, starting from just
+ *    the added Atoms that can ground a clause. The other clauses are
+ *    joined to these, on the shared variables, through the incoming
+ *    sets of the AtomSpace. Thus, the work done is in proportion to
+ *    the changes, and not the size of the AtomSpace. The results are
+ *    pushed onto the `results` queue, as they are found: for a
+ *    MeetLink, these are the groundings; for a QueryLink, the
+ *    rewrites.
+ *
+ * -- Each result is remembered together with the Atoms grounding its
+ *    clauses. When one of these is removed, the results that it
+ *    supported are pushed onto the `retracted` queue.
+ *
+ * Only queries that are delta_searchable() can be kept current this
+ * way; others are rejected. The signal handlers only record the
+ * changes; they never search, as the searches (and the rewrites, for
+ * QueryLinks) add Atoms to the AtomSpace.
+ *
+ * A StandingQuery does not hold on to the AtomSpace. If the AtomSpace
+ * goes away, or the query is removed from it, the query stops keeping
+ * its results current; it is stopped, and its queues closed, by the
+ * next `start()` or `cancel()`.
+ */
+class StandingQuery
+{
+	Handle _query;
+	PatternLinkPtr _plp;
+	std::weak_ptr<AtomSpace> _as;
+	TypeSet _types;
+	HandleSeq _varseq;
+
+	QueueValuePtr _results;
+	QueueValuePtr _retracted;
+
+	// Changes not yet processed, handed over from the signal handlers.
+	std::mutex _mtx;
+	std::condition_variable _cv;
+	HandleSeq _added;
+	HandleSeq _removed;
+	bool _stop;
+	bool _busy;
+	bool _orphan;       // The query was removed from the AtomSpace.
+
+	int _add_sig;
+	int _rem_sig;
+	std::thread _worker;
+
+	// The results found so far, by grounding, and the Atoms that
+	// support them. Touched only by the worker thread.
+	struct Found
+	{
+		ValueSeq values;
+		HandleSeq support;
+	};
+	std::map<HandleSeq, Found> _found;
+	std::unordered_map<Handle, std::set<HandleSeq>> _support;
+
+	// Atoms are delivered once, no matter how many groundings
+	// result in them, and retracted when the last of these goes.
+	std::unordered_map<Handle, size_t> _refs;
+	void deliver(const ValuePtr&);
+	void withdraw(const ValuePtr&);
+
+	void added(const Handle&);
+	void removed(const Handle&);
+	void run(void);
+	void search(const HandleSeq*);
+	void retract(const HandleSeq&);
+
+	bool orphaned(void);
+
+	static std::mutex _reg_mtx;
+	static std::map<Handle, StandingQueryPtr> _registry;
+	static void sweep(void);
+
+public:
+	StandingQuery(const Handle& query);
+	~StandingQuery();
+
+	/// Stop following changes. The results queue is closed.
+	void stop(void);
+
+	/// Wait until all of the changes made so far have been processed.
+	void drain(void);
+
+	QueueValuePtr get_results(void) const { return _results; }
+	QueueValuePtr get_retracted(void) const { return _retracted; }
+
+	/// Used by the search callbacks, for each grounding found. The
+	/// grounding of the variables, in order, is the key; results are
+	/// made and recorded only for new keys.
+	HandleSeq key_of(const GroundingMap& var_soln) const;
+	bool have(const HandleSeq& key) const { return 0 < _found.count(key); }
+	void record(HandleSeq&& key, const GroundingMap& term_soln,
+	            ValueSeq&& values);
+
+	/// Start a standing query, or return the one already running
+	/// for this query.
+	static StandingQueryPtr start(const Handle& query);
+
+	/// Stop the standing query, if there is one.
+	static void cancel(const Handle& query);
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_STANDING_QUERY_H
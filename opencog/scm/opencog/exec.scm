@@ -7,7 +7,75 @@
 (use-modules (opencog as-config))
 (load-extension (string-append opencog-ext-path-exec "libexec") "opencog_exec_init")
 
-(export cog-evaluate! cog-execute!)
+(export cog-evaluate! cog-execute! cog-explain cog-attach-query-profile
+	cog-standing-query cog-cancel-standing-query)
+
+(set-procedure-property! cog-explain 'documentation
+"
+ cog-explain QUERY - describe how QUERY would be searched for.
+    QUERY must be a query: a GetLink, QueryLink, MeetLink and so on.
+    Returns a StringValue describing the cost-based plan: the Atom at
+    which it would start, the order in which it would ground the
+    clauses, and the estimated number of groundings at each step,
+    together with the estimated total cost. The estimates are taken
+    from statistics sampled from the current AtomSpace. Nothing is
+    grounded, and the AtomSpace is not changed.
+
+    The pattern engine follows this plan: it starts in the first clause,
+    and grounds the others in the order shown. Evaluatable and optional
+    clauses are not in the plan; they are grounded after the others.
+
+    Example:
+       (cog-explain (Get (And
+          (Inheritance (Variable \"x\") (Concept \"animal\"))
+          (Evaluation (Predicate \"eats\")
+             (List (Variable \"x\") (Concept \"grass\"))))))
+")
+
+(set-procedure-property! cog-attach-query-profile 'documentation
+"
+ cog-attach-query-profile QUERY - attach the profile of QUERY to it.
+    Attaches the counts of the work done by the most recent run of
+    QUERY to it, as a FloatValue at (Predicate \"*-QueryProfileKey-*\"),
+    and returns that FloatValue; or #f, if QUERY was never run. See
+    cog-query-profile for what the counts are.
+")
+
+(set-procedure-property! cog-standing-query 'documentation
+"
+ cog-standing-query QUERY - keep the results of QUERY current.
+    QUERY must be a MeetLink or a QueryLink. It is run once, and
+    then again, incrementally, whenever Atoms that could change its
+    results are added to or removed from the AtomSpace. Only the
+    changes are searched; the query is not re-run from scratch.
+
+    Returns a LinkValue holding two QueueValues. Results are pushed
+    onto the first, as they are found; results that are no longer
+    supported, because some Atom they were grounded by was removed,
+    are pushed onto the second. Calling this again, with the same
+    QUERY, returns the same queues.
+
+    Queries with evaluatable, Absent or Always clauses, or with more
+    than one component, cannot be kept current; these throw an error.
+
+    Example:
+       (define q (Meet (Inheritance (Variable \"x\") (Concept \"animal\"))))
+       (define qs (cog-standing-query q))
+       (Inheritance (Concept \"cat\") (Concept \"animal\"))
+       (cog-cancel-standing-query q)
+       (cog-value-ref qs 0)
+
+    Like all QueueValues, reading a queue waits until it is closed;
+    C++ code can pop the results from it as they arrive.
+
+    See also: cog-cancel-standing-query
+")
+
+(set-procedure-property! cog-cancel-standing-query 'documentation
+"
+ cog-cancel-standing-query QUERY - stop keeping QUERY current.
+    The queues returned by `cog-standing-query` are closed.
+")
 
 (use-modules (ice-9 optargs)) ; for define*-public
 
@@ -49,4 +117,41 @@
 		))
 )
 
+(define-public (cog-query-profile QUERY)
+"
+ cog-query-profile QUERY - report the work done by the last run of QUERY.
+
+    Each time that a query (a GetLink, QueryLink, MeetLink and so on)
+    is run, the pattern engine counts the work that it did. These
+    counts are kept with the query. This returns them, as an
+    association list, or the empty list, if QUERY was never run.
+    They are also attached to QUERY, as a FloatValue at the key
+    (Predicate \"*-QueryProfileKey-*\"), as they are when this is
+    called; later runs do not update that Value.
+
+    The counts are:
+       candidates      - starting points that were explored.
+       tree-compares   - pattern terms compared to AtomSpace contents.
+       clause-pushes   - clauses tried (the clause stack depth grows) ...
+       clause-pops     - ... and retreated from.
+       permutations    - permutations of unordered links that were tried.
+       glob-backtracks - glob groundings that had to be taken back.
+       evaluations     - evaluatable clauses that were evaluated ...
+       eval-seconds    - ... and the time spent doing that.
+       groundings      - groundings that were found.
+
+    Example:
+       (define q (Get (Inheritance (Variable \"x\") (Concept \"animal\"))))
+       (cog-execute! q)
+       (cog-query-profile q)
+"
+	(define prof (cog-attach-query-profile QUERY))
+	(if (not prof) '()
+		(map cons
+			'(candidates tree-compares clause-pushes clause-pops
+			  permutations glob-backtracks evaluations eval-seconds
+			  groundings)
+			(cog-value->list prof)))
+)
+
 ; ------------------ THE END -------------------
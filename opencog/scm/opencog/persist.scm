@@ -23,6 +23,9 @@
 	fetch-value
 	fetch-incoming-set
 	fetch-incoming-by-type
+	fetch-atoms
+	fetch-values
+	fetch-incoming-sets
 	fetch-query
 	store-atom
 	store-value
@@ -31,8 +34,11 @@
 	cog-delete-recursive!
 	barrier
 	monitor-storage
+	set-fetch-cache!
+	set-lazy-values!
 	load-atomspace
 	store-atomspace
+	store-changes
 	load-frames
 	store-frames)
 
@@ -183,6 +189,66 @@
 		(dflt-fetch-incoming-by-type ATOM TYPE))
 )
 
+(define*-public (fetch-atoms ATOM-LIST #:optional (STORAGE #f))
+"
+ fetch-atoms ATOM-LIST [STORAGE]
+
+    Fetch all of the Values on all of the Atoms in ATOM-LIST from
+    storage. This is the same as calling `fetch-atom` on each of them,
+    except that storage backends that support it will fetch them all
+    in one go, instead of one at a time. This can be much faster for
+    network and database backends. Returns a list of the Atoms.
+
+    If the optional STORAGE argument is provided, then it will be
+    used as the source of the fetch. It must be a StorageNode.
+
+    See also:
+       `fetch-atom` to fetch just one Atom.
+       `fetch-values` to get only one Value on each Atom.
+"
+	(if STORAGE (sn-fetch-atoms ATOM-LIST STORAGE)
+		(dflt-fetch-atoms ATOM-LIST))
+)
+
+(define*-public (fetch-values ATOM-LIST KEY #:optional (STORAGE #f))
+"
+ fetch-values ATOM-LIST KEY [STORAGE]
+
+    Fetch from storage the Value located at KEY on each of the Atoms
+    in ATOM-LIST. This is the same as calling `fetch-value` on each of
+    them, but is done in one go, when the storage backend supports it.
+    Returns a list of the Atoms.
+
+    If the optional STORAGE argument is provided, then it will be
+    used as the source of the fetch. It must be a StorageNode.
+
+    See also:
+       `fetch-value` to get the Value on just one Atom.
+       `fetch-atoms` to get all Values.
+"
+	(if STORAGE (sn-fetch-values ATOM-LIST KEY STORAGE)
+		(dflt-fetch-values ATOM-LIST KEY))
+)
+
+(define*-public (fetch-incoming-sets ATOM-LIST #:optional (STORAGE #f))
+"
+ fetch-incoming-sets ATOM-LIST [STORAGE]
+
+    Fetch the incoming sets of all of the Atoms in ATOM-LIST from
+    storage. This is the same as calling `fetch-incoming-set` on each
+    of them, but is done in one go, when the storage backend supports
+    it. The fetch is NOT recursive. Returns a list of the Atoms.
+
+    If the optional STORAGE argument is provided, then it will be
+    used as the source of the fetch. It must be a StorageNode.
+
+    See also:
+      `fetch-incoming-set` to fetch the incoming set of one Atom.
+"
+	(if STORAGE (sn-fetch-incoming-sets ATOM-LIST STORAGE)
+		(dflt-fetch-incoming-sets ATOM-LIST))
+)
+
 (define*-public (store-atom ATOM #:optional (STORAGE #f))
 "
  store-atom ATOM [STORAGE]
@@ -274,6 +340,64 @@
 	(if STORAGE (sn-monitor STORAGE) (dflt-monitor))
 )
 
+(define*-public (set-fetch-cache! TTL NEG-TTL #:optional (STORAGE #f))
+"
+ set-fetch-cache! TTL NEG-TTL [STORAGE]
+
+    Enable a read-through cache for `fetch-atom`, `fetch-value` and
+    `fetch-incoming-set`. A fetch that is repeated within TTL seconds
+    is answered from the AtomSpace, without contacting storage. Fetches
+    that found nothing are remembered for NEG-TTL seconds. Storing or
+    deleting an Atom invalidates the cached fetches for that Atom.
+    Changes made to storage by other users are not seen until the
+    timeout expires. A TTL of zero disables the cache; this is the
+    default. Cache hit and miss counts are reported by `monitor-storage`.
+
+    If the optional STORAGE argument is provided, then the cache is
+    configured for it. It must be a StorageNode.
+
+    Example:
+       (set-fetch-cache! 10.0 1.0)
+
+    See also:
+       `monitor-storage` to print cache statistics.
+"
+	(if STORAGE
+		(sn-set-fetch-cache TTL NEG-TTL STORAGE)
+		(dflt-set-fetch-cache TTL NEG-TTL))
+)
+
+(define*-public (set-lazy-values! LAZY BUDGET #:optional (STORAGE #f))
+"
+ set-lazy-values! LAZY BUDGET [STORAGE]
+
+    If LAZY is #t, then loading Atoms from storage loads only the keys
+    of their Values. Each Value is fetched the first time it is asked
+    for, with `cog-value`. This saves RAM when Atoms carry large Values
+    that are rarely looked at. Explicit `fetch-value` and `fetch-values`
+    are not affected.
+
+    If BUDGET is not zero, then fetched Values are dropped from RAM,
+    oldest first, when their total size goes over BUDGET bytes. They
+    are fetched again, if needed. Values that were changed after being
+    fetched are never dropped. Statistics are reported by
+    `monitor-storage`. The storage must stay open while Values remain
+    to be fetched. Not all kinds of StorageNodes support this.
+
+    If the optional STORAGE argument is provided, then lazy loading is
+    configured for it. It must be a StorageNode.
+
+    Example:
+       (set-lazy-values! #t 500000000)
+
+    See also:
+       `monitor-storage` to print statistics.
+"
+	(if STORAGE
+		(sn-set-lazy-values LAZY BUDGET STORAGE)
+		(dflt-set-lazy-values LAZY BUDGET))
+)
+
 (define*-public (load-atomspace #:optional (STORAGE #f))
 "
  load-atomspace [STORAGE] - load all atoms from storage.
@@ -329,6 +453,32 @@
 	(if STORAGE (sn-store-atomspace STORAGE) (dflt-store-atomspace))
 )
 
+(define*-public (store-changes #:optional (STORAGE #f))
+"
+ store-changes [STORAGE] - Store the Atoms that changed since last time.
+
+    Store only those Atoms that were added to the current AtomSpace, or
+    had a Value changed, since the last call to `store-changes` or to
+    `store-atomspace`. For large AtomSpaces, where only a few Atoms
+    change between saves, this is much faster than `store-atomspace`.
+    Returns the number of Atoms that were stored.
+
+    The first call turns on change tracking for the AtomSpace, and
+    stores everything, providing a checkpoint to start from.
+
+    Atoms that were extracted from the AtomSpace are NOT deleted from
+    storage; use `cog-delete!` for that.
+
+    If the optional STORAGE argument is provided, then it will be
+    used as the target of the store. It must be a StorageNode.
+
+    See also:
+    store-atomspace -- store all Atoms in the AtomSpace.
+    store-atom ATOM -- store one ATOM and all of the values on it.
+"
+	(if STORAGE (sn-store-changes STORAGE) (dflt-store-changes))
+)
+
 (define*-public (load-frames #:optional (STORAGE #f))
 "
  load-frames [STORAGE] - load the DAG of AtomSpaces from storage.